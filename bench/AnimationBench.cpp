@@ -0,0 +1,129 @@
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Animation.hpp>
+#include <Bench.hpp>
+#include <GLSLProgram.hpp>
+#include <StubGL.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    // Animated parameters of the frame, every slot of the block
+    std::size_t const PARAMS = AnimationBlock::SIZE * 4;
+
+    float const PERIOD = 6400.f;
+
+    float wave(float t)
+    {
+        return std::cos(static_cast<float>(-2 * M_PI + 4 * M_PI * t / PERIOD));
+    }
+}
+
+// -----------------------------------------------------------------------------
+//  Sampling a curve : table read against evaluating the function
+// -----------------------------------------------------------------------------
+RPI_BENCH(Animation_Curve)
+{
+    AnimationCurve const curve(wave, PERIOD);
+
+    float t = 0.f;
+    float value = 0.f;
+
+    state.measure("cos", [&]()
+    {
+        t += 16.7f;
+        value += wave(std::fmod(t, PERIOD));
+        Bench::DoNotOptimize(value);
+    });
+
+    state.measure("table", [&]()
+    {
+        t += 16.7f;
+        value += curve.sample(t);
+        Bench::DoNotOptimize(value);
+    });
+
+    // Worst error of the 256-entry table between its entries
+    float maxError = 0.f;
+
+    for(float s = 0.f; s < PERIOD; s += 1.f)
+    {
+        maxError = std::max(maxError, std::fabs(curve.sample(s) - wave(s)));
+    }
+
+    state.metric("max error", maxError, "");
+}
+
+// -----------------------------------------------------------------------------
+//  Sending 16 animated parameters to the two programs of the app on every
+//  tick : one uniform each against the block
+// -----------------------------------------------------------------------------
+RPI_BENCH(Animation_Upload)
+{
+    GLSLProgram program;
+    GLSLProgram litProgram;
+
+    std::vector<std::string> names;
+
+    for(std::size_t p = 0; p < PARAMS; ++p)
+    {
+        names.push_back("param" + std::to_string(p));
+    }
+
+    Animator animator(100.f);
+
+    for(std::size_t p = 0; p < PARAMS; ++p)
+    {
+        animator.add(AnimationCurve(wave, PERIOD), p, 1.f + static_cast<float>(p));
+    }
+
+    auto const perTick = [&](GLSLProgram const & prog, float t)
+    {
+        for(std::size_t p = 0; p < PARAMS; ++p)
+        {
+            prog.sendFloat(names[p].c_str(), wave(t) * (1.f + static_cast<float>(p)));
+        }
+    };
+
+    float t = 0.f;
+
+    Bench::StubGL::ResetCalls();
+    perTick(program, t);
+    perTick(litProgram, t);
+    auto const uniformCalls = Bench::StubGL::Calls();
+
+    state.measure("uniforms", [&]()
+    {
+        t += 100.f;
+        perTick(program, t);
+        perTick(litProgram, t);
+    });
+
+    Bench::StubGL::ResetCalls();
+    animator.advance(100.f);
+    animator.block().upload(program);
+    animator.block().upload(litProgram);
+    auto const blockCalls = Bench::StubGL::Calls();
+
+    state.measure("block", [&]()
+    {
+        animator.advance(100.f);
+        animator.block().upload(program);
+        animator.block().upload(litProgram);
+    });
+
+    // A frame between two ticks
+    state.measure("block, no tick", [&]()
+    {
+        animator.advance(1.f);
+        animator.block().upload(program);
+        animator.block().upload(litProgram);
+    });
+
+    state.metric("GL calls per tick, uniforms", static_cast<double>(uniformCalls), "");
+    state.metric("GL calls per tick, block", static_cast<double>(blockCalls), "");
+}
@@ -0,0 +1,128 @@
+#ifndef RPI_BENCH_HPP
+#define RPI_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace RPi {
+
+namespace Bench {
+
+    // -------------------------------------------------------------------------
+    //  Prevent the compiler from optimizing away the computation of a value
+    // -------------------------------------------------------------------------
+    template <typename T>
+    inline void DoNotOptimize(T const & value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Metric
+    {
+        std::string name;
+        double value;
+        std::string unit;
+    };
+
+    // -------------------------------------------------------------------------
+    //  Measurements of one benchmark case
+    // -------------------------------------------------------------------------
+    class State
+    {
+        using Clock = std::chrono::steady_clock;
+
+        public:
+            State(std::string const & name);
+
+            // -----------------------------------------------------------------
+            //  Call <func> in batches until the minimum measuring time is
+            //  reached and record the mean time per call
+            //
+            //   - label : name of the metric
+            //   - func  : function to measure
+            //
+            //   returns the mean time per call in nanoseconds
+            // -----------------------------------------------------------------
+            template <typename F>
+            double measure(std::string const & label, F && func);
+
+            void metric(std::string const & name, double value,
+                std::string const & unit);
+
+            std::string const & name() const;
+            std::vector<Metric> const & metrics() const;
+
+            // Minimum measuring time of State::measure in milliseconds
+            static double s_minTime;
+
+        private:
+            std::string m_name;
+            std::vector<Metric> m_metrics;
+    };
+
+    template <typename F>
+    double State::measure(std::string const & label, F && func)
+    {
+        // Warm up
+        func();
+
+        std::size_t iterations = 1;
+        std::size_t total = 0;
+        double elapsed = 0.0;
+
+        while(elapsed < s_minTime * 1e6)
+        {
+            auto const t1 = Clock::now();
+
+            for(std::size_t i = 0; i < iterations; ++i)
+            {
+                func();
+            }
+
+            auto const t2 = Clock::now();
+
+            elapsed += static_cast<double>(std::chrono::duration_cast<
+                std::chrono::nanoseconds>(t2 - t1).count());
+            total += iterations;
+            iterations *= 2;
+        }
+
+        auto const ns = elapsed / static_cast<double>(total);
+        metric(label, ns, "ns");
+        return ns;
+    }
+
+    using Func = void(*)(State &);
+
+    struct Case
+    {
+        char const * name;
+        Func func;
+    };
+
+    std::vector<Case> & Registry();
+
+    struct Registrar
+    {
+        Registrar(char const * name, Func func);
+    };
+}
+
+}
+
+// -----------------------------------------------------------------------------
+//  Declare and register a benchmark case
+//
+//   RPI_BENCH(Name)
+//   {
+//       state.measure("label", [&]() { ... });
+//   }
+// -----------------------------------------------------------------------------
+#define RPI_BENCH(name) \
+    static void bench_##name(RPi::Bench::State & state); \
+    static RPi::Bench::Registrar s_registrar_##name(#name, bench_##name); \
+    static void bench_##name(RPi::Bench::State & state)
+
+#endif //RPI_BENCH_HPP
@@ -0,0 +1,128 @@
+#include <vector>
+
+#include <BufferManager.hpp>
+#include <Bench.hpp>
+#include <StubGL.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    std::size_t const MESHES = 100;
+
+    // Vertices of the triangle of main.cpp
+    float const TRIANGLE[] = {
+         0.0f,  0.5f, 0.0f,
+        -0.5f, -0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f
+    };
+
+    std::vector<char> const & mesh_data()
+    {
+        static std::vector<char> const data(16 * 1024, 1);
+        return data;
+    }
+
+    std::size_t mesh_size(std::size_t i)
+    {
+        return 256 + (i * 997) % (16 * 1024 - 256);
+    }
+}
+
+// -----------------------------------------------------------------------------
+//  Loading and unloading 100 meshes of 256 B to 16 KB
+// -----------------------------------------------------------------------------
+RPI_BENCH(Buffers_Static)
+{
+    std::vector<GLuint> buffers(MESHES);
+
+    state.measure("one buffer per mesh", [&]()
+    {
+        for(std::size_t i = 0; i < MESHES; ++i)
+        {
+            glGenBuffers(1, &buffers[i]);
+            glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+            glBufferData(GL_ARRAY_BUFFER, mesh_size(i), mesh_data().data(), GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        for(auto & buffer : buffers) glDeleteBuffers(1, &buffer);
+    });
+
+    BufferManager manager;
+    std::vector<BufferRange> ranges(MESHES);
+
+    state.measure("buffer manager", [&]()
+    {
+        for(std::size_t i = 0; i < MESHES; ++i)
+        {
+            ranges[i] = manager.allocate(GL_ARRAY_BUFFER, mesh_data().data(), mesh_size(i));
+        }
+
+        // Release every other mesh first to exercise the merging of blocks
+        for(std::size_t i = 0; i < MESHES; i += 2) manager.release(ranges[i]);
+        for(std::size_t i = 1; i < MESHES; i += 2) manager.release(ranges[i]);
+    });
+
+    for(std::size_t i = 0; i < MESHES; ++i)
+    {
+        ranges[i] = manager.allocate(GL_ARRAY_BUFFER, mesh_data().data(), mesh_size(i));
+    }
+
+    auto const loaded = manager.stats();
+
+    for(auto & range : ranges) manager.release(range);
+
+    state.metric("GL buffers", static_cast<double>(loaded.buffers), "");
+    state.metric("allocated", loaded.allocatedBytes / 1024.0, "KB");
+    state.metric("used", loaded.usedBytes / 1024.0, "KB");
+    state.metric("buffers left after release", static_cast<double>(manager.stats().buffers), "");
+}
+
+// -----------------------------------------------------------------------------
+//  Dynamic geometry uploaded every frame, as the Draw function of main.cpp
+// -----------------------------------------------------------------------------
+RPI_BENCH(Buffers_Stream)
+{
+    std::size_t const FRAMES = 1000;
+
+    auto const perFrame = [&]()
+    {
+        for(std::size_t f = 0; f < FRAMES; ++f)
+        {
+            GLuint vbo;
+
+            glGenBuffers(1, &vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(TRIANGLE), TRIANGLE, GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &vbo);
+        }
+    };
+
+    BufferManager manager(256 * 1024, 4 * 1024);
+
+    auto const streamed = [&]()
+    {
+        for(std::size_t f = 0; f < FRAMES; ++f)
+        {
+            Bench::DoNotOptimize(manager.stream(GL_ARRAY_BUFFER, TRIANGLE, sizeof(TRIANGLE)));
+        }
+    };
+
+    state.measure("new buffer per frame x1000", perFrame);
+    state.measure("stream ring x1000", streamed);
+
+    Bench::StubGL::ResetCalls();
+    perFrame();
+    state.metric("new buffer GL calls per frame",
+        Bench::StubGL::Calls() / static_cast<double>(FRAMES), "");
+
+    Bench::StubGL::ResetCalls();
+    auto const orphans = manager.stats().orphans;
+    streamed();
+    state.metric("stream GL calls per frame",
+        Bench::StubGL::Calls() / static_cast<double>(FRAMES), "");
+    state.metric("orphans per 1000 frames",
+        static_cast<double>(manager.stats().orphans - orphans), "");
+}
@@ -0,0 +1,50 @@
+#include <Bench.hpp>
+#include <PerspectiveCamera.hpp>
+
+using namespace RPi;
+
+RPI_BENCH(Camera)
+{
+    PerspectiveCamera camera(70.f, 16.f / 9.f, 1.f, 100.f);
+
+    camera.position(glm::vec3(21, 11, 20));
+    camera.target(glm::vec3(13, 1, 11));
+
+    float x = 1.f;
+
+    state.measure("orient", [&]()
+    {
+        camera.orient(x, -x);
+        x = -x;
+        Bench::DoNotOptimize(camera.target());
+    });
+
+    // What a frame does when the mouse moved
+    state.measure("orient + lookAt", [&]()
+    {
+        camera.orient(x, -x);
+        x = -x;
+        Bench::DoNotOptimize(camera.lookAt());
+    });
+
+    // Nothing moved : cached matrix
+    state.measure("lookAt cached", [&]()
+    {
+        Bench::DoNotOptimize(camera.lookAt());
+    });
+
+    float const fovys[2] = { 70.f, 71.f };
+    std::size_t fovy = 0;
+
+    state.measure("projection", [&]()
+    {
+        camera.fovy(fovys[fovy]);
+        fovy ^= 1;
+        Bench::DoNotOptimize(camera.projection());
+    });
+
+    state.measure("projection cached", [&]()
+    {
+        Bench::DoNotOptimize(camera.projection());
+    });
+}
@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <vector>
+
+#include <Bench.hpp>
+#include <Qoi.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    int const WIDTH = 640;
+    int const HEIGHT = 480;
+
+    // Sky gradient over a noisy ground, closer to a frame of the app than
+    // random pixels
+    std::vector<std::uint8_t> const & frame_pixels()
+    {
+        static std::vector<std::uint8_t> pixels;
+
+        if(pixels.empty())
+        {
+            pixels.resize(WIDTH * HEIGHT * 4);
+
+            std::uint32_t seed = 1;
+
+            for(int y = 0; y < HEIGHT; ++y)
+            {
+                for(int x = 0; x < WIDTH; ++x)
+                {
+                    auto p = &pixels[(y * WIDTH + x) * 4];
+
+                    seed = seed * 1664525u + 1013904223u;
+
+                    if(y > HEIGHT / 3)
+                    {
+                        p[0] = static_cast<std::uint8_t>(60 + y / 8);
+                        p[1] = static_cast<std::uint8_t>(120 + y / 8);
+                        p[2] = 230;
+                    }
+                    else
+                    {
+                        p[0] = static_cast<std::uint8_t>(40 + (seed >> 28));
+                        p[1] = static_cast<std::uint8_t>(90 + (seed >> 27));
+                        p[2] = static_cast<std::uint8_t>(30 + (seed >> 28));
+                    }
+
+                    p[3] = 255;
+                }
+            }
+        }
+
+        return pixels;
+    }
+}
+
+// -----------------------------------------------------------------------------
+//  Encoding a 640x480 frame, which the writer thread pays for every capture
+// -----------------------------------------------------------------------------
+RPI_BENCH(Capture_Encode)
+{
+    auto const & pixels = frame_pixels();
+    std::vector<std::uint8_t> encoded;
+
+    state.measure("QOI 640x480", [&]()
+    {
+        Qoi::Encode(pixels.data(), WIDTH, HEIGHT, encoded);
+        Bench::DoNotOptimize(encoded.data());
+    });
+
+    state.metric("compressed size", 100.0 * static_cast<double>(encoded.size()) /
+        static_cast<double>(pixels.size()), "%");
+}
@@ -0,0 +1,49 @@
+#include <glm/glm.hpp>
+
+#include <Bench.hpp>
+#include <ChangeTracker.hpp>
+
+using namespace RPi;
+
+// -----------------------------------------------------------------------------
+//  Change detection of a frame of the app : what every frame pays to know
+//  whether it can be skipped
+// -----------------------------------------------------------------------------
+RPI_BENCH(Change_Frame)
+{
+    ChangeTracker changes;
+
+    glm::mat4 modelview(1.f);
+    glm::mat4 const projection(2.f);
+    float const time = 0.5f;
+    float const random = 1.5f;
+
+    state.measure("static camera", [&]()
+    {
+        changes.begin();
+        changes.track(modelview);
+        changes.track(projection);
+        changes.track(time);
+        changes.track(random);
+
+        if(changes.changed()) changes.presented();
+        else changes.skipped();
+    });
+
+    state.measure("moving camera", [&]()
+    {
+        modelview[3][0] += 1.f;
+
+        changes.begin();
+        changes.track(modelview);
+        changes.track(projection);
+        changes.track(time);
+        changes.track(random);
+
+        if(changes.changed()) changes.presented();
+        else changes.skipped();
+    });
+
+    state.metric("skipped", static_cast<double>(changes.skippedFrames()), "frames");
+    state.metric("presented", static_cast<double>(changes.presentedFrames()), "frames");
+}
@@ -0,0 +1,80 @@
+#include <vector>
+
+#include <Bench.hpp>
+#include <EGLConfigSelector.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    // Configs in the style of the VideoCore driver : every combination of
+    // color, depth, stencil and samples, the 888 ones listed first
+    std::vector<EGLConfigInfo> const & driver_configs()
+    {
+        static std::vector<EGLConfigInfo> configs;
+
+        if(configs.empty())
+        {
+            EGLint const colors[][4] = { { 8, 8, 8, 8 }, { 8, 8, 8, 0 }, { 5, 6, 5, 0 } };
+            EGLint const depths[] = { 24, 16, 0 };
+            EGLint const stencils[] = { 8, 0 };
+            EGLint const samples[] = { 0, 4 };
+
+            EGLint id = 1;
+
+            for(auto const & color : colors)
+            for(auto depth : depths)
+            for(auto stencil : stencils)
+            for(auto sample : samples)
+            {
+                EGLConfigInfo info = EGLConfigInfo();
+
+                info.id = id++;
+                info.red = color[0];
+                info.green = color[1];
+                info.blue = color[2];
+                info.alpha = color[3];
+                info.bufferSize = color[0] + color[1] + color[2] + color[3];
+                info.depth = depth;
+                info.stencil = stencil;
+                info.sampleBuffers = sample > 0 ? 1 : 0;
+                info.samples = sample;
+                info.caveat = EGL_NONE;
+                info.surfaceType = EGL_WINDOW_BIT | EGL_PBUFFER_BIT;
+                info.renderableType = EGL_OPENGL_ES2_BIT;
+
+                configs.push_back(info);
+            }
+        }
+
+        return configs;
+    }
+}
+
+// -----------------------------------------------------------------------------
+//  Scoring every config, the startup cost a cached config id skips along
+//  with the query of every attribute
+// -----------------------------------------------------------------------------
+RPI_BENCH(EGLConfig_Select)
+{
+    auto const & configs = driver_configs();
+
+    EGLConfigInfo fast = EGLConfigInfo();
+    EGLConfigInfo quality = EGLConfigInfo();
+
+    state.measure("fill rate profile", [&]()
+    {
+        EGLConfigSelector::Select(configs, EGLConfigRequest::FillRate(), fast);
+        Bench::DoNotOptimize(fast.id);
+    });
+
+    state.measure("quality profile", [&]()
+    {
+        EGLConfigSelector::Select(configs, EGLConfigRequest::Quality(), quality);
+        Bench::DoNotOptimize(quality.id);
+    });
+
+    state.metric("configs", configs.size(), "");
+    state.metric("fill rate bits per pixel", fast.bufferSize + fast.depth + fast.stencil, "");
+    state.metric("quality bits per pixel", quality.bufferSize + quality.depth + quality.stencil, "");
+}
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <Bench.hpp>
+#include <Heightfield.hpp>
+#include <Utils.hpp>
+
+using namespace RPi;
+
+RPI_BENCH(Heightfield_Normals)
+{
+    // Terrain(50, 50) is a 251 x 251 grid
+    for(std::size_t size : { 64, 128, 251, 512, 1024, 2048 })
+    {
+        Heightfield heightfield(size, size, 0.2f);
+
+        for(std::size_t z = 0; z < size; ++z)
+        {
+            for(std::size_t x = 0; x < size; ++x)
+            {
+                heightfield.at(x, z) = std::sin(static_cast<float>(x) * 0.13f) *
+                    std::cos(static_cast<float>(z) * 0.07f);
+            }
+        }
+
+        std::vector<float> normals(3 * size);
+        auto nx = &normals[0];
+        auto ny = nx + size;
+        auto nz = ny + size;
+
+        auto const label = Utils::String(size) + "x" + Utils::String(size);
+
+        auto const ns = state.measure(label, [&]()
+        {
+            for(std::size_t z = 0; z < size; ++z)
+            {
+                heightfield.normalRow(z, nx, ny, nz);
+                Bench::DoNotOptimize(normals[z % size]);
+            }
+        });
+
+        state.metric(label + " per vertex", ns / static_cast<double>(size * size), "ns");
+    }
+}
+
+RPI_BENCH(Heightfield_Queries)
+{
+    for(std::size_t size : { 251, 1024, 4096 })
+    {
+        Heightfield heightfield(size, size, 0.2f);
+
+        for(std::size_t z = 0; z < size; ++z)
+        {
+            for(std::size_t x = 0; x < size; ++x)
+            {
+                heightfield.at(x, z) = std::sin(static_cast<float>(x) * 0.13f) *
+                    std::cos(static_cast<float>(z) * 0.07f);
+            }
+        }
+
+        heightfield.updatePyramid();
+
+        auto const extent = heightfield.spacing() * static_cast<float>(size - 1);
+        auto const label = Utils::String(size) + "x" + Utils::String(size);
+
+        float x = 0.f;
+
+        state.measure(label + " heightAt", [&]()
+        {
+            x = x > extent ? 0.f : x + 0.37f;
+            Bench::DoNotOptimize(heightfield.heightAt(x, extent - x));
+        });
+
+        state.measure(label + " normalAt", [&]()
+        {
+            x = x > extent ? 0.f : x + 0.37f;
+            Bench::DoNotOptimize(heightfield.normalAt(x, extent - x));
+        });
+
+        // Grazing rays crossing the whole terrain
+        float t = 0.f;
+
+        state.measure(label + " raycast across", [&]()
+        {
+            x = x > extent ? 0.f : x + 0.37f;
+            auto const hit = heightfield.raycast(glm::vec3(x, 1.5f, 0.f),
+                glm::vec3(0.f, -1.5f, extent), 1.f, t);
+            Bench::DoNotOptimize(hit);
+        });
+
+        // Short moves of the camera, as in Camera::move
+        glm::vec3 hit;
+
+        state.measure(label + " camera move", [&]()
+        {
+            x = x > extent - 1.f ? 0.f : x + 0.37f;
+            auto const from = glm::vec3(x, heightfield.heightAt(x, x) + 0.1f, x);
+            Bench::DoNotOptimize(heightfield.intersect(from,
+                from + glm::vec3(0.35f, -0.2f, 0.35f), hit));
+        });
+    }
+}
@@ -0,0 +1,110 @@
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <Bench.hpp>
+#include <Input.hpp>
+#include <SpscQueue.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    std::size_t const EVENTS = 100000;
+}
+
+// -----------------------------------------------------------------------------
+//  100000 events handed from a producer thread to a consumer thread
+// -----------------------------------------------------------------------------
+RPI_BENCH(Input_Queue)
+{
+    static SpscQueue<InputEvent, 1024> queue;
+
+    state.measure("spsc queue", [&]()
+    {
+        std::thread producer([]()
+        {
+            InputEvent event = {};
+
+            for(std::size_t i = 0; i < EVENTS; ++i)
+            {
+                event.time = i;
+                while(!queue.push(event)) std::this_thread::yield();
+            }
+        });
+
+        InputEvent event;
+        std::uint64_t sum = 0;
+
+        for(std::size_t i = 0; i < EVENTS; ++i)
+        {
+            while(!queue.pop(event)) std::this_thread::yield();
+            sum += event.time;
+        }
+
+        producer.join();
+        Bench::DoNotOptimize(sum);
+    });
+
+    std::mutex mutex;
+    std::deque<InputEvent> locked;
+
+    state.measure("mutex + deque", [&]()
+    {
+        std::thread producer([&]()
+        {
+            InputEvent event = {};
+
+            for(std::size_t i = 0; i < EVENTS; ++i)
+            {
+                event.time = i;
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.push_back(event);
+            }
+        });
+
+        std::uint64_t sum = 0;
+
+        for(std::size_t i = 0; i < EVENTS;)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            while(!locked.empty())
+            {
+                sum += locked.front().time;
+                locked.pop_front();
+                ++i;
+            }
+        }
+
+        producer.join();
+        Bench::DoNotOptimize(sum);
+    });
+}
+
+// -----------------------------------------------------------------------------
+//  A frame reading a burst of 500 mouse motions queued by the event filter
+// -----------------------------------------------------------------------------
+RPI_BENCH(Input_Burst)
+{
+    Input input;
+
+    auto const filter = SDL_GetEventFilter();
+
+    SDL_Event motion = {};
+    motion.type = SDL_MOUSEMOTION;
+    motion.motion.xrel = 1;
+
+    state.measure("filter x500 + update", [&]()
+    {
+        for(int i = 0; i < 500; ++i) filter(&motion);
+
+        input.updateEvents();
+        Bench::DoNotOptimize(input.getXRel());
+    });
+
+    state.metric("events per update", static_cast<double>(input.events()), "");
+    state.metric("summed motion", static_cast<double>(input.getXRel()), "");
+    state.metric("dropped", static_cast<double>(Input::DroppedEvents()), "");
+}
@@ -0,0 +1,158 @@
+#include <cmath>
+#include <vector>
+
+#include <glm/gtx/transform.hpp>
+
+#include <Animation.hpp>
+#include <Bench.hpp>
+#include <Cube.hpp>
+#include <GLSLProgram.hpp>
+#include <Memory.hpp>
+#include <RenderQueue.hpp>
+#include <Terrain.hpp>
+#include <TransformStore.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    // Size of a small per-frame object (a matrix)
+    struct Transient
+    {
+        Transient(): m(1.f)
+        {
+
+        }
+
+        glm::mat4 m;
+    };
+
+    std::size_t const OBJECTS = 256;
+}
+
+RPI_BENCH(Memory_Allocators)
+{
+    std::vector<Transient *> objects(OBJECTS);
+
+    state.measure("new/delete x256", [&]()
+    {
+        for(auto & o : objects) o = new Transient();
+        Bench::DoNotOptimize(objects.back());
+        for(auto o : objects) delete o;
+    });
+
+    Memory::FrameArena arena(OBJECTS * sizeof(Transient));
+
+    state.measure("arena x256", [&]()
+    {
+        arena.reset();
+        for(auto & o : objects) o = arena.make<Transient>();
+        Bench::DoNotOptimize(objects.back());
+    });
+}
+
+// -----------------------------------------------------------------------------
+//  Heap allocations of a flythrough frame once the containers reached their
+//  steady-state size
+// -----------------------------------------------------------------------------
+RPI_BENCH(Memory_Frame)
+{
+    GLSLProgram program;
+    GLSLProgram litProgram;
+    Terrain terrain(50, 50);
+
+    TransformStore cubes;
+
+    for(int i = 0; i < 150; ++i)
+    {
+        auto const x = static_cast<float>(i);
+        cubes.add(glm::vec3(x, 0.f, x), glm::vec3(x));
+    }
+
+    auto const view = glm::lookAt(glm::vec3(21, 11, 20), glm::vec3(13, 1, 11),
+        glm::vec3(0, 1, 0));
+
+    glm::mat4 projection(1.f);
+    RenderQueue queue(100.f);
+    Memory::FrameArena arena(4096);
+
+    Animator animator(100.f);
+    animator.add(AnimationCurve([](float t) { return std::cos(t * 0.001f); }, 6400.f), 0);
+
+    float time = 0.f;
+
+    auto const frame = [&]()
+    {
+        arena.reset();
+
+        animator.advance(16.7f);
+        animator.block().upload(program);
+        animator.block().upload(litProgram);
+
+        cubes.updateModelViews(view);
+
+        queue.clear();
+        Cube::Queue(queue, program, cubes);
+        terrain.queue(queue, litProgram, view);
+
+        auto const text = arena.format("%g FPS", 60.f + time);
+
+        DrawItem overlay;
+        overlay.pass = RenderPass::Overlay;
+        overlay.draw = [text]() { Bench::DoNotOptimize(text[0]); };
+        queue.add(overlay);
+
+        queue.submit(projection);
+
+        time += 0.1f;
+    };
+
+    // Warm up the containers
+    for(int i = 0; i < 3; ++i) frame();
+
+    state.measure("frame", frame);
+
+    auto const before = Memory::Allocations();
+
+    for(int i = 0; i < 100; ++i) frame();
+
+    auto const allocations = Memory::Allocations() - before;
+
+    state.metric("heap allocations per frame", static_cast<double>(allocations) / 100.0, "");
+    state.metric("arena peak", static_cast<double>(arena.peak()), "B");
+}
+
+// -----------------------------------------------------------------------------
+//  Heap usage of the subsystems of a scene, only measured in the builds with
+//  MEMORY_TRACKING=1 : compare "new/delete x256" between the two builds for
+//  the cost of the tracking
+// -----------------------------------------------------------------------------
+RPI_BENCH(Memory_Tags)
+{
+    auto const before = Memory::Stats(Memory::Tag::Terrain).liveBytes;
+
+    Terrain terrain(50, 50);
+    TransformStore cubes;
+
+    for(int i = 0; i < 150; ++i)
+    {
+        auto const x = static_cast<float>(i);
+        cubes.add(glm::vec3(x, 0.f, x), glm::vec3(x));
+    }
+
+    std::vector<Transient *> objects(OBJECTS);
+
+    state.measure("new/delete x256", [&]()
+    {
+        for(auto & o : objects) o = new Transient();
+        Bench::DoNotOptimize(objects.back());
+        for(auto o : objects) delete o;
+    });
+
+    state.metric("tracking", Memory::TrackingEnabled() ? 1.0 : 0.0, "");
+    state.metric("terrain live",
+        static_cast<double>(Memory::Stats(Memory::Tag::Terrain).liveBytes - before) / 1024.0,
+        "KB");
+    state.metric("scene live",
+        static_cast<double>(Memory::Stats(Memory::Tag::Scene).liveBytes) / 1024.0, "KB");
+}
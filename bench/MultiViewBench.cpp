@@ -0,0 +1,78 @@
+#include <cmath>
+#include <string>
+
+#include <glm/gtx/transform.hpp>
+
+#include <Bench.hpp>
+#include <Cube.hpp>
+#include <GLSLProgram.hpp>
+#include <MultiView.hpp>
+#include <Terrain.hpp>
+#include <TransformStore.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    std::size_t const VIEWS = 4;
+}
+
+// -----------------------------------------------------------------------------
+//  Four views of the terrain and the cube field, their jobs all on the render
+//  thread or each on a worker thread
+// -----------------------------------------------------------------------------
+RPI_BENCH(MultiView_Render)
+{
+    GLSLProgram program;
+    GLSLProgram litProgram;
+    Terrain terrain(50, 50);
+
+    TransformStore cubes;
+
+    for(int i = 0; i < 150; ++i)
+    {
+        auto const x = static_cast<float>(i);
+        cubes.add(glm::vec3(x, 0.f, x), glm::vec3(x));
+    }
+
+    cubes.updateModels();
+
+    for(auto threaded : { false, true })
+    {
+        MultiViewRenderer renderer(100.f);
+
+        for(std::size_t k = 0; k < VIEWS; ++k)
+        {
+            auto const angle = 2.f * static_cast<float>(M_PI) * static_cast<float>(k) / static_cast<float>(VIEWS);
+            auto const lookAt = glm::lookAt(
+                glm::vec3(25.f + 40.f * std::cos(angle), 25.f, 25.f + 40.f * std::sin(angle)),
+                glm::vec3(25.f, 0.f, 25.f), glm::vec3(0, 1, 0));
+
+            View view;
+
+            view.viewport = { static_cast<GLint>(k * 160), 0, 160, 480 };
+            view.thread = threaded ? k + 1 : 0;
+
+            view.job = [&, lookAt](RenderQueue & q)
+            {
+                terrain.queue(q, litProgram, lookAt);
+                Cube::Queue(q, program, cubes, lookAt);
+            };
+
+            renderer.add(view);
+        }
+
+        state.measure(threaded ? "4 views, a worker each" : "4 views, render thread",
+            [&]() { renderer.render(); });
+
+        if(threaded)
+        {
+            float jobs = 0.f;
+
+            for(std::size_t k = 0; k < VIEWS; ++k) jobs += renderer.stats(k).jobMs;
+
+            state.metric("draws per view", static_cast<double>(renderer.stats(0).draws), "");
+            state.metric("job time of the views", jobs * 1000.f, "us");
+        }
+    }
+}
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Bench.hpp>
+#include <Noise.hpp>
+#include <NoiseKernels.hpp>
+#include <PerlinNoise.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    // Cosine interpolated value noise formerly used by Terrain, kept as the
+    // reference of the comparisons
+    inline double legacy_findnoise2(double x, double y)
+    {
+        int n = (int)x + (int)y * 57;
+        n = (n << 13) ^ n;
+        int nn = (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
+        return 1.0 - ((double)nn / 1073741824.0);
+    }
+
+    inline double legacy_interpolate(double a, double b, double x)
+    {
+        double ft = x * 3.1415927;
+        double f = (1.0 - std::cos(ft)) * 0.5;
+        return a * (1.0 - f) + b * f;
+    }
+
+    inline double legacy_noise(double x, double y)
+    {
+        double floorx = (double)((int)x);
+        double floory = (double)((int)y);
+
+        double s = legacy_findnoise2(floorx, floory);
+        double t = legacy_findnoise2(floorx + 1, floory);
+        double u = legacy_findnoise2(floorx, floory + 1);
+        double v = legacy_findnoise2(floorx + 1, floory + 1);
+        double int1 = legacy_interpolate(s, t, x - floorx);
+        double int2 = legacy_interpolate(u, v, x - floorx);
+        return legacy_interpolate(int1, int2, y - floory);
+    }
+
+    // Samples of a 64 x 64 grid, as Terrain does
+    std::size_t const GRID = 64;
+    double const STEP = 0.2;
+
+    // Coordinate of the i-th sample of the grid
+    inline double coordinate(std::size_t i)
+    {
+        return static_cast<double>(i) * STEP;
+    }
+
+    // The tileable noises must be equal to the bit : no tolerance
+    inline bool differ(float a, float b)
+    {
+        return a < b || a > b;
+    }
+
+    // Returns the time per sample in ns
+    template <typename Func>
+    double per_sample(Bench::State & state, std::string const & label, Func func)
+    {
+        auto const ns = state.measure(label, [&]()
+        {
+            for(std::size_t z = 0; z < GRID; ++z)
+            {
+                for(std::size_t x = 0; x < GRID; ++x)
+                {
+                    Bench::DoNotOptimize(func(coordinate(x), coordinate(z)));
+                }
+            }
+        });
+
+        auto const sample = ns / static_cast<double>(GRID * GRID);
+        state.metric(label + " per sample", sample, "ns");
+
+        return sample;
+    }
+
+    // Largest difference with the generic path over the grid
+    template <typename Func>
+    double max_difference(PerlinNoise const & noise, Func func)
+    {
+        double difference = 0.0;
+
+        for(std::size_t z = 0; z < GRID; ++z)
+        {
+            for(std::size_t x = 0; x < GRID; ++x)
+            {
+                auto const expected = noise.GetHeightGeneric(coordinate(x), coordinate(z));
+                difference = std::max(difference,
+                    std::fabs(func(coordinate(x), coordinate(z)) - expected));
+            }
+        }
+
+        return difference;
+    }
+}
+
+RPI_BENCH(Noise_Basis)
+{
+    per_sample(state, "legacy value noise (Terrain)", [](double x, double y)
+    {
+        return legacy_noise(x, y);
+    });
+
+    // One octave of the smoothed value noise
+    PerlinNoise const value(0.5, 1.0, 1.0, 1, 42);
+    per_sample(state, "PerlinNoise::GetHeight 1 octave", [&](double x, double y)
+    {
+        return value.GetHeight(x, y);
+    });
+
+    Noise<float> const f(42);
+    Noise<double> const d(42);
+
+    per_sample(state, "perlin 2D float", [&](double x, double y)
+    {
+        return f.perlin(static_cast<float>(x), static_cast<float>(y));
+    });
+
+    per_sample(state, "perlin 2D double", [&](double x, double y)
+    {
+        return d.perlin(x, y);
+    });
+
+    per_sample(state, "simplex 2D float", [&](double x, double y)
+    {
+        return f.simplex(static_cast<float>(x), static_cast<float>(y));
+    });
+
+    per_sample(state, "simplex 2D double", [&](double x, double y)
+    {
+        return d.simplex(x, y);
+    });
+
+    per_sample(state, "perlin 3D float", [&](double x, double y)
+    {
+        return f.perlin(static_cast<float>(x), 0.5f, static_cast<float>(y));
+    });
+
+    per_sample(state, "perlin 3D double", [&](double x, double y)
+    {
+        return d.perlin(x, 0.5, y);
+    });
+
+    per_sample(state, "simplex 3D float", [&](double x, double y)
+    {
+        return f.simplex(static_cast<float>(x), 0.5f, static_cast<float>(y));
+    });
+
+    per_sample(state, "simplex 3D double", [&](double x, double y)
+    {
+        return d.simplex(x, 0.5, y);
+    });
+}
+
+RPI_BENCH(Noise_Fractal)
+{
+    int const octaves = 4;
+
+    PerlinNoise const value(0.5, 1.0, 1.0, octaves, 42);
+    per_sample(state, "PerlinNoise::GetHeight 4 octaves", [&](double x, double y)
+    {
+        return value.GetHeight(x, y);
+    });
+
+    Noise<float> const noise(42);
+    Fractal<float> const fractal(octaves);
+
+    for(auto basis : { NoiseBasis::Perlin, NoiseBasis::Simplex })
+    {
+        std::string const name = basis == NoiseBasis::Perlin ? "perlin" : "simplex";
+
+        per_sample(state, "fbm " + name + " 4 octaves", [&](double x, double y)
+        {
+            return noise.fbm(basis, fractal, static_cast<float>(x), static_cast<float>(y));
+        });
+
+        per_sample(state, "ridged " + name + " 4 octaves", [&](double x, double y)
+        {
+            return noise.ridged(basis, fractal, static_cast<float>(x), static_cast<float>(y));
+        });
+
+        per_sample(state, "turbulence " + name + " 4 octaves", [&](double x, double y)
+        {
+            return noise.turbulence(basis, fractal, static_cast<float>(x), static_cast<float>(y));
+        });
+    }
+}
+
+RPI_BENCH(Noise_Lattice)
+{
+    Noise<float> const noise(42);
+    Fractal<float> const fractal(4, 0.5f);
+    Lattice const origin;
+    Lattice const period(16, 16);
+
+    per_sample(state, "lattice perlin 2D", [&](double x, double y)
+    {
+        return noise.perlin(origin, static_cast<float>(x), static_cast<float>(y));
+    });
+
+    per_sample(state, "lattice fbm 4 octaves", [&](double x, double y)
+    {
+        return noise.fbm(fractal, origin, static_cast<float>(x), static_cast<float>(y));
+    });
+
+    per_sample(state, "lattice fbm 4 octaves periodic", [&](double x, double y)
+    {
+        return noise.fbm(fractal, origin, static_cast<float>(x), static_cast<float>(y), period);
+    });
+
+    per_sample(state, "lattice warp 4 octaves", [&](double x, double y)
+    {
+        return noise.warp(fractal, 1.f, origin, static_cast<float>(x), static_cast<float>(y));
+    });
+
+    // Far away from the origin (the 32-bit cells of the table would overflow)
+    Lattice const far(std::int64_t(1) << 40, -(std::int64_t(1) << 40));
+    per_sample(state, "lattice fbm 4 octaves at 2^40", [&](double x, double y)
+    {
+        return noise.fbm(fractal, far, static_cast<float>(x), static_cast<float>(y));
+    });
+
+    // Periodic noise : compare the samples with the ones a period away
+    std::size_t periodMismatches = 0;
+    for(std::size_t z = 0; z < GRID; ++z)
+    {
+        for(std::size_t x = 0; x < GRID; ++x)
+        {
+            auto const fx = static_cast<float>(x) * 0.25f;
+            auto const fz = static_cast<float>(z) * 0.25f;
+
+            auto const a = noise.fbm(fractal, origin, fx, fz, period);
+            auto const b = noise.fbm(fractal, Lattice(period.x, -period.y), fx, fz, period);
+
+            periodMismatches += differ(a, b);
+        }
+    }
+
+    state.metric("period mismatches", static_cast<double>(periodMismatches), "");
+}
+
+RPI_BENCH(Noise_Chunks)
+{
+    // 2 x 2 chunks of 64 x 64 cells sampled 4 times per cell, on one thread
+    // each, compared with the same map sampled in one piece
+    std::int64_t const cells = 64;
+    std::size_t const samples = 4 * cells + 1;
+    float const step = 0.25f;
+
+    Noise<float> const noise(7);
+    Fractal<float> const fractal(5, 0.25f, 1.f);
+    Lattice const base(std::int64_t(1) << 33, 12345);
+
+    auto generate = [&](Lattice const & origin, std::vector<float> & out)
+    {
+        out.resize(samples * samples);
+
+        for(std::size_t z = 0; z < samples; ++z)
+        {
+            for(std::size_t x = 0; x < samples; ++x)
+            {
+                out[z * samples + x] = noise.warp(fractal, 2.f, origin,
+                    static_cast<float>(x) * step, static_cast<float>(z) * step);
+            }
+        }
+    };
+
+    std::vector<float> chunks[4];
+
+    auto const ns = state.measure("4 chunks on 4 threads", [&]()
+    {
+        std::vector<std::thread> threads;
+
+        for(int c = 0; c < 4; ++c)
+        {
+            threads.emplace_back([&, c]()
+            {
+                Lattice const origin(base.x + (c & 1) * cells,
+                    base.y + (c >> 1) * cells);
+                generate(origin, chunks[c]);
+            });
+        }
+
+        for(auto & t : threads) t.join();
+    });
+
+    state.metric("per sample", ns / static_cast<double>(4 * samples * samples), "ns");
+
+    // Shared borders of the chunks
+    std::size_t mismatches = 0;
+    auto const last = samples - 1;
+
+    for(std::size_t i = 0; i < samples; ++i)
+    {
+        mismatches += differ(chunks[0][i * samples + last], chunks[1][i * samples]);
+        mismatches += differ(chunks[2][i * samples + last], chunks[3][i * samples]);
+        mismatches += differ(chunks[0][last * samples + i], chunks[2][i]);
+        mismatches += differ(chunks[1][last * samples + i], chunks[3][i]);
+    }
+
+    state.metric("border mismatches", static_cast<double>(mismatches), "");
+}
+
+// -----------------------------------------------------------------------------
+//  PerlinNoise octaves : the generic loop against the specializations picked
+//  by SelectValueNoise, per octave count, precision and kernel
+// -----------------------------------------------------------------------------
+RPI_BENCH(Noise_Kernels)
+{
+    struct Config
+    {
+        char const * name;
+        NoisePrecision precision;
+        NoiseInterpolation interpolation;
+    };
+
+    Config const configs[] =
+    {
+        { "double cubic",  NoisePrecision::Double, NoiseInterpolation::Cubic },
+        { "float cubic",   NoisePrecision::Float,  NoiseInterpolation::Cubic },
+        { "fixed cubic",   NoisePrecision::Fixed,  NoiseInterpolation::Cubic },
+        { "float linear",  NoisePrecision::Float,  NoiseInterpolation::Linear },
+        { "float quintic", NoisePrecision::Float,  NoiseInterpolation::Quintic }
+    };
+
+    for(auto octaves : { 1, 4, 8 })
+    {
+        PerlinNoise const noise(0.5, 1.0, 1.0, octaves, 42);
+        auto const seed = static_cast<std::uint64_t>(noise.RandomSeed());
+        auto const prefix = std::to_string(octaves) + " octaves ";
+
+        auto const generic = per_sample(state, prefix + "generic", [&](double x, double y)
+        {
+            return noise.GetHeightGeneric(x, y);
+        });
+
+        for(auto const & config : configs)
+        {
+            auto const kernel = SelectValueNoise(octaves, 0.5, config.precision,
+                config.interpolation);
+
+            auto const label = prefix + config.name;
+
+            auto const specialized = per_sample(state, label, [&](double x, double y)
+            {
+                return kernel(seed, 1.0, x, y);
+            });
+
+            state.metric(label + " speedup", generic / specialized, "x");
+
+            if(config.interpolation == NoiseInterpolation::Cubic)
+            {
+                state.metric(label + " max difference", max_difference(noise,
+                    [&](double x, double y) { return kernel(seed, 1.0, x, y); }), "");
+            }
+        }
+    }
+
+    // Without the dispatch : the call inlined in the loop
+    PerlinNoise const noise(0.5, 1.0, 1.0, 4, 42);
+    auto const seed = static_cast<std::uint64_t>(noise.RandomSeed());
+
+    per_sample(state, "4 octaves float cubic, direct", [&](double x, double y)
+    {
+        return ValueNoise<4, float, CubicKernel>::Total(seed,
+            static_cast<float>(y), static_cast<float>(x));
+    });
+}
@@ -0,0 +1,204 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <glm/gtx/transform.hpp>
+
+#include <Bench.hpp>
+#include <Cube.hpp>
+#include <GLSLProgram.hpp>
+#include <RenderQueue.hpp>
+#include <StubGL.hpp>
+#include <Terrain.hpp>
+#include <TransformStore.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    float frandom(float min, float max)
+    {
+        return min + (max - min) * static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    }
+}
+
+// -----------------------------------------------------------------------------
+//  Flythrough frame : two terrains and the cube field, submitted in an order
+//  mixing programs and buffers
+// -----------------------------------------------------------------------------
+RPI_BENCH(RenderQueue_Frame)
+{
+    GLSLProgram program;
+    GLSLProgram litProgram;
+
+    Terrain terrain(50, 50);
+    Terrain hills(10, 10);
+
+    std::srand(1);
+
+    TransformStore near;
+    TransformStore far;
+
+    for(int i = 0; i < 75; ++i)
+    {
+        near.add(glm::vec3(frandom(0.f, 50.f), 0.f, frandom(0.f, 50.f)), glm::vec3(1.f));
+        far.add(glm::vec3(frandom(0.f, 50.f), 0.f, frandom(0.f, 50.f)), glm::vec3(2.f));
+    }
+
+    auto const view = glm::lookAt(glm::vec3(21, 11, 20), glm::vec3(13, 1, 11),
+        glm::vec3(0, 1, 0));
+
+    near.updateModelViews(view);
+    far.updateModelViews(view);
+
+    glm::mat4 projection(1.f);
+    glm::mat4 terrainView = view;
+    glm::mat4 hillsView = view * glm::translate(glm::vec3(-10.f, 0.f, 0.f));
+
+    auto const immediate = [&]()
+    {
+        Cube::Render(program, projection, far);
+        terrain.render(litProgram, projection, terrainView);
+        Cube::Render(program, projection, near);
+        hills.render(litProgram, projection, hillsView);
+    };
+
+    RenderQueue queue(100.f);
+
+    auto const queued = [&]()
+    {
+        queue.clear();
+
+        Cube::Queue(queue, program, far);
+        terrain.queue(queue, litProgram, terrainView);
+        Cube::Queue(queue, program, near);
+        hills.queue(queue, litProgram, hillsView);
+
+        queue.submit(projection);
+    };
+
+    state.measure("immediate", immediate);
+    state.measure("queue", queued);
+
+    Bench::StubGL::ResetCalls();
+    immediate();
+    state.metric("immediate GL calls", static_cast<double>(Bench::StubGL::Calls()), "");
+
+    Bench::StubGL::ResetCalls();
+    queued();
+    state.metric("queue GL calls", static_cast<double>(Bench::StubGL::Calls()), "");
+
+    auto const & stats = queue.stats();
+
+    state.metric("draws", static_cast<double>(stats.draws), "");
+    state.metric("program changes", static_cast<double>(stats.programChanges), "");
+    state.metric("glUseProgram calls", static_cast<double>(stats.programBinds), "");
+    state.metric("unsorted program changes", static_cast<double>(stats.unsortedProgramChanges), "");
+    state.metric("buffer changes", static_cast<double>(stats.bufferChanges), "");
+    state.metric("unsorted buffer changes", static_cast<double>(stats.unsortedBufferChanges), "");
+    state.metric("matrix uploads", static_cast<double>(stats.matrixUploads), "");
+    state.metric("front to back", stats.frontToBack * 100.0, "%");
+    state.metric("unsorted front to back", stats.unsortedFrontToBack * 100.0, "%");
+}
+
+// Radix sort of many draws with random depths
+RPI_BENCH(RenderQueue_Sort)
+{
+    GLSLProgram programs[4];
+
+    std::srand(1);
+
+    for(std::size_t count : { 1000, 10000 })
+    {
+        RenderQueue queue(100.f);
+
+        std::vector<DrawItem> items(count);
+
+        for(auto & item : items)
+        {
+            item.program = &programs[std::rand() % 4];
+            item.vertexBuffer = static_cast<GLuint>(1 + std::rand() % 16);
+            item.modelView = glm::translate(glm::vec3(0.f, 0.f, -frandom(1.f, 100.f)));
+        }
+
+        auto const label = std::to_string(count);
+
+        auto const ns = state.measure(label + " add + sort", [&]()
+        {
+            queue.clear();
+
+            for(auto const & item : items) queue.add(item);
+
+            queue.sort();
+            Bench::DoNotOptimize(queue.sorted(0));
+        });
+
+        state.metric(label + " per draw", ns / static_cast<double>(count), "ns");
+    }
+}
+
+// -----------------------------------------------------------------------------
+//  Two terrains of one program in one BufferManager page : they share their
+//  vertex buffer, and each chunk must still be drawn with the uniforms of its
+//  own terrain
+// -----------------------------------------------------------------------------
+RPI_BENCH(RenderQueue_SharedPage)
+{
+    GLSLProgram litProgram;
+
+    Terrain terrain(12, 12);
+    Terrain hills(10, 10);
+
+    auto const view = glm::lookAt(glm::vec3(6, 8, 20), glm::vec3(6, 0, 0),
+        glm::vec3(0, 1, 0));
+
+    glm::mat4 projection(1.f);
+    glm::mat4 hillsView = view * glm::translate(glm::vec3(-4.f, 0.f, -2.f));
+
+    RenderQueue queue(100.f);
+
+    // The chunks of both terrains interleaved by their depth
+    auto const queued = [&]()
+    {
+        queue.clear();
+
+        terrain.queue(queue, litProgram, view);
+        hills.queue(queue, litProgram, hillsView);
+
+        queue.submit(projection);
+    };
+
+    state.measure("queue", queued);
+
+    // Draws whose terrainWidth is not the one of their terrain
+    auto const location = litProgram.getUniformLocation("terrainWidth");
+
+    std::size_t drawn = 0;
+    std::size_t wrong = 0;
+    std::size_t shared = 0;
+
+    Bench::StubGL::SetDrawHook([&]()
+    {
+        auto const & item = queue.sorted(drawn++);
+        auto const width = item.object == &terrain ? 12.f : 10.f;
+
+        if(Bench::StubGL::Uniform1f(location) < width || Bench::StubGL::Uniform1f(location) > width)
+        {
+            ++wrong;
+        }
+
+        if(item.vertexBuffer == queue.sorted(0).vertexBuffer) ++shared;
+    });
+
+    queued();
+
+    Bench::StubGL::SetDrawHook(std::function<void()>());
+
+    auto const & stats = queue.stats();
+
+    state.metric("draws", static_cast<double>(stats.draws), "");
+    state.metric("draws in the first buffer", static_cast<double>(shared), "");
+    state.metric("buffer changes", static_cast<double>(stats.bufferChanges), "");
+    state.metric("setups", static_cast<double>(stats.setups), "");
+    state.metric("wrong uniforms", static_cast<double>(wrong), "");
+}
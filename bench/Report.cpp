@@ -0,0 +1,367 @@
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+
+#include <Report.hpp>
+
+namespace RPi {
+
+namespace Bench {
+
+namespace {
+
+    std::string escape(std::string const & s)
+    {
+        std::string out;
+        out.reserve(s.size());
+
+        for(auto c : s)
+        {
+            if(c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                out += buffer;
+            }
+            else
+            {
+                out += c;
+            }
+        }
+
+        return out;
+    }
+
+    // -------------------------------------------------------------------------
+    //  Recursive descent parser of the subset of JSON written by WriteJson
+    //  (objects, arrays, strings and numbers)
+    // -------------------------------------------------------------------------
+    class Parser
+    {
+        public:
+            Parser(std::string const & text):
+                m_text(text), m_pos(0), m_error()
+            {
+
+            }
+
+            bool results(std::vector<Result> & results)
+            {
+                return object([&](std::string const & key)
+                {
+                    if(key != "cases") return skip();
+
+                    return array([&]()
+                    {
+                        Result result;
+                        if(!this->result(result)) return false;
+                        results.push_back(result);
+                        return true;
+                    });
+                }) && end();
+            }
+
+            std::string const & error() const
+            {
+                return m_error;
+            }
+
+        private:
+            bool result(Result & result)
+            {
+                return object([&](std::string const & key)
+                {
+                    if(key == "name") return string(result.name);
+                    if(key != "metrics") return skip();
+
+                    return array([&]()
+                    {
+                        Metric metric{ "", 0.0, "" };
+                        if(!this->metric(metric)) return false;
+                        result.metrics.push_back(metric);
+                        return true;
+                    });
+                });
+            }
+
+            bool metric(Metric & metric)
+            {
+                return object([&](std::string const & key)
+                {
+                    if(key == "name") return string(metric.name);
+                    if(key == "value") return number(metric.value);
+                    if(key == "unit") return string(metric.unit);
+                    return skip();
+                });
+            }
+
+            // Call member(key) on every member of an object
+            template <typename F>
+            bool object(F member)
+            {
+                if(!expect('{')) return false;
+                if(accept('}')) return true;
+
+                do
+                {
+                    std::string key;
+                    if(!string(key) || !expect(':') || !member(key)) return false;
+                }
+                while(accept(','));
+
+                return expect('}');
+            }
+
+            // Call element() on every element of an array
+            template <typename F>
+            bool array(F element)
+            {
+                if(!expect('[')) return false;
+                if(accept(']')) return true;
+
+                do
+                {
+                    if(!element()) return false;
+                }
+                while(accept(','));
+
+                return expect(']');
+            }
+
+            bool string(std::string & s)
+            {
+                if(!expect('"')) return false;
+
+                s.clear();
+
+                while(m_pos < m_text.size() && m_text[m_pos] != '"')
+                {
+                    auto c = m_text[m_pos++];
+
+                    if(c == '\\' && m_pos < m_text.size())
+                    {
+                        c = m_text[m_pos++];
+
+                        if(c == 'u')
+                        {
+                            if(m_pos + 4 > m_text.size()) return fail("truncated escape");
+                            c = static_cast<char>(std::strtol(
+                                m_text.substr(m_pos, 4).c_str(), nullptr, 16));
+                            m_pos += 4;
+                        }
+                        else if(c == 'n') c = '\n';
+                        else if(c == 't') c = '\t';
+                    }
+
+                    s += c;
+                }
+
+                return expect('"');
+            }
+
+            bool number(double & value)
+            {
+                whitespaces();
+
+                auto const begin = m_text.c_str() + m_pos;
+                char * end = nullptr;
+                value = std::strtod(begin, &end);
+
+                if(end == begin) return fail("number expected");
+
+                m_pos += static_cast<std::size_t>(end - begin);
+                return true;
+            }
+
+            // Skip a value of any supported type
+            bool skip()
+            {
+                whitespaces();
+
+                if(m_pos >= m_text.size()) return fail("value expected");
+
+                switch(m_text[m_pos])
+                {
+                    case '{': return object([&](std::string const &) { return skip(); });
+                    case '[': return array([&]() { return skip(); });
+                    case '"': { std::string s; return string(s); }
+                    default:  { double d; return number(d); }
+                }
+            }
+
+            bool accept(char c)
+            {
+                whitespaces();
+
+                if(m_pos < m_text.size() && m_text[m_pos] == c)
+                {
+                    ++m_pos;
+                    return true;
+                }
+
+                return false;
+            }
+
+            bool expect(char c)
+            {
+                return accept(c) || fail(std::string("'") + c + "' expected");
+            }
+
+            bool end()
+            {
+                whitespaces();
+                return m_pos == m_text.size() || fail("trailing characters");
+            }
+
+            void whitespaces()
+            {
+                while(m_pos < m_text.size() && std::isspace(
+                    static_cast<unsigned char>(m_text[m_pos])))
+                {
+                    ++m_pos;
+                }
+            }
+
+            bool fail(std::string const & what)
+            {
+                if(m_error.empty())
+                {
+                    m_error = what + " at offset " + std::to_string(m_pos);
+                }
+
+                return false;
+            }
+
+            std::string const & m_text;
+            std::size_t m_pos;
+            std::string m_error;
+    };
+}
+
+void WriteJson(std::ostream & out, std::vector<Result> const & results)
+{
+    char value[32];
+
+    out << "{\n";
+    out << "  \"min_time_ms\": " << State::s_minTime << ",\n";
+    out << "  \"cases\": [";
+
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        auto const & r = results[i];
+
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    { \"name\": \"" << escape(r.name) << "\", \"metrics\": [";
+
+        for(std::size_t j = 0; j < r.metrics.size(); ++j)
+        {
+            auto const & m = r.metrics[j];
+
+            // %.17g : the value is read back exactly
+            std::snprintf(value, sizeof(value), "%.17g", m.value);
+
+            out << (j == 0 ? "\n" : ",\n");
+            out << "      { \"name\": \"" << escape(m.name) << "\", \"value\": "
+                << value << ", \"unit\": \"" << escape(m.unit) << "\" }";
+        }
+
+        out << "\n    ] }";
+    }
+
+    out << "\n  ]\n}\n";
+}
+
+bool ReadJson(std::istream & in, std::vector<Result> & results)
+{
+    std::string const text((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+
+    Parser parser(text);
+
+    if(!parser.results(results))
+    {
+        std::cerr << "Bench::ReadJson : " << parser.error() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t Compare(std::vector<Result> const & baseline,
+    std::vector<Result> const & current, double threshold, std::ostream & out,
+    bool details)
+{
+    std::map<std::string, double> reference;
+
+    for(auto const & r : baseline)
+    {
+        for(auto const & m : r.metrics)
+        {
+            if(m.unit == "ns") reference[r.name + "/" + m.name] = m.value;
+        }
+    }
+
+    std::size_t regressions = 0;
+    std::size_t compared = 0;
+    double logSpeedups = 0.0;
+    char line[256];
+
+    if(details)
+    {
+        std::snprintf(line, sizeof(line), "%-56s %12s %12s %8s\n",
+            "metric", "baseline", "current", "change");
+        out << line;
+    }
+
+    for(auto const & r : current)
+    {
+        for(auto const & m : r.metrics)
+        {
+            if(m.unit != "ns") continue;
+
+            auto const key = r.name + "/" + m.name;
+            auto const it = reference.find(key);
+
+            if(it == reference.end() || it->second <= 0.0 || m.value <= 0.0) continue;
+
+            auto const change = m.value / it->second - 1.0;
+            auto const regression = change > threshold;
+
+            regressions += regression ? 1 : 0;
+            logSpeedups += std::log(it->second / m.value);
+            ++compared;
+
+            if(details || regression)
+            {
+                std::snprintf(line, sizeof(line), "%-56s %12.2f %12.2f %+7.1f%%%s\n",
+                    key.c_str(), it->second, m.value, change * 100.0,
+                    regression ? "  REGRESSION" : "");
+                out << line;
+            }
+        }
+    }
+
+    auto const speedup = compared > 0 ?
+        std::exp(logSpeedups / static_cast<double>(compared)) : 1.0;
+
+    std::snprintf(line, sizeof(line),
+        "%zu timings compared, geometric mean speedup x%.3f, %zu regression(s)\n",
+        compared, speedup, regressions);
+    out << line;
+
+    return regressions;
+}
+
+}
+
+}
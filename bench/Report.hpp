@@ -0,0 +1,58 @@
+#ifndef RPI_BENCH_REPORT_HPP
+#define RPI_BENCH_REPORT_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <Bench.hpp>
+
+namespace RPi {
+
+namespace Bench {
+
+    // Metrics of one case, detached from its State
+    struct Result
+    {
+        std::string name;
+        std::vector<Metric> metrics;
+    };
+
+    // -------------------------------------------------------------------------
+    //  Write the results as JSON
+    //
+    //   { "min_time_ms": 50, "cases": [ { "name": "...", "metrics": [
+    //       { "name": "...", "value": 1.5, "unit": "ns" }, ... ] }, ... ] }
+    // -------------------------------------------------------------------------
+    void WriteJson(std::ostream & out, std::vector<Result> const & results);
+
+    // -------------------------------------------------------------------------
+    //  Read results written by WriteJson
+    //
+    //   returns false (and prints the reason on std::cerr) if the document
+    //   is not valid
+    // -------------------------------------------------------------------------
+    bool ReadJson(std::istream & in, std::vector<Result> & results);
+
+    // -------------------------------------------------------------------------
+    //  Compare the timings (metrics in ns) with a baseline
+    //
+    //   - baseline  : reference results
+    //   - current   : results of this run
+    //   - threshold : relative slowdown flagged as a regression (0.05 = 5%)
+    //   - out       : where the comparison is printed
+    //   - details   : print every timing, not only the summary
+    //
+    //   The summary gives the geometric mean of the speedups.
+    //
+    //   returns the number of regressions
+    // -------------------------------------------------------------------------
+    std::size_t Compare(std::vector<Result> const & baseline,
+        std::vector<Result> const & current, double threshold, std::ostream & out,
+        bool details = true);
+}
+
+}
+
+#endif //RPI_BENCH_REPORT_HPP
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <glm/gtx/transform.hpp>
+
+#include <Bench.hpp>
+#include <SceneGraph.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    std::size_t const GROUPS = 100;
+    std::size_t const LEAVES = 100;
+
+    float max_difference(glm::mat4 const & a, glm::mat4 const & b)
+    {
+        float d = 0.f;
+
+        for(int c = 0; c < 4; ++c)
+        {
+            for(int r = 0; r < 4; ++r) d = std::max(d, std::fabs(a[c][r] - b[c][r]));
+        }
+
+        return d;
+    }
+}
+
+// -----------------------------------------------------------------------------
+//  Root -> 100 groups -> 100 leaves each, created breadth first so that the
+//  first update sorts the nodes
+// -----------------------------------------------------------------------------
+RPI_BENCH(SceneGraph_Update)
+{
+    SceneGraph scene;
+
+    auto const root = scene.add();
+
+    std::vector<SceneGraph::Node> groups;
+    std::vector<SceneGraph::Node> leaves;
+
+    for(std::size_t g = 0; g < GROUPS; ++g)
+    {
+        groups.push_back(scene.add(root, glm::translate(glm::vec3(g, 0.f, 0.f))));
+    }
+
+    for(std::size_t l = 0; l < GROUPS * LEAVES; ++l)
+    {
+        leaves.push_back(scene.add(groups[l % GROUPS],
+            glm::rotate(glm::mat4(1.f), static_cast<float>(l), glm::vec3(0, 1, 0))));
+    }
+
+    scene.update();
+
+    // World matrices of the leaves computed by hand
+    scene.rotate(root, 10.f, glm::vec3(1, 0, 0));
+    scene.translate(groups[42], glm::vec3(0, 1, 0));
+    scene.update();
+
+    float error = 0.f;
+
+    for(std::size_t l = 0; l < leaves.size(); ++l)
+    {
+        auto const g = groups[l % GROUPS];
+        auto const expected = scene.local(root) * scene.local(g) * scene.local(leaves[l]);
+
+        error = std::max(error, max_difference(scene.world(leaves[l]), expected));
+    }
+
+    state.measure("static scene", [&]()
+    {
+        Bench::DoNotOptimize(scene.update());
+    });
+
+    state.measure("one leaf moved", [&]()
+    {
+        scene.rotate(leaves[4242], 1.f, glm::vec3(0, 1, 0));
+        Bench::DoNotOptimize(scene.update());
+    });
+
+    state.measure("one group moved", [&]()
+    {
+        scene.rotate(groups[42], 1.f, glm::vec3(0, 1, 0));
+        Bench::DoNotOptimize(scene.update());
+    });
+
+    state.measure("root moved", [&]()
+    {
+        scene.rotate(root, 1.f, glm::vec3(0, 1, 0));
+        Bench::DoNotOptimize(scene.update());
+    });
+
+    // Reparenting a leaf sorts the nodes again
+    std::size_t other = 0;
+
+    state.measure("reparent + sort", [&]()
+    {
+        scene.parent(leaves[0], groups[other]);
+        other = (other + 1) % GROUPS;
+        Bench::DoNotOptimize(scene.update());
+    });
+
+    state.metric("nodes", static_cast<double>(scene.size()), "");
+    state.metric("max error", error, "");
+}
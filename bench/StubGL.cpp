@@ -0,0 +1,153 @@
+#include <array>
+
+#include <EGLHeaders.hpp>
+
+#include <StubGL.hpp>
+
+namespace {
+
+    std::size_t s_calls = 0;
+    GLuint s_nextName = 1;
+
+    // Locations are 8 bits, see glGetUniformLocation
+    std::array<GLfloat, 256> s_uniforms{};
+    std::function<void()> s_drawHook;
+}
+
+namespace RPi {
+
+namespace Bench {
+
+std::size_t StubGL::Calls()
+{
+    return s_calls;
+}
+
+void StubGL::ResetCalls()
+{
+    s_calls = 0;
+}
+
+float StubGL::Uniform1f(GLint location)
+{
+    return s_uniforms[static_cast<std::size_t>(location) & 0xff];
+}
+
+void StubGL::SetDrawHook(std::function<void()> const & hook)
+{
+    s_drawHook = hook;
+}
+
+}
+
+}
+
+extern "C" {
+
+GL_APICALL GLuint GL_APIENTRY glCreateProgram(void)
+{
+    ++s_calls;
+    return s_nextName++;
+}
+
+GL_APICALL void GL_APIENTRY glDeleteProgram(GLuint)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glBindAttribLocation(GLuint, GLuint, GLchar const *)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glUseProgram(GLuint)
+{
+    ++s_calls;
+}
+
+GL_APICALL GLint GL_APIENTRY glGetUniformLocation(GLuint, GLchar const * name)
+{
+    ++s_calls;
+
+    // Walk the name as the driver would hash it
+    GLint h = 0;
+    while(*name) h = h * 31 + *name++;
+    return h & 0xff;
+}
+
+GL_APICALL void GL_APIENTRY glUniform1f(GLint location, GLfloat v0)
+{
+    ++s_calls;
+    s_uniforms[static_cast<std::size_t>(location) & 0xff] = v0;
+}
+
+GL_APICALL void GL_APIENTRY glUniform3fv(GLint, GLsizei, GLfloat const *)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glUniform4fv(GLint, GLsizei, GLfloat const *)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glUniformMatrix4fv(GLint, GLsizei, GLboolean, GLfloat const *)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glGenBuffers(GLsizei n, GLuint * buffers)
+{
+    ++s_calls;
+    for(GLsizei i = 0; i < n; ++i) buffers[i] = s_nextName++;
+}
+
+GL_APICALL void GL_APIENTRY glDeleteBuffers(GLsizei, GLuint const *)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glBindBuffer(GLenum, GLuint)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glBufferData(GLenum, GLsizeiptr, void const *, GLenum)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glBufferSubData(GLenum, GLintptr, GLsizeiptr, void const *)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean,
+    GLsizei, void const *)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glEnableVertexAttribArray(GLuint)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glDisableVertexAttribArray(GLuint)
+{
+    ++s_calls;
+}
+
+GL_APICALL void GL_APIENTRY glDrawArrays(GLenum, GLint, GLsizei)
+{
+    ++s_calls;
+    if(s_drawHook) s_drawHook();
+}
+
+GL_APICALL void GL_APIENTRY glDrawElements(GLenum, GLsizei, GLenum, void const *)
+{
+    ++s_calls;
+    if(s_drawHook) s_drawHook();
+}
+
+}
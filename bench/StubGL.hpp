@@ -0,0 +1,39 @@
+#ifndef RPI_STUB_GL_HPP
+#define RPI_STUB_GL_HPP
+
+#include <cstddef>
+#include <functional>
+
+#include <EGLHeaders.hpp>
+
+namespace RPi {
+
+namespace Bench {
+
+    // -------------------------------------------------------------------------
+    //  No-op OpenGL ES entry points
+    //
+    //   StubGL.cpp defines the GL functions used by the rendering paths
+    //   (buffers, programs, uniforms, vertex arrays and draws). Definitions of
+    //   the executable take precedence over the ones of libGLESv2, so the
+    //   benchmarks measure the CPU side of these paths without a context.
+    // -------------------------------------------------------------------------
+    namespace StubGL {
+
+        // Number of GL calls since the last reset
+        std::size_t Calls();
+
+        void ResetCalls();
+
+        // Value last sent by glUniform1f to a location
+        float Uniform1f(GLint location);
+
+        // Called by glDrawArrays and glDrawElements, to check the state of
+        // each draw (an empty function removes the hook)
+        void SetDrawHook(std::function<void()> const & hook);
+    }
+}
+
+}
+
+#endif //RPI_STUB_GL_HPP
@@ -0,0 +1,88 @@
+#include <cmath>
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include <Animation.hpp>
+#include <Bench.hpp>
+#include <GLSLProgram.hpp>
+#include <StubGL.hpp>
+#include <Terrain.hpp>
+#include <Utils.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    // Wave of TestApp : a table sampled every 100 ms
+    float const WAVE_TICK = 100.f;
+    float const WAVE_PERIOD = 64 * WAVE_TICK;
+
+    float wave(float t)
+    {
+        return std::cos(static_cast<float>(-2 * M_PI + 4 * M_PI * t / WAVE_PERIOD));
+    }
+
+    // Frames counted for the GL calls : a tick of the wave every 6 frames
+    int const FRAMES = 60;
+}
+
+RPI_BENCH(Terrain_Constructor)
+{
+    // TestApp builds a 50 x 50 terrain
+    for(std::size_t size : { 10, 50, 100 })
+    {
+        auto const label = Utils::String(size) + "x" + Utils::String(size);
+
+        auto const ns = state.measure(label, [&]()
+        {
+            Terrain terrain(size, size);
+            Bench::DoNotOptimize(terrain.getMaxHeight());
+        });
+
+        Terrain const terrain(size, size);
+        auto const vertices = terrain.heightfield().width() * terrain.heightfield().depth();
+
+        state.metric(label + " per vertex", ns / static_cast<double>(vertices), "ns");
+    }
+}
+
+RPI_BENCH(Uniforms_Frame)
+{
+    GLSLProgram program;
+    GLSLProgram litProgram;
+    Terrain terrain(50, 50);
+
+    glm::mat4 projection(1.f);
+    glm::mat4 modelView(1.f);
+
+    Animator animator(WAVE_TICK);
+    animator.add(AnimationCurve(wave, WAVE_PERIOD), 0, 1.5f);
+    animator.block().set(1, 1.5f);
+
+    // Animation uploads and draws of a TestApp frame at 60 FPS
+    auto const frame = [&]()
+    {
+        animator.advance(16.7f);
+        animator.block().upload(program);
+        animator.block().upload(litProgram);
+
+        terrain.render(litProgram, projection, modelView);
+    };
+
+    state.measure("frame", frame);
+
+    Bench::StubGL::ResetCalls();
+    for(int i = 0; i < FRAMES; ++i) frame();
+    state.metric("GL calls per frame", static_cast<double>(Bench::StubGL::Calls()) / FRAMES, "");
+
+    state.measure("sendFloat", [&]()
+    {
+        program.sendFloat("maxHeight", 1.5f);
+    });
+
+    state.measure("sendMatrix", [&]()
+    {
+        program.sendMatrix("MatModelView", modelView);
+    });
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <glm/gtx/transform.hpp>
+
+#include <Bench.hpp>
+#include <TransformStore.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    // Layout of a cube before the transform store : the geometry arrays
+    // next to the transform of every object
+    struct LegacyCube
+    {
+        float vertices[108];
+        float colors[108];
+        glm::mat4 transform;
+    };
+
+    float frandom(float min, float max)
+    {
+        return min + (max - min) * static_cast<float>(std::rand()) / RAND_MAX;
+    }
+
+    glm::vec3 axis()
+    {
+        return glm::vec3(frandom(-1.f, 1.f), frandom(-1.f, 1.f), 1.f);
+    }
+
+    float max_difference(glm::mat4 const & a, glm::mat4 const & b)
+    {
+        float d = 0.f;
+
+        for(int c = 0; c < 4; ++c)
+        {
+            for(int r = 0; r < 4; ++r) d = std::max(d, std::fabs(a[c][r] - b[c][r]));
+        }
+
+        return d;
+    }
+
+    void transforms(Bench::State & state, std::size_t count)
+    {
+        std::srand(1);
+
+        auto const view = glm::lookAt(glm::vec3(21, 11, 20), glm::vec3(13, 1, 11),
+            glm::vec3(0, 1, 0));
+
+        std::vector<LegacyCube> cubes(count);
+        std::vector<glm::mat4> modelViews(count);
+
+        TransformStore store;
+        store.reserve(count);
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            auto const p = glm::vec3(frandom(-100.f, 100.f), 0.f, frandom(-100.f, 100.f));
+            auto const s = frandom(0.5f, 2.f);
+            auto const a = axis();
+            auto const angle = frandom(0.f, 180.f);
+
+            cubes[i].transform = glm::translate(glm::mat4(1.f), p);
+            cubes[i].transform = glm::rotate(cubes[i].transform, angle, a);
+            cubes[i].transform = glm::scale(cubes[i].transform, glm::vec3(s));
+
+            store.add(p, glm::vec3(s));
+            store.rotate(i, angle, a);
+        }
+
+        // Both paths must compute the same matrices
+        store.updateModelViews(view);
+
+        float error = 0.f;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            error = std::max(error, max_difference(store.modelView(i),
+                view * cubes[i].transform));
+        }
+
+        auto const label = std::to_string(count);
+        auto const n = static_cast<double>(count);
+
+        auto const glmNs = state.measure(label + " glm per object", [&]()
+        {
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                modelViews[i] = view * cubes[i].transform;
+            }
+
+            Bench::DoNotOptimize(modelViews[count - 1]);
+        });
+
+        auto const storeNs = state.measure(label + " store", [&]()
+        {
+            store.updateModelViews(view);
+            Bench::DoNotOptimize(*store.modelViews());
+        });
+
+        auto const rotation = glm::vec3(1.f, 1.f, 0.f);
+
+        // The commented out animation of the cube field
+        auto const glmRotateNs = state.measure(label + " glm rotate", [&]()
+        {
+            for(auto & c : cubes)
+            {
+                c.transform = glm::rotate(c.transform, 1.f, rotation);
+            }
+
+            Bench::DoNotOptimize(cubes[count - 1].transform);
+        });
+
+        auto const storeRotateNs = state.measure(label + " store rotate", [&]()
+        {
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                store.rotate(i, 1.f, rotation);
+            }
+
+            Bench::DoNotOptimize(store.rotation(count - 1));
+        });
+
+        state.metric(label + " glm per object", n * 1000.0 / glmNs, "transforms/us");
+        state.metric(label + " store", n * 1000.0 / storeNs, "transforms/us");
+        state.metric(label + " glm rotate", n * 1000.0 / glmRotateNs, "rotations/us");
+        state.metric(label + " store rotate", n * 1000.0 / storeRotateNs, "rotations/us");
+        state.metric(label + " max error", error, "");
+    }
+}
+
+RPI_BENCH(Transform_1k)
+{
+    transforms(state, 1000);
+}
+
+RPI_BENCH(Transform_10k)
+{
+    transforms(state, 10000);
+}
+
+RPI_BENCH(Transform_100k)
+{
+    transforms(state, 100000);
+}
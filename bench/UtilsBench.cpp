@@ -0,0 +1,32 @@
+#include <string>
+
+#include <Bench.hpp>
+#include <Utils.hpp>
+
+using namespace RPi;
+
+RPI_BENCH(Utils_Number)
+{
+    std::string const integer = "1234567";
+    std::string const real = "3.14159265";
+
+    state.measure("Number<int>", [&]()
+    {
+        Bench::DoNotOptimize(Utils::Number<int>(integer));
+    });
+
+    state.measure("Number<float>", [&]()
+    {
+        Bench::DoNotOptimize(Utils::Number<float>(real));
+    });
+
+    state.measure("Number<double>", [&]()
+    {
+        Bench::DoNotOptimize(Utils::Number<double>(real));
+    });
+
+    state.measure("String<float>", [&]()
+    {
+        Bench::DoNotOptimize(Utils::String(3.14159265f));
+    });
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Bench.hpp>
+#include <VertexFormat.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    // Same vertex count and extent as Terrain(50, 50)
+    std::vector<glm::vec3> terrain_positions()
+    {
+        std::vector<glm::vec3> positions;
+
+        float const step = 0.2f;
+
+        for(float i = 0.f; i < 50.f; i += step)
+        {
+            for(float j = 0.f; j < 50.f; j += step)
+            {
+                positions.push_back(glm::vec3(i, std::sin(i) * std::cos(j), j));
+                positions.push_back(glm::vec3(i, std::sin(i) * std::cos(j + step), j + step));
+                positions.push_back(glm::vec3(i + step, std::sin(i + step) * std::cos(j), j));
+                positions.push_back(glm::vec3(i + step, std::sin(i + step) * std::cos(j + step), j + step));
+            }
+        }
+
+        return positions;
+    }
+
+    // Sizes of a layout, derived from its stride : not measurements
+    void sizes(Bench::State & state, char const * layout,
+        double floatStride, double packedStride, double nbVertices)
+    {
+        // Vertices read by one draw of the buffer
+        auto const floatKB  = floatStride  * nbVertices / 1024.0;
+        auto const packedKB = packedStride * nbVertices / 1024.0;
+
+        std::string const name(layout);
+
+        state.metric(name + " float stride", floatStride, "B");
+        state.metric(name + " packed stride", packedStride, "B");
+        state.metric(name + " float bytes per frame", floatKB, "KB");
+        state.metric(name + " packed bytes per frame", packedKB, "KB");
+        state.metric(name + " saved", 100.0 * (1.0 - packedStride / floatStride), "%");
+    }
+}
+
+RPI_BENCH(VertexFormat_Terrain)
+{
+    auto const positions = terrain_positions();
+
+    glm::vec3 min = positions[0];
+    glm::vec3 max = positions[0];
+
+    for(auto const & p : positions)
+    {
+        for(auto c = 0; c < 3; ++c)
+        {
+            min[c] = std::min(min[c], p[c]);
+            max[c] = std::max(max[c], p[c]);
+        }
+    }
+
+    auto const nbVertices = static_cast<double>(positions.size());
+    state.metric("vertices", nbVertices, "");
+
+    std::vector<Vertex::P16> packed(positions.size());
+
+    for(auto encoding : { PositionEncoding::Snorm16, PositionEncoding::Fixed16 })
+    {
+        PositionQuantizer quantizer(min, max, encoding);
+        std::string const name = encoding == PositionEncoding::Snorm16 ?
+            "snorm16" : "fixed16";
+
+        auto const ns = state.measure(name + " encode", [&]()
+        {
+            for(std::size_t v = 0; v < positions.size(); ++v)
+            {
+                quantizer.encode(positions[v], packed[v].position);
+            }
+            Bench::DoNotOptimize(packed[0]);
+        });
+
+        state.metric(name + " encode per vertex", ns / nbVertices, "ns");
+
+        float error = 0.f;
+
+        for(std::size_t v = 0; v < positions.size(); ++v)
+        {
+            auto const d = quantizer.decode(packed[v].position) - positions[v];
+            error = std::max(error, std::max(std::abs(d.x),
+                std::max(std::abs(d.y), std::abs(d.z))));
+        }
+
+        state.metric(name + " max error", error, "");
+    }
+
+    sizes(state, "position", sizeof(Vertex::P32), sizeof(Vertex::P16),
+        nbVertices);
+
+    sizes(state, "position+normal", 2 * sizeof(Vertex::P32),
+        sizeof(Vertex::P16N8), nbVertices);
+}
+
+RPI_BENCH(VertexFormat_Cube)
+{
+    // 150 cubes of 36 vertices, positions only : the float cube had no color
+    // buffer either
+    auto const nbVertices = 150.0 * 36.0;
+
+    sizes(state, "position", sizeof(Vertex::P32), sizeof(Vertex::P16),
+        nbVertices);
+}
@@ -0,0 +1,186 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+#include <Bench.hpp>
+#include <Report.hpp>
+#include <Utils.hpp>
+
+using namespace RPi;
+
+namespace RPi {
+
+namespace Bench {
+
+double State::s_minTime = 50.0;
+
+State::State(std::string const & name):
+    m_name(name), m_metrics()
+{
+
+}
+
+void State::metric(std::string const & name, double value,
+    std::string const & unit)
+{
+    m_metrics.push_back({ name, value, unit });
+}
+
+std::string const & State::name() const
+{
+    return m_name;
+}
+
+std::vector<Metric> const & State::metrics() const
+{
+    return m_metrics;
+}
+
+std::vector<Case> & Registry()
+{
+    static std::vector<Case> registry;
+    return registry;
+}
+
+Registrar::Registrar(char const * name, Func func)
+{
+    Registry().push_back({ name, func });
+}
+
+}
+
+}
+
+static struct Param
+{
+    std::string filter = "";
+    std::string output = "";     // JSON file of the results
+    std::string baseline = "";   // JSON file of the reference results
+    double threshold = 5.0;      // Regression threshold in %
+    bool summary = false;        // Only print the summary of the comparison
+    bool quiet = false;          // Do not print the metrics
+} s_param;
+
+// Exit status of a run slower than its baseline, apart from the errors (1)
+int const REGRESSION_STATUS = 2;
+
+void parse_args(int argc, char ** argv);
+
+int main(int argc, char ** argv)
+{
+    parse_args(argc, argv);
+
+    std::vector<Bench::Result> results;
+
+    for(auto const & c : Bench::Registry())
+    {
+        if(std::string(c.name).find(s_param.filter) == std::string::npos)
+            continue;
+
+        Bench::State state(c.name);
+        c.func(state);
+
+        if(!s_param.quiet)
+        {
+            std::cout << state.name() << std::endl;
+
+            for(auto const & m : state.metrics())
+            {
+                std::printf("    %-40s %16.4f %s\n", m.name.c_str(), m.value,
+                    m.unit.c_str());
+            }
+        }
+
+        results.push_back({ state.name(), state.metrics() });
+    }
+
+    if(!s_param.output.empty())
+    {
+        std::ofstream file(s_param.output);
+
+        if(!file)
+        {
+            std::cerr << "Failed to open " << s_param.output << std::endl;
+            return 1;
+        }
+
+        Bench::WriteJson(file, results);
+    }
+
+    if(!s_param.baseline.empty())
+    {
+        std::ifstream file(s_param.baseline);
+        std::vector<Bench::Result> baseline;
+
+        if(!file)
+        {
+            std::cerr << "Failed to open " << s_param.baseline << std::endl;
+            return 1;
+        }
+
+        if(!Bench::ReadJson(file, baseline)) return 1;
+
+        if(!s_param.quiet) std::cout << std::endl;
+
+        auto const regressions = Bench::Compare(baseline, results,
+            s_param.threshold / 100.0, std::cout, !s_param.summary);
+
+        if(regressions > 0)
+        {
+            std::cout << regressions << " regression(s) beyond "
+                      << s_param.threshold << "%" << std::endl;
+            return REGRESSION_STATUS;
+        }
+    }
+
+    return 0;
+}
+
+void parse_args(int argc, char ** argv)
+{
+    int c;
+
+    while((c = getopt(argc, argv, "f:t:o:b:r:sq")) != -1)
+    {
+        switch(c)
+        {
+            case 'f':
+                s_param.filter = optarg;
+                break;
+            case 't':
+                Bench::State::s_minTime = Utils::Number<double>(optarg);
+                break;
+            case 'o':
+                s_param.output = optarg;
+                break;
+            case 'b':
+                s_param.baseline = optarg;
+                break;
+            case 'r':
+                s_param.threshold = Utils::Number<double>(optarg);
+                break;
+            case 's':
+                s_param.summary = true;
+                break;
+            case 'q':
+                s_param.quiet = true;
+                break;
+            case '?':
+                if(optopt == 'f')
+                    fprintf (stderr, "Option -%c requires a filter.\n", optopt);
+                else if(optopt == 't' || optopt == 'r')
+                    fprintf (stderr, "Option -%c requires a number.\n", optopt);
+                else if(optopt == 'o' || optopt == 'b')
+                    fprintf (stderr, "Option -%c requires a JSON file.\n", optopt);
+                else
+                    fprintf (stderr, "Unknown option `-%c'.\n", optopt);
+                exit(1);
+            default:
+                exit(2);
+        }
+    }
+}
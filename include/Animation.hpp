@@ -0,0 +1,137 @@
+#ifndef RPI_ANIMATION_HPP
+#define RPI_ANIMATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace RPi {
+
+class GLSLProgram;
+
+// -----------------------------------------------------------------------------
+//  Looping animation curve read from a table
+//
+//   The curve is tabulated once over one period and sample() interpolates
+//   linearly between two entries : a cos() or any other function costs a
+//   table read, whatever its complexity.
+// -----------------------------------------------------------------------------
+class AnimationCurve
+{
+    public:
+        AnimationCurve();
+
+        // Tabulate <f> over [0, period) ms with <samples> entries
+        AnimationCurve(std::function<float(float)> const & f, float period,
+            std::size_t samples = 256);
+
+        float period() const;
+        std::size_t samples() const;
+
+        // Value at <t> ms, looping over the period
+        float sample(float t) const;
+
+    private:
+        std::vector<float> m_table;
+        float m_period;
+        float m_rate;   // entries per ms
+};
+
+// -----------------------------------------------------------------------------
+//  Animation parameters of a frame
+//
+//   Every animated value is one float of an array of vec4, which the shaders
+//   declare as
+//      uniform vec4 Animation[4];
+//   Parameter p is Animation[p / 4][p % 4]. upload() sends the whole array
+//   in a single glUniform4fv call, and only to the programs that do not have
+//   the current values yet : more parameters cost neither more calls nor
+//   more work per vertex.
+// -----------------------------------------------------------------------------
+class AnimationBlock
+{
+    public:
+        // vec4 of the block, the size of the array in the shaders
+        static std::size_t const SIZE = 4;
+
+        AnimationBlock();
+
+        void set(std::size_t param, float value);
+        float get(std::size_t param) const;
+
+        // SIZE * 4 floats
+        float const * data() const;
+
+        // Changes on every set() of a new value
+        std::uint32_t version() const;
+
+        // Returns false if the program already has the current values
+        bool upload(GLSLProgram const & program);
+
+    private:
+        std::array<float, SIZE * 4> m_values;
+        std::uint32_t m_version;
+
+        // Version last sent to each program
+        std::vector<std::pair<GLSLProgram const *, std::uint32_t>> m_uploaded;
+};
+
+// -----------------------------------------------------------------------------
+//  Curves evaluated into an AnimationBlock at a fixed tick
+//
+//   advance() moves the clock of the animations and evaluates every track
+//   once per elapsed tick : not per frame, per draw or per vertex. Between
+//   two ticks the parameters do not change, so neither do the frames of a
+//   static camera (see ChangeTracker).
+// -----------------------------------------------------------------------------
+class Animator
+{
+    public:
+        using Track = std::size_t;
+
+        // <tick> : ms between two evaluations
+        explicit Animator(float tick);
+
+        // Evaluate <curve> times <scale> into <param> of the block
+        Track add(AnimationCurve const & curve, std::size_t param, float scale = 1.f);
+
+        // Change the scale of a track, from the current tick on
+        void scale(Track track, float scale);
+
+        // Periods of the curve of a track completed at the current tick
+        std::size_t loops(Track track) const;
+
+        // Advance the clock by <ms>, returns whether the tracks were
+        // evaluated (always on the first call)
+        bool advance(float ms);
+
+        // Time of the current tick in ms
+        double time() const;
+
+        AnimationBlock & block();
+        AnimationBlock const & block() const;
+
+    private:
+        struct TrackData
+        {
+            AnimationCurve curve;
+            std::size_t param;
+            float scale;
+        };
+
+        void evaluate(TrackData const & track);
+
+        std::vector<TrackData> m_tracks;
+        AnimationBlock m_block;
+        float m_tick;
+        std::uint64_t m_ticks;
+        float m_elapsed;    // since the current tick
+        bool m_evaluated;
+};
+
+}
+
+#endif //RPI_ANIMATION_HPP
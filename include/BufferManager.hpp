@@ -0,0 +1,122 @@
+#ifndef RPI_BUFFER_MANAGER_HPP
+#define RPI_BUFFER_MANAGER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <EGLHeaders.hpp>
+
+namespace RPi {
+
+// Bytes [offset, offset + size[ of a GL buffer
+struct BufferRange
+{
+    BufferRange();
+
+    GLuint buffer;
+    std::size_t offset;
+    std::size_t size;
+
+    bool valid() const;
+};
+
+// GPU memory of a buffer manager
+struct BufferStats
+{
+    BufferStats();
+
+    std::size_t buffers;        // GL buffers alive
+    std::size_t allocatedBytes; // storage of these buffers
+    std::size_t peakBytes;      // most storage allocated at once
+    std::size_t usedBytes;      // bytes of the live static ranges
+    std::size_t ranges;         // live static ranges
+
+    std::size_t streamedBytes;  // bytes uploaded by stream()
+    std::size_t orphans;        // storages orphaned by the stream rings
+};
+
+// -----------------------------------------------------------------------------
+//  Owner of the GL buffers of the geometry
+//
+//   Static geometry is sub-allocated from pages of pageSize bytes (or one
+//   page of its own when bigger) : allocate() uploads the data once and
+//   returns the range to draw from, release() gives it back and deletes the
+//   pages left empty. Many meshes thus share a few buffers, which the render
+//   queue sorts by.
+//
+//   Dynamic geometry is streamed through a ring per target : stream() writes
+//   the data with glBufferSubData after the data of the previous calls. When
+//   the ring is full its storage is orphaned with glBufferData(NULL), so the
+//   driver hands out fresh memory instead of waiting for the GPU to finish
+//   the draws reading the old one. A streamed range is valid until the ring
+//   wraps, so for the draws of the current frame only.
+//
+//   Both leave GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER unbound.
+// -----------------------------------------------------------------------------
+class BufferManager
+{
+    public:
+        BufferManager(std::size_t pageSize = 256 * 1024,
+            std::size_t streamSize = 64 * 1024);
+        ~BufferManager();
+
+        BufferManager(BufferManager const &) = delete;
+        BufferManager & operator=(BufferManager const &) = delete;
+
+        // target is GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER. The offset of
+        // the range is a multiple of 16 bytes.
+        BufferRange allocate(GLenum target, void const * data, std::size_t size);
+
+        // Resets the range
+        void release(BufferRange & range);
+
+        BufferRange stream(GLenum target, void const * data, std::size_t size);
+
+        BufferStats const & stats() const;
+
+        // Manager of the geometry of the app, created on first use once a
+        // context is current
+        static BufferManager & Default();
+
+    private:
+        struct Block
+        {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        struct Page
+        {
+            GLenum target;
+            GLuint buffer;
+            std::size_t size;
+            std::size_t used;
+
+            // Free blocks sorted by offset
+            std::vector<Block> free;
+        };
+
+        struct Ring
+        {
+            GLenum target;
+            GLuint buffer;
+            std::size_t size;
+            std::size_t head;
+        };
+
+        GLuint createBuffer(GLenum target, std::size_t size, void const * data,
+            GLenum usage);
+        void deleteBuffer(GLuint buffer, std::size_t size);
+
+        Ring & ring(GLenum target);
+
+        std::size_t m_pageSize;
+        std::size_t m_streamSize;
+        std::vector<Page> m_pages;
+        std::vector<Ring> m_rings;
+        BufferStats m_stats;
+};
+
+}
+
+#endif //RPI_BUFFER_MANAGER_HPP
@@ -6,6 +6,9 @@
 #include <Input.hpp>
 
 namespace RPi {
+
+    class Heightfield;
+
     class Camera
     {
         typedef float Angle;
@@ -47,9 +50,22 @@ namespace RPi {
         void enableMouse(bool mouse);
         bool isMouseEnabled() const;
 
-    private:
+        // ---------------------------------------------------------------------
+        //  Keep the camera above a terrain when it moves
+        //
+        //   - heightfield : terrain (nullptr to fly freely)
+        //   - clearance   : minimal height above the ground
+        //   - follow      : stick to the ground instead of only colliding
+        // ---------------------------------------------------------------------
+        void followTerrain(Heightfield const * heightfield,
+            float clearance = 1.f, bool follow = false);
+
+        // Turn the camera by a relative mouse motion (in pixels)
         void orient(float xRel, float yRel);
+
+    private:
         void updateMV();
+        void collide(glm::vec3 const & previous);
 
     protected:
         Angle m_phi;
@@ -66,6 +82,10 @@ namespace RPi {
 
         bool m_mouseEnabled;
 
+        Heightfield const * m_terrain;
+        float m_clearance;
+        bool m_followTerrain;
+
         bool m_needUpdateMV;
 };
 
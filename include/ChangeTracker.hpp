@@ -0,0 +1,62 @@
+#ifndef RPI_CHANGE_TRACKER_HPP
+#define RPI_CHANGE_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Change detection of the inputs of a frame
+//
+//   Every frame, the loop tracks what its render reads : camera matrices,
+//   uniform values, ... and invalidates the frame for the changes it knows
+//   of without comparing (a scene graph update, a new HUD text). A frame
+//   whose inputs are the bytes of the last presented frame would render the
+//   same pixels : the loop skips its render and its swap, and the window
+//   keeps showing the last frame.
+// -----------------------------------------------------------------------------
+class ChangeTracker
+{
+    public:
+        ChangeTracker();
+
+        // Start the inputs of a new frame
+        void begin();
+
+        void track(glm::mat4 const & matrix);
+        void track(float value);
+        void track(void const * data, std::size_t size);
+
+        // The frame changed whatever its inputs
+        void invalidate();
+
+        // Whether the frame differs from the last presented one (always true
+        // before the first one)
+        bool changed() const;
+
+        // The frame was rendered and presented : its inputs are the new
+        // reference
+        void presented();
+
+        // The frame was skipped
+        void skipped();
+
+        // Frames since the construction
+        std::size_t presentedFrames() const;
+        std::size_t skippedFrames() const;
+
+    private:
+        std::vector<std::uint8_t> m_inputs;
+        std::vector<std::uint8_t> m_presented;
+        bool m_invalid;
+        std::size_t m_presentedFrames;
+        std::size_t m_skippedFrames;
+};
+
+}
+
+#endif //RPI_CHANGE_TRACKER_HPP
@@ -27,6 +27,7 @@ namespace RPi {
         EGLSurface eglSurface = EGL_NO_SURFACE;
         EGLNativeWindowType eglWindow = 0;
         GLSLProgram * program = nullptr;
+        GLSLProgram * litProgram = nullptr;
         DrawFunc drawFunc     = nullptr;
         UpdateFunc updateFunc = nullptr;
         KeyFunc keyFunc       = nullptr;
@@ -2,12 +2,20 @@
 #define RPI_CUBE_HPP
 
 #include <glm/glm.hpp>
-//#include <
-//#include <EGLHeaders.hpp>
+
 #include <GLSLProgram.hpp>
 
 namespace RPi {
 
+class RenderQueue;
+class TransformStore;
+
+// -----------------------------------------------------------------------------
+//  Wireframe cube
+//
+//   Every cube draws the same unit cube geometry, created with the first cube
+//   and shared afterwards : a cube only owns its transform.
+// -----------------------------------------------------------------------------
 class Cube
 {
     public:
@@ -20,13 +28,31 @@ class Cube
 
         void translate(glm::vec3 const & axis);
 
+        // ---------------------------------------------------------------------
+        //  Draw a unit cube for every transform of a store
+        //
+        //   The model-view matrices of the store must be up to date
+        //   (see TransformStore::updateModelViews).
+        // ---------------------------------------------------------------------
+        static void Render(GLSLProgram const & program,
+            glm::mat4 const & projection, TransformStore const & transforms);
+
+        // Add a draw per transform of the store to a render queue
+        static void Queue(RenderQueue & queue, GLSLProgram const & program,
+            TransformStore const & transforms);
+
+        // Same with the model matrices of the store (see
+        // TransformStore::updateModels) seen from a view : only reads the
+        // store, so that several threads can queue it with their own view
+        static void Queue(RenderQueue & queue, GLSLProgram const & program,
+            TransformStore const & transforms, glm::mat4 const & view);
+
     protected:
-        float m_vertices[108];
-        float m_colors[108];
-        GLuint m_vao;
-        GLuint m_vbo;
-        GLuint m_vboIndices;
-        glm::mat4 m_transform;    
+        // Rotations and translations, in the units of the world
+        glm::mat4 m_transform;
+
+        // Size of the unit cube, applied under m_transform at draw time
+        glm::mat4 m_scale;
 };
 
 }
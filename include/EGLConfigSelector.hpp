@@ -0,0 +1,78 @@
+#ifndef RPI_EGL_CONFIG_SELECTOR_HPP
+#define RPI_EGL_CONFIG_SELECTOR_HPP
+
+#include <string>
+#include <vector>
+
+#include <EGLHeaders.hpp>
+#include <EGLIntrospection.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Frame buffer a window asks for
+//
+//   The sizes are minimums : a config with more bits serves the request but
+//   costs memory bandwidth on every fragment, so the selector penalizes it.
+// -----------------------------------------------------------------------------
+struct EGLConfigRequest
+{
+    EGLint colorBits;   // Red + green + blue : 16 (565) or 24 (888)
+    EGLint alphaBits;
+    EGLint depthBits;
+    EGLint stencilBits;
+    EGLint samples;     // 0 : no multisampling
+
+    // 16-bit color and nothing else : maximum fill rate
+    static EGLConfigRequest FillRate();
+
+    // 24-bit color, 24-bit depth and 4x multisampling
+    static EGLConfigRequest Quality();
+
+    // "c16a0d0s0m0", key of the caches
+    std::string key() const;
+};
+
+// -----------------------------------------------------------------------------
+//  EGL config selection
+//
+//   eglChooseConfig sorts by its own rules (the largest color buffer first,
+//   EGL_DONT_CARE for the rest) : Select() instead scores every config of the
+//   display for the request and keeps the cheapest one.
+//
+//   The query of every attribute of every config is the slow part of the
+//   startup, so Choose() remembers the chosen config id per display and in a
+//   cache file keyed by the EGL vendor and version : the next runs ask
+//   eglChooseConfig for that id directly.
+// -----------------------------------------------------------------------------
+class EGLConfigSelector
+{
+    public:
+        // -1 if the config cannot serve the request (no window surface, no
+        // OpenGL ES 2, non conformant, missing bits), else its penalty :
+        // extra bits, extra samples and slow configs cost more
+        static int Score(EGLConfigInfo const & info, EGLConfigRequest const & request);
+
+        // Lowest penalty, then lowest config id. Returns false if no config
+        // serves the request
+        static bool Select(std::vector<EGLConfigInfo> const & configs,
+            EGLConfigRequest const & request, EGLConfigInfo & chosen);
+
+        // Cached config of the display, else Select() over all its configs.
+        // Returns false (and prints the reason on std::cerr) on failure
+        static bool Choose(EGLDisplay display, EGLConfigRequest const & request,
+            EGLConfigInfo & chosen);
+
+        // File of the startup cache ("" : in memory only)
+        static void SetCacheFile(std::string const & filename);
+
+        // Forgets the configs chosen in memory
+        static void ClearCache();
+
+    private:
+        static std::string s_cacheFile;
+};
+
+}
+
+#endif //RPI_EGL_CONFIG_SELECTOR_HPP
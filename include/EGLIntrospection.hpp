@@ -4,9 +4,36 @@
 #include <EGLHeaders.hpp>
 
 #include <string>
+#include <vector>
 
 namespace RPi {
 
+    // Attributes of an EGL frame buffer configuration
+    struct EGLConfigInfo
+    {
+        EGLConfig config;
+        EGLint id;
+        EGLint bufferSize;
+        EGLint red;
+        EGLint green;
+        EGLint blue;
+        EGLint alpha;
+        EGLint depth;
+        EGLint stencil;
+        EGLint sampleBuffers;
+        EGLint samples;
+        EGLint caveat;          // EGL_NONE, EGL_SLOW_CONFIG, ...
+        EGLint surfaceType;     // EGL_WINDOW_BIT, EGL_PBUFFER_BIT, ...
+        EGLint renderableType;  // EGL_OPENGL_ES2_BIT, ...
+        EGLint nativeRenderable;
+        EGLint nativeVisualId;
+        EGLint nativeVisualType;
+        EGLint maxPbufferWidth;
+        EGLint maxPbufferHeight;
+        EGLint maxPbufferPixels;
+        EGLint transparentType;
+    };
+
     class EGLIntrospection
     {
         public:
@@ -14,13 +41,24 @@ namespace RPi {
             static bool Initialize();
 
             static std::string GetVersion();
-            
+
             static EGLint GetMajorVersion();
 
             static EGLint GetMinorVersion();
 
+            // Every config of the default display, as text
             static std::string GetConfig();
 
+            // Every config of the default display
+            static std::vector<EGLConfigInfo> const & GetConfigs();
+
+            // Configs of an initialized display, without Initialize()
+            static std::vector<EGLConfigInfo> QueryConfigs(EGLDisplay display);
+            static EGLConfigInfo QueryConfig(EGLDisplay display, EGLConfig config);
+
+            // One line : "#<id> RGBA 5650 depth 16 stencil 0 samples 0 ..."
+            static std::string Describe(EGLConfigInfo const & info);
+
         private:
             static bool s_initialized;
     };
@@ -16,6 +16,7 @@ namespace Enums {
         AttributeIndex_Normal,
         AttributeIndex_Tangent,
         AttributeIndex_TexCoord,
+        AttributeIndex_Color,
         AttributeIndex_UserData0,
         AttributeIndex_UserData1,
         AttributeIndex_UserData2,
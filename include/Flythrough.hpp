@@ -0,0 +1,83 @@
+#ifndef RPI_FLYTHROUGH_HPP
+#define RPI_FLYTHROUGH_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <Recording.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Camera path interpolating keyframes with Catmull-Rom splines
+//
+//   Path file : one keyframe per line, '#' starting a comment
+//
+//      <time in s> <position x y z> <target x y z> [segment name]
+//
+//   A keyframe with a name starts a new segment of the path, which lasts
+//   until the next named keyframe. Keyframes must be sorted by time, the
+//   path starts at the time of the first one.
+// -----------------------------------------------------------------------------
+class CameraPath
+{
+    public:
+        CameraPath();
+
+        // returns false (and prints the reason on std::cerr) if the file is
+        // missing or malformed
+        bool load(std::string const & filename);
+
+        // Pose at the time t in [0, duration()] (clamped)
+        CameraPose pose(float t) const;
+
+        // Index of the segment containing the time t
+        std::size_t segment(float t) const;
+
+        std::vector<std::string> const & segments() const;
+
+        float duration() const;
+
+        // Time of every keyframe
+        std::vector<float> times() const;
+
+    private:
+        struct Keyframe
+        {
+            float time;
+            CameraPose pose;
+            std::size_t segment;
+        };
+
+        std::vector<Keyframe> m_keyframes;
+        std::vector<std::string> m_segments;
+};
+
+// -----------------------------------------------------------------------------
+//  Frame times grouped by segment of a path
+// -----------------------------------------------------------------------------
+class FrameTimeStats
+{
+    public:
+        FrameTimeStats(std::vector<std::string> const & segments);
+
+        // Make room for <frames> frames in every segment, so that add()
+        // does not allocate during the flight
+        void reserve(std::size_t frames);
+
+        // Frame time (in ms) of a frame of the segment
+        void add(std::size_t segment, float ms);
+
+        // Print count, mean, percentiles and worst frame of every segment
+        void report(std::ostream & out) const;
+
+    private:
+        std::vector<std::string> m_names;
+        std::vector<std::vector<float>> m_times;
+};
+
+}
+
+#endif //RPI_FLYTHROUGH_HPP
@@ -0,0 +1,112 @@
+#ifndef RPI_FRAME_CAPTURE_HPP
+#define RPI_FRAME_CAPTURE_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SpscQueue.hpp>
+
+namespace RPi {
+
+// Costs of the capture since start()
+struct CaptureStats
+{
+    CaptureStats();
+
+    std::size_t captured;   // frames read back
+    std::size_t written;    // files written by the writer thread
+    std::size_t dropped;    // frames skipped because both buffers were busy
+    double readbackMs;      // total glReadPixels time, on the render thread
+    float maxReadbackMs;
+    double encodeMs;        // total encode and write time, on the writer thread
+    std::uint64_t bytes;    // bytes written
+};
+
+// -----------------------------------------------------------------------------
+//  Frame capture to QOI files without stalling the render loop
+//
+//   Every <interval> frames, frame() reads the back buffer into one of two
+//   pixel buffers and hands it to a writer thread, which flips, encodes and
+//   writes it while the render thread reads the next capture into the other
+//   buffer. The render thread only pays for glReadPixels : OpenGL ES 2 has no
+//   pixel buffer objects, so the readback itself waits for the GPU. When the
+//   writer still holds both buffers, the frame is dropped rather than
+//   waited for.
+// -----------------------------------------------------------------------------
+class FrameCapture
+{
+    public:
+        FrameCapture();
+        ~FrameCapture();
+
+        FrameCapture(FrameCapture const &) = delete;
+        FrameCapture & operator=(FrameCapture const &) = delete;
+
+        // Capture every <interval> frames into <directory>/frame_<n>.qoi
+        void start(std::string const & directory, std::size_t interval);
+
+        // Waits for the pending files
+        void stop();
+
+        bool capturing() const;
+
+        // Call once per frame, after the draw calls and before the swap
+        void frame(int width, int height);
+
+        CaptureStats stats() const;
+        void report(std::ostream & out) const;
+
+    private:
+        struct Buffer
+        {
+            Buffer(): pixels(), width(0), height(0), frame(0), busy(false)
+            {
+
+            }
+
+            std::vector<std::uint8_t> pixels;
+            int width;
+            int height;
+            std::size_t frame;
+            std::atomic<bool> busy;
+        };
+
+        static std::size_t const BUFFERS = 2;
+
+        void write();
+
+        std::string m_directory;
+        std::size_t m_interval;
+        std::size_t m_frame;
+
+        std::array<Buffer, BUFFERS> m_buffers;
+        std::size_t m_next;
+
+        // Buffers handed to the writer, in capture order
+        SpscQueue<std::size_t, BUFFERS> m_pending;
+
+        std::thread m_writer;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        bool m_quit;
+
+        // Written by the render thread
+        CaptureStats m_stats;
+
+        // Written by the writer thread
+        std::atomic<std::size_t> m_written;
+        std::atomic<std::uint64_t> m_bytes;
+        std::atomic<std::uint64_t> m_encodeUs;
+};
+
+}
+
+#endif //RPI_FRAME_CAPTURE_HPP
@@ -1,7 +1,9 @@
 #ifndef RPI_GLSL_PROGRAM_HPP
 #define RPI_GLSL_PROGRAM_HPP
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -17,27 +19,60 @@ namespace RPi {
             GLSLProgram();
             ~GLSLProgram();
 
+            // glUseProgram, unless the program is already the current one :
+            // the send functions bind the program, and cost no call when it
+            // is bound. The app uses one context, the current program is
+            // tracked for all the programs.
             void bind() const;
 
             std::string const & getLog() const;
 
+            // Locations are cached after the first query of a name, until
+            // the program is linked again
             int getUniformLocation(std::string const & uniform) const;
+            int getUniformLocation(char const * uniform) const;
 
             bool isLinked() const;
 
             bool link();
 
-            bool loadShaderFromFile(Enums::ShaderType type, std::string const & filename);
-            bool loadShader(Enums::ShaderType type, std::string const & source);
+            // Shader permutations are selected with a list of names
+            // #defined before the source
+            bool loadShaderFromFile(Enums::ShaderType type, std::string const & filename,
+                std::vector<std::string> const & defines = {});
+            bool loadShader(Enums::ShaderType type, std::string const & source,
+                std::vector<std::string> const & defines = {});
 
             void sendFloat(std::string const & uniform, float f) const;
             void sendMatrix(std::string const & uniform, glm::mat4 const & matrix) const;
+            void sendVec3(std::string const & uniform, glm::vec3 const & v) const;
+
+            // <count> vec4 of a uniform array in one call
+            void sendVec4Array(std::string const & uniform, float const * values,
+                std::size_t count) const;
+
+            // Same without building a std::string from a literal
+            void sendFloat(char const * uniform, float f) const;
+            void sendMatrix(char const * uniform, glm::mat4 const & matrix) const;
+            void sendVec3(char const * uniform, glm::vec3 const & v) const;
+            void sendVec4Array(char const * uniform, float const * values,
+                std::size_t count) const;
             void unbind() const;
 
+            // glUseProgram calls issued by bind() and unbind() so far
+            static std::size_t BindCount();
+
         private:
+            struct UniformLocation
+            {
+                std::string name;
+                GLint location;
+            };
+
             GLint m_id;
             std::string m_log;
             bool m_linked;
+            mutable std::vector<UniformLocation> m_uniforms;
     };
 }
 
@@ -0,0 +1,124 @@
+#ifndef RPI_GL_TRACE_HPP
+#define RPI_GL_TRACE_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Traced entry points
+//
+//   The Makefile wraps every entry of this list when built with TRACE_GL=1
+//   (-Wl,--wrap=<name>) : keep one entry per line.
+// -----------------------------------------------------------------------------
+#define RPI_GL_TRACE_ENTRIES(X) \
+    X(glAttachShader) \
+    X(glBindAttribLocation) \
+    X(glBindBuffer) \
+    X(glBindFramebuffer) \
+    X(glBindRenderbuffer) \
+    X(glBindTexture) \
+    X(glBufferData) \
+    X(glBufferSubData) \
+    X(glCheckFramebufferStatus) \
+    X(glClear) \
+    X(glClearColor) \
+    X(glCompileShader) \
+    X(glCreateProgram) \
+    X(glCreateShader) \
+    X(glDeleteBuffers) \
+    X(glDeleteFramebuffers) \
+    X(glDeleteProgram) \
+    X(glDeleteRenderbuffers) \
+    X(glDeleteShader) \
+    X(glDeleteTextures) \
+    X(glDisable) \
+    X(glDisableVertexAttribArray) \
+    X(glDrawArrays) \
+    X(glDrawElements) \
+    X(glEnable) \
+    X(glEnableVertexAttribArray) \
+    X(glFinish) \
+    X(glFramebufferRenderbuffer) \
+    X(glFramebufferTexture2D) \
+    X(glGenBuffers) \
+    X(glGenFramebuffers) \
+    X(glGenRenderbuffers) \
+    X(glGenTextures) \
+    X(glGetShaderInfoLog) \
+    X(glGetShaderiv) \
+    X(glGetUniformLocation) \
+    X(glLinkProgram) \
+    X(glPixelStorei) \
+    X(glReadPixels) \
+    X(glRenderbufferStorage) \
+    X(glScissor) \
+    X(glShaderSource) \
+    X(glTexImage2D) \
+    X(glTexParameteri) \
+    X(glUniform1f) \
+    X(glUniform3fv) \
+    X(glUniform4fv) \
+    X(glUniformMatrix4fv) \
+    X(glUseProgram) \
+    X(glVertexAttribPointer) \
+    X(glViewport) \
+    X(eglSwapBuffers)
+
+#define RPI_GL_TRACE_ENUM(name) name,
+
+enum class GLEntry : std::uint16_t
+{
+    RPI_GL_TRACE_ENTRIES(RPI_GL_TRACE_ENUM)
+    Count
+};
+
+#undef RPI_GL_TRACE_ENUM
+
+// -----------------------------------------------------------------------------
+//  GL call trace
+//
+//   Built with RPI_TRACE_GL (make TRACE_GL=1), the traced entry points record
+//   every call of the render thread into a binary trace :
+//
+//      header : "RPGL", version (u32), number of entries (u32), then the
+//               name of every entry (u8 length, characters)
+//      call   : entry (u16), number of arguments (u8), 0 (u8),
+//               payload size (u32), duration in ns (u32),
+//               arguments (u32 each), payload
+//
+//   The header and every call are padded with zeros to 4 bytes.
+//
+//   The arguments are the scalars of the call in order, floats as their
+//   bits and pointers into buffers as their offset, then the returned value
+//   if any. The payload holds the data the call reads (buffer contents,
+//   uniform values, shader sources, names) or the names it generates.
+//   tools/GLReplay.cpp reissues a trace and reports the cost of every entry
+//   point. Without the flag, Start() fails and nothing is recorded.
+// -----------------------------------------------------------------------------
+namespace GLTrace {
+
+    std::uint32_t const VERSION = 1;
+
+    char const * EntryName(GLEntry entry);
+
+    bool Enabled();
+
+    // Returns false (and prints the reason on std::cerr) if the file cannot
+    // be written or the build does not trace
+    bool Start(std::string const & filename);
+
+    // Writes the buffered calls and closes the trace
+    void Stop();
+
+    bool Recording();
+
+    // Calls and bytes recorded since Start()
+    std::uint64_t Calls();
+    std::uint64_t Bytes();
+}
+
+}
+
+#endif //RPI_GL_TRACE_HPP
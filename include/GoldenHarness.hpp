@@ -0,0 +1,114 @@
+#ifndef RPI_GOLDEN_HARNESS_HPP
+#define RPI_GOLDEN_HARNESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <MultiView.hpp>
+#include <Recording.hpp>
+
+namespace RPi {
+
+// Perceptual difference between two images of the same size
+struct ImageDiff
+{
+    std::size_t pixels;
+    std::size_t different;  // pixels whose difference exceeds the threshold
+    float maxDelta;         // in [0, 1]
+    double meanDelta;
+};
+
+// -----------------------------------------------------------------------------
+//  Compare two RGBA images with the YIQ color difference of pixelmatch
+//  (Kotsarenko and Ramos, "Measuring perceived color difference using YIQ
+//  NTSC transmission color space"), normalized to [0, 1]. A pixel differs
+//  when its difference exceeds <threshold> : 0.1 ignores the rounding of
+//  quantized vertices or of a faster noise, not a missing cube.
+//
+//   - diff : if not null, receives an image of the differing pixels in red
+//            over the faded expected image
+// -----------------------------------------------------------------------------
+ImageDiff CompareImages(std::uint8_t const * expected, std::uint8_t const * actual,
+    int width, int height, float threshold, std::vector<std::uint8_t> * diff = nullptr);
+
+// Result of a pose
+struct GoldenResult
+{
+    GoldenResult();
+
+    std::string name;
+    float cpuMs;        // mean CPU time of a frame : queues and GL calls
+    float frameMs;      // mean time until glFinish returned
+    ImageDiff diff;
+    bool passed;
+    bool skipped;       // no golden image yet : not compared, not failed
+};
+
+// -----------------------------------------------------------------------------
+//  Golden-image regression harness
+//
+//   Renders the keyframes of a camera path (see CameraPath) into an
+//   offscreen target of fixed size, times the frames, and compares them
+//   with the images of a golden directory :
+//
+//      <directory>/poses.path        the poses, one keyframe each
+//      <directory>/<pose>.qoi        the golden image of a pose
+//      <directory>/<pose>.new.qoi    written when a pose fails or has no
+//                                    golden image (the pose is skipped)
+//      <directory>/<pose>.diff.qoi   its differing pixels
+//      <directory>/results.csv       one line per pose and run
+//
+//   An optimization is validated for speed and visual equivalence in one
+//   run : the CSV line of each pose holds its frame cost and difference.
+// -----------------------------------------------------------------------------
+class GoldenHarness
+{
+    public:
+        // Render the given pose into the target bound by the harness
+        using RenderFunc = std::function<void(CameraPose const & pose)>;
+
+        GoldenHarness(std::string const & directory, int width, int height);
+
+        // The image must differ in more than <maxDifferent> of its pixels
+        // (a ratio) to fail
+        void tolerance(float threshold, float maxDifferent);
+
+        // Frames timed per pose, after one warm-up frame
+        void repetitions(std::size_t frames);
+
+        // The offscreen target : the render function draws into it
+        RenderTarget const & target() const;
+
+        // ---------------------------------------------------------------------
+        //  Render and check every pose
+        //
+        //   - update : write the renders as the new goldens instead of
+        //              comparing them
+        //   - label  : first column of the CSV lines, naming the build
+        //
+        //   Returns false if a pose failed or the harness could not run. A
+        //   pose without a golden image is skipped, it does not fail.
+        // ---------------------------------------------------------------------
+        bool run(RenderFunc const & render, bool update, std::string const & label);
+
+        std::vector<GoldenResult> const & results() const;
+        void report(std::ostream & out) const;
+
+    private:
+        bool append(std::string const & label) const;
+
+        std::string m_directory;
+        RenderTarget m_target;
+        float m_threshold;
+        float m_maxDifferent;
+        std::size_t m_repetitions;
+        std::vector<GoldenResult> m_results;
+};
+
+}
+
+#endif //RPI_GOLDEN_HARNESS_HPP
@@ -0,0 +1,109 @@
+#ifndef RPI_HEIGHTFIELD_HPP
+#define RPI_HEIGHTFIELD_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Regular grid of heights
+//
+//   Sample (x, z) lies at the world position (x * spacing, h, z * spacing).
+//   Heights are stored row by row (z major) so that a row is contiguous.
+//
+//   The surface between four samples is the bilinear interpolation of their
+//   heights. Ray queries walk a min/max pyramid built over the cells, so
+//   updatePyramid() must be called once the heights are written.
+// -----------------------------------------------------------------------------
+class Heightfield
+{
+    using Size = std::size_t;
+
+    public:
+        Heightfield(Size width, Size depth, float spacing);
+
+        Size width() const;
+        Size depth() const;
+        float spacing() const;
+
+        float & at(Size x, Size z);
+        float at(Size x, Size z) const;
+
+        float * row(Size z);
+        float const * row(Size z) const;
+
+        float minHeight() const;
+        float maxHeight() const;
+
+        // ---------------------------------------------------------------------
+        //  Compute the normals of a row by central differences
+        //
+        //   - z          : index of the row
+        //   - nx, ny, nz : components of the unit normals (width() floats each)
+        //
+        //   One-sided differences are used on the borders of the grid.
+        // ---------------------------------------------------------------------
+        void normalRow(Size z, float * nx, float * ny, float * nz) const;
+
+        // Rebuild the min/max pyramid from the heights
+        void updatePyramid();
+
+        // Height of the surface at the world position (x, z), clamped on
+        // the borders of the grid
+        float heightAt(float x, float z) const;
+
+        // Unit normal of the surface at the world position (x, z)
+        glm::vec3 normalAt(float x, float z) const;
+
+        // ---------------------------------------------------------------------
+        //  Find the first intersection of a segment with the surface
+        //
+        //   - from, to : extremities of the segment
+        //   - hit      : first point of the segment on the surface
+        //
+        //   returns true if the segment, going from above the surface,
+        //   crosses it
+        // ---------------------------------------------------------------------
+        bool intersect(glm::vec3 const & from, glm::vec3 const & to,
+            glm::vec3 & hit) const;
+
+        // Same as intersect for the ray origin + t * direction, t in [0, tMax]
+        bool raycast(glm::vec3 const & origin, glm::vec3 const & direction,
+            float tMax, float & t) const;
+
+    private:
+        struct Bounds
+        {
+            float min;
+            float max;
+        };
+
+        // Level k of the pyramid : each node bounds 2^k x 2^k cells
+        struct Level
+        {
+            Size width;
+            Size depth;
+            std::vector<Bounds> bounds;
+        };
+
+        struct Ray;
+
+        bool visit(Ray const & ray, Size level, Size x, Size z,
+            float tMin, float tMax, float & t) const;
+
+        bool intersectCell(Ray const & ray, Size x, Size z,
+            float tMin, float tMax, float & t) const;
+
+        Size m_width;
+        Size m_depth;
+        float m_spacing;
+        std::vector<float> m_heights;
+        std::vector<Level> m_pyramid;
+};
+
+}
+
+#endif //RPI_HEIGHTFIELD_HPP
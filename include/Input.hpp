@@ -2,19 +2,70 @@
 #define RPI_INPUT_HPP
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 #include <SDL/SDL.h>
 
 //cf http://stackoverflow.com/questions/3741055/inputs-in-sdl-on-key-pressed
 
 namespace RPi {
-    
+
+// -----------------------------------------------------------------------------
+//  SDL event reduced to what the app reads, stamped when it was collected
+// -----------------------------------------------------------------------------
+struct InputEvent
+{
+    enum Type : std::uint8_t
+    {
+        KeyDown,
+        KeyUp,
+        ButtonDown,
+        ButtonUp,
+        Motion
+    };
+
+    std::uint64_t time; // Input::Now()
+    Type type;
+    std::uint8_t button;
+    std::uint16_t key;
+    std::int16_t x;
+    std::int16_t y;
+    std::int16_t xRel;
+    std::int16_t yRel;
+};
+
+// -----------------------------------------------------------------------------
+//  Keyboard and mouse state of a frame
+//
+//   The SDL events are collected by an event filter into a lock-free queue.
+//   When SDL runs its event thread (SDL_INIT_EVENTTHREAD, see Window) the
+//   filter runs there, as soon as the events arrive, and a burst of events
+//   no longer delays the frame. Otherwise updateEvents() pumps the events
+//   itself. updateEvents() then applies the queued events to the state of
+//   the frame.
+// -----------------------------------------------------------------------------
 class Input
 {
     using SDLKey = decltype(SDL_Event::key.keysym.sym);
 
     public:
 
+    // Input of a frame
+    struct State
+    {
+        State();
+
+        std::array<bool, 322> keys;
+        std::array<bool, 8> mouseBtns;
+
+        int x;
+        int y;
+        int xRel;
+        int yRel;
+        float wheel;
+    };
+
     Input();
     ~Input();
 
@@ -33,17 +84,35 @@ class Input
 
     float getMouseWheel() const;
 
+    // Current state, and replacement of the SDL events by a recorded state
+    State const & state() const;
+    void state(State const & state);
+
+    // Events applied by the last updateEvents() and the times of the oldest
+    // and newest ones (0 without events)
+    std::size_t events() const;
+    std::uint64_t oldestEventTime() const;
+    std::uint64_t newestEventTime() const;
+
+    // Microseconds on the steady clock
+    static std::uint64_t Now();
+
+    // Events lost because the queue was full
+    static std::size_t DroppedEvents();
+
+    // Queue a synthetic event, applied with the SDL events by the next
+    // updateEvents(). Synthetic events have a queue of their own : only one
+    // thread may inject them.
+    static bool Inject(InputEvent const & event);
+
     private:
 
-    SDL_Event m_events;
-    std::array<bool, 322> m_keys;
-    std::array<bool, 8> m_mouseBtns;
+    void apply(InputEvent const & event);
 
-    int m_x;
-    int m_y;
-    int m_xRel;
-    int m_yRel;
-    float m_wheel;
+    State m_state;
+    std::size_t m_events;
+    std::uint64_t m_oldestEvent;
+    std::uint64_t m_newestEvent;
 };
 
 }
@@ -0,0 +1,63 @@
+#ifndef RPI_LATENCY_PROBE_HPP
+#define RPI_LATENCY_PROBE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Input-to-present latency
+//
+//   Input stamps its events when they are collected (see InputEvent). The
+//   frame whose camera consumed them reports the oldest stamp with
+//   consumed(), then presented() once eglSwapBuffers returned : the
+//   difference is one latency sample. The display scan-out that follows
+//   the swap is not measured.
+//
+//   inject() replaces the user by a thread pressing and releasing the arrow
+//   keys at a fixed period, so that the probe also runs unattended.
+// -----------------------------------------------------------------------------
+class LatencyProbe
+{
+    public:
+        LatencyProbe();
+        ~LatencyProbe();
+
+        LatencyProbe(LatencyProbe const &) = delete;
+        LatencyProbe & operator=(LatencyProbe const &) = delete;
+
+        // Inject a key event every <period> ms until the probe is destroyed
+        void inject(float period);
+
+        // The frame consumed input stamped at <eventTime> (Input::Now)
+        void consumed(std::uint64_t eventTime);
+
+        // The frame was handed to the display
+        void presented();
+
+        std::size_t samples() const;
+
+        // Print count, mean, percentiles and worst latency in ms
+        void report(std::ostream & out, std::string const & label) const;
+
+        // Append the same line to a CSV file, which gathers the runs of
+        // several scheduler policies
+        bool append(std::string const & filename, std::string const & label) const;
+
+    private:
+        void stop();
+
+        std::vector<float> m_latencies;
+        std::uint64_t m_pending;
+        std::thread m_injector;
+        std::atomic<bool> m_injecting;
+};
+
+}
+
+#endif //RPI_LATENCY_PROBE_HPP
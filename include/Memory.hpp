@@ -0,0 +1,212 @@
+#ifndef RPI_MEMORY_HPP
+#define RPI_MEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace RPi {
+
+namespace Memory {
+
+    // -------------------------------------------------------------------------
+    //  Heap allocation counters
+    //
+    //   Memory.cpp replaces the global operator new and delete to count the
+    //   allocations of every thread. Memory allocated by C libraries with
+    //   malloc (SDL, SDL_ttf, the GL driver) is not counted.
+    // -------------------------------------------------------------------------
+    std::size_t Allocations();
+    std::size_t Deallocations();
+
+    // Subsystems the heap usage is accounted to
+    enum class Tag
+    {
+        General,
+        Terrain,
+        Shaders,
+        Input,
+        Fonts,
+        Scene,
+        Recording,
+        Count
+    };
+
+    char const * TagName(Tag tag);
+
+    // Heap usage of a tag
+    struct TagStats
+    {
+        std::size_t liveBytes;
+        std::size_t peakBytes;
+        std::size_t allocations;
+        std::size_t deallocations;
+    };
+
+    // -------------------------------------------------------------------------
+    //  Tagged heap tracking
+    //
+    //   Built with RPI_MEMORY_TRACKING (make MEMORY_TRACKING=1), operator new
+    //   prefixes every block with its size and the tag of the calling thread,
+    //   and the bytes are accounted to that tag until the block is deleted,
+    //   whichever thread deletes it. The tag of a thread is set by TagScope
+    //   objects, which nest. Without the flag the tags cost nothing and only
+    //   the counters above are kept.
+    // -------------------------------------------------------------------------
+    bool TrackingEnabled();
+
+    TagStats Stats(Tag tag);
+
+    // Print the usage of every tag
+    void Report(std::ostream & out);
+
+    // Tag of the allocations of the calling thread
+    Tag CurrentTag();
+
+    // -------------------------------------------------------------------------
+    //  Account the allocations of the calling thread to a tag while in scope
+    // -------------------------------------------------------------------------
+    class TagScope
+    {
+        public:
+#ifdef RPI_MEMORY_TRACKING
+            TagScope(Tag tag);
+            ~TagScope();
+#else
+            TagScope(Tag) {}
+#endif
+
+            TagScope(TagScope const &) = delete;
+            TagScope & operator=(TagScope const &) = delete;
+
+#ifdef RPI_MEMORY_TRACKING
+        private:
+            Tag m_previous;
+#endif
+    };
+
+    // -------------------------------------------------------------------------
+    //  Linear allocator for the transient data of a frame
+    //
+    //   Allocating moves a pointer forward, reset() releases everything at
+    //   once : nothing is destroyed, so only trivially destructible objects
+    //   can be made in the arena.
+    //
+    //   When the buffer is full the allocations go to heap blocks, kept until
+    //   the next reset which then grows the buffer to the peak usage : after a
+    //   few frames the arena never touches the heap again.
+    // -------------------------------------------------------------------------
+    class FrameArena
+    {
+        public:
+            FrameArena(std::size_t capacity);
+            ~FrameArena();
+
+            FrameArena(FrameArena const &) = delete;
+            FrameArena & operator=(FrameArena const &) = delete;
+
+            void * allocate(std::size_t size,
+                std::size_t alignment = alignof(std::max_align_t));
+
+            template <typename T, typename... Args>
+            T * make(Args &&... args);
+
+            // Uninitialized array of n T
+            template <typename T>
+            T * array(std::size_t n);
+
+            // printf into the arena, the string lives until the next reset
+            char const * format(char const * fmt, ...)
+                __attribute__((format(printf, 2, 3)));
+
+            // Release the allocations of the frame
+            void reset();
+
+            std::size_t used() const;
+            std::size_t capacity() const;
+
+            // Most bytes used between two resets
+            std::size_t peak() const;
+
+            // Heap blocks allocated because the buffer was full
+            std::size_t overflows() const;
+
+        private:
+            void grow(std::size_t capacity);
+
+            char * m_buffer;
+            std::size_t m_capacity;
+            std::size_t m_used;
+            std::size_t m_overflowBytes;
+            std::size_t m_peak;
+            std::size_t m_overflows;
+            std::vector<void *> m_blocks;
+    };
+
+    template <typename T, typename... Args>
+    T * FrameArena::make(Args &&... args)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+            "The arena does not call destructors");
+
+        return new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T * FrameArena::array(std::size_t n)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+            "The arena does not call destructors");
+
+        return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // -------------------------------------------------------------------------
+    //  Standard allocator on a FrameArena, for containers of a frame
+    //
+    //   Deallocating does nothing : the memory comes back with the reset.
+    // -------------------------------------------------------------------------
+    template <typename T>
+    class ArenaAllocator
+    {
+        public:
+            using value_type = T;
+
+            ArenaAllocator(FrameArena & arena): m_arena(&arena) {}
+
+            template <typename U>
+            ArenaAllocator(ArenaAllocator<U> const & other): m_arena(other.arena()) {}
+
+            T * allocate(std::size_t n)
+            {
+                return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T *, std::size_t) {}
+
+            FrameArena * arena() const { return m_arena; }
+
+        private:
+            FrameArena * m_arena;
+    };
+
+    template <typename T, typename U>
+    bool operator==(ArenaAllocator<T> const & a, ArenaAllocator<U> const & b)
+    {
+        return a.arena() == b.arena();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(ArenaAllocator<T> const & a, ArenaAllocator<U> const & b)
+    {
+        return !(a == b);
+    }
+}
+
+}
+
+#endif //RPI_MEMORY_HPP
@@ -0,0 +1,156 @@
+#ifndef RPI_MULTI_VIEW_HPP
+#define RPI_MULTI_VIEW_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <EGLHeaders.hpp>
+#include <RenderQueue.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Offscreen framebuffer : RGBA color texture and 16-bit depth buffer
+// -----------------------------------------------------------------------------
+class RenderTarget
+{
+    public:
+        RenderTarget();
+        ~RenderTarget();
+
+        RenderTarget(RenderTarget const &) = delete;
+        RenderTarget & operator=(RenderTarget const &) = delete;
+
+        // Returns false (and prints the reason on std::cerr) if the
+        // framebuffer is incomplete
+        bool create(int width, int height);
+        void destroy();
+
+        bool valid() const;
+
+        GLuint framebuffer() const;
+        GLuint texture() const;
+        int width() const;
+        int height() const;
+
+    private:
+        GLuint m_framebuffer;
+        GLuint m_texture;
+        GLuint m_depth;
+        int m_width;
+        int m_height;
+};
+
+// Rectangle of a target in pixels, from the bottom left corner
+struct Viewport
+{
+    GLint x;
+    GLint y;
+    GLsizei width;
+    GLsizei height;
+};
+
+// -----------------------------------------------------------------------------
+//  One view of the frame : where it is drawn and the job filling its queue
+// -----------------------------------------------------------------------------
+struct View
+{
+    View();
+
+    // The target is not owned
+    View(View const &) = default;
+    View(View &&) = default;
+
+    View & operator=(View const &) = default;
+    View & operator=(View &&) = default;
+
+    std::string name;
+
+    // nullptr : the window
+    RenderTarget const * target;
+    Viewport viewport;
+
+    glm::mat4 projection;
+    glm::vec4 clearColor;
+
+    // Thread running the job : 0 is the render thread, 1 to n the worker
+    // threads of the renderer. A view always runs on the same thread.
+    std::size_t thread;
+
+    // Fills the queue of the view. The jobs of the worker threads run at the
+    // same time : a job must not call GL nor write data that another view
+    // reads. Views without a job are filled through queue() before render().
+    std::function<void(RenderQueue & queue)> job;
+};
+
+// Costs of a view in the last frame
+struct ViewStats
+{
+    ViewStats();
+
+    float jobMs;    // running the job, on its thread
+    float submitMs; // CPU time of the GL calls, on the render thread
+    std::size_t draws;
+};
+
+// -----------------------------------------------------------------------------
+//  Renders several views per frame with the one GL context
+//
+//   render() first runs the jobs : the worker threads run their views while
+//   the render thread runs its own. Then the render thread clears and
+//   submits every view in order. Comparing views in one process replaces
+//   comparing processes (see launch.sh), without the context switches
+//   between two GL contexts.
+// -----------------------------------------------------------------------------
+class MultiViewRenderer
+{
+    public:
+        MultiViewRenderer(float farDepth = 100.f);
+        ~MultiViewRenderer();
+
+        MultiViewRenderer(MultiViewRenderer const &) = delete;
+        MultiViewRenderer & operator=(MultiViewRenderer const &) = delete;
+
+        // Starts the worker thread of the view if needed
+        std::size_t add(View const & view);
+
+        View & view(std::size_t i);
+        std::size_t size() const;
+
+        RenderQueue & queue(std::size_t i);
+
+        // The queues are cleared after the submission. Leaves the window
+        // bound with the viewport of its first view.
+        void render();
+
+        ViewStats const & stats(std::size_t i) const;
+
+    private:
+        void runJobs(std::size_t thread);
+        void work(std::size_t thread, std::size_t frame);
+
+        float m_farDepth;
+        std::vector<View> m_views;
+        std::vector<std::unique_ptr<RenderQueue>> m_queues;
+        std::vector<ViewStats> m_stats;
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_finish;
+        std::size_t m_frame;
+        std::size_t m_running;
+        bool m_quit;
+};
+
+}
+
+#endif //RPI_MULTI_VIEW_HPP
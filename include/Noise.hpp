@@ -0,0 +1,179 @@
+#ifndef RPI_NOISE_HPP
+#define RPI_NOISE_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace RPi {
+
+// Basis function of the fractal compositions
+enum class NoiseBasis
+{
+    Perlin,
+    Simplex
+};
+
+// -----------------------------------------------------------------------------
+//  Parameters of a fractal sum of octaves
+//
+//   octave i is sampled at frequency * lacunarity^i and weighted by
+//   amplitude * gain^i
+// -----------------------------------------------------------------------------
+template <typename T>
+struct Fractal
+{
+    Fractal(int octaves = 4, T frequency = T(1), T amplitude = T(1),
+        T lacunarity = T(2), T gain = T(0.5)):
+        octaves(octaves), frequency(frequency), amplitude(amplitude),
+        lacunarity(lacunarity), gain(gain)
+    {
+
+    }
+
+    int octaves;
+    T frequency;
+    T amplitude;
+    T lacunarity;
+    T gain;
+};
+
+// -----------------------------------------------------------------------------
+//  Integer position on the lattice of the noise
+//
+//   Used as the origin of a chunk and as the period of a tileable noise
+//   (0 meaning not periodic along the axis).
+// -----------------------------------------------------------------------------
+struct Lattice
+{
+    Lattice(std::int64_t x = 0, std::int64_t y = 0, std::int64_t z = 0):
+        x(x), y(y), z(z)
+    {
+
+    }
+
+    std::int64_t x;
+    std::int64_t y;
+    std::int64_t z;
+};
+
+// -----------------------------------------------------------------------------
+//  Hash of a lattice point (splitmix64 finalizer), depends only on the seed
+//  and the point
+//
+//   Inline for the kernels hashing many points per sample (NoiseKernels.hpp).
+//   Unsigned arithmetic only : wraps instead of overflowing.
+// -----------------------------------------------------------------------------
+inline std::uint64_t LatticeMix(std::uint64_t h)
+{
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+inline std::uint64_t LatticeHash(std::uint64_t seed, std::int64_t x, std::int64_t y)
+{
+    auto h = LatticeMix(seed ^ static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull);
+    return LatticeMix(h ^ static_cast<std::uint64_t>(y) * 0xC2B2AE3D27D4EB4Full);
+}
+
+// -----------------------------------------------------------------------------
+//  Gradient noise (Perlin's improved noise and Simplex noise) in 2D and 3D
+//
+//   The lattice is hashed through a permutation table shuffled from a seed, so
+//   two Noise objects built with the same seed return the same values.
+//   Every basis returns values in about [-1, 1].
+//
+//   The table repeats every 256 cells and the cells are 32-bit integers. The
+//   lattice functions hash 64-bit cells instead, so they neither repeat nor
+//   overflow, and can be made periodic. They take a position relative to a
+//   Lattice origin : chunks generated independently (other thread, other
+//   machine) compute the same values on their shared border as long as the
+//   local positions of the border are exact and the frequencies are powers
+//   of two.
+//
+//   Instantiated for float and double.
+// -----------------------------------------------------------------------------
+template <typename T>
+class Noise
+{
+    public:
+        Noise(std::uint32_t seed = 0);
+
+        void seed(std::uint32_t seed);
+        std::uint32_t seed() const;
+
+        T perlin(T x, T y) const;
+        T perlin(T x, T y, T z) const;
+
+        T simplex(T x, T y) const;
+        T simplex(T x, T y, T z) const;
+
+        T sample(NoiseBasis basis, T x, T y) const;
+        T sample(NoiseBasis basis, T x, T y, T z) const;
+
+        // Sum of octaves
+        T fbm(NoiseBasis basis, Fractal<T> const & f, T x, T y) const;
+        T fbm(NoiseBasis basis, Fractal<T> const & f, T x, T y, T z) const;
+
+        // Sum of octaves of 1 - |noise|, sharp crests in [0, amplitude]
+        T ridged(NoiseBasis basis, Fractal<T> const & f, T x, T y) const;
+        T ridged(NoiseBasis basis, Fractal<T> const & f, T x, T y, T z) const;
+
+        // Sum of octaves of |noise|
+        T turbulence(NoiseBasis basis, Fractal<T> const & f, T x, T y) const;
+        T turbulence(NoiseBasis basis, Fractal<T> const & f, T x, T y, T z) const;
+
+        // Hash of a lattice point, depends only on the seed and the point
+        static std::uint64_t Hash(std::uint64_t seed, std::int64_t x, std::int64_t y);
+        static std::uint64_t Hash(std::uint64_t seed, std::int64_t x, std::int64_t y,
+            std::int64_t z);
+
+        // ---------------------------------------------------------------------
+        //  Perlin noise at origin + (x, y, z), repeating every period cells
+        // ---------------------------------------------------------------------
+        T perlin(Lattice const & origin, T x, T y,
+            Lattice const & period = Lattice()) const;
+        T perlin(Lattice const & origin, T x, T y, T z,
+            Lattice const & period = Lattice()) const;
+
+        // ---------------------------------------------------------------------
+        //  Sum of octaves of lattice Perlin noise
+        //
+        //   The period is given at frequency 1 : period * frequency of every
+        //   octave must be an integer for the sum to stay periodic.
+        // ---------------------------------------------------------------------
+        T fbm(Fractal<T> const & f, Lattice const & origin, T x, T y,
+            Lattice const & period = Lattice()) const;
+        T fbm(Fractal<T> const & f, Lattice const & origin, T x, T y, T z,
+            Lattice const & period = Lattice()) const;
+
+        // ---------------------------------------------------------------------
+        //  Domain warping : fBm sampled at p + strength * d(p), d being made
+        //  of two (three) other fBm fields
+        // ---------------------------------------------------------------------
+        T warp(Fractal<T> const & f, T strength, Lattice const & origin,
+            T x, T y, Lattice const & period = Lattice()) const;
+        T warp(Fractal<T> const & f, T strength, Lattice const & origin,
+            T x, T y, T z, Lattice const & period = Lattice()) const;
+
+    private:
+        std::uint32_t m_seed;
+
+        // Seed of the lattice hash
+        std::uint64_t m_hashSeed;
+
+        // Permutation of [0, 255] repeated twice to avoid wrapping indices
+        std::array<std::uint8_t, 512> m_perm;
+
+        // m_perm modulo 12 : index of the simplex gradients
+        std::array<std::uint8_t, 512> m_permMod12;
+};
+
+extern template class Noise<float>;
+extern template class Noise<double>;
+
+}
+
+#endif //RPI_NOISE_HPP
@@ -0,0 +1,292 @@
+#ifndef RPI_NOISE_KERNELS_HPP
+#define RPI_NOISE_KERNELS_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <ratio>
+
+#include <Noise.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Q15.16 fixed point number
+//
+//   For the cores without a fast FPU : the noise kernels only add, multiply
+//   and floor, all integer operations here. The values must stay within
+//   +/-32768, i.e. the coordinates times the frequency of the last octave.
+// -----------------------------------------------------------------------------
+struct Fixed16
+{
+    struct RawTag {};
+
+    Fixed16(): raw(0)
+    {
+
+    }
+
+    constexpr explicit Fixed16(double value):
+        raw(static_cast<std::int32_t>(value * 65536.0 + (value < 0.0 ? -0.5 : 0.5)))
+    {
+
+    }
+
+    constexpr Fixed16(std::int32_t raw, RawTag): raw(raw)
+    {
+
+    }
+
+    explicit operator double() const
+    {
+        return raw * (1.0 / 65536.0);
+    }
+
+    std::int32_t raw;
+};
+
+inline Fixed16 operator+(Fixed16 a, Fixed16 b)
+{
+    return Fixed16(a.raw + b.raw, Fixed16::RawTag());
+}
+
+inline Fixed16 operator-(Fixed16 a, Fixed16 b)
+{
+    return Fixed16(a.raw - b.raw, Fixed16::RawTag());
+}
+
+inline Fixed16 operator*(Fixed16 a, Fixed16 b)
+{
+    return Fixed16(static_cast<std::int32_t>(
+        (static_cast<std::int64_t>(a.raw) * b.raw) >> 16), Fixed16::RawTag());
+}
+
+// -----------------------------------------------------------------------------
+//  Operations of the kernels on a scalar type
+// -----------------------------------------------------------------------------
+template <typename T>
+struct NoiseArithmetic
+{
+    static constexpr T From(double value)
+    {
+        return static_cast<T>(value);
+    }
+
+    static double To(T value)
+    {
+        return static_cast<double>(value);
+    }
+
+    // Cell of x, and x minus the cell in <fraction>
+    static std::int64_t Floor(T x, T & fraction)
+    {
+        auto const cell = std::floor(x);
+        fraction = x - cell;
+        return static_cast<std::int64_t>(cell);
+    }
+
+    // Value of a lattice point in [-1, 1), as PerlinNoise
+    static T Value(std::uint64_t hash)
+    {
+        return T(1) - static_cast<T>(hash >> 33) * T(0.931322574615478515625e-9);
+    }
+};
+
+template <>
+struct NoiseArithmetic<Fixed16>
+{
+    static constexpr Fixed16 From(double value)
+    {
+        return Fixed16(value);
+    }
+
+    static double To(Fixed16 value)
+    {
+        return static_cast<double>(value);
+    }
+
+    static std::int64_t Floor(Fixed16 x, Fixed16 & fraction)
+    {
+        fraction = Fixed16(x.raw & 0xFFFF, Fixed16::RawTag());
+        return x.raw >> 16;
+    }
+
+    // The 16 bits below 1 of the hash, minus 1
+    static Fixed16 Value(std::uint64_t hash)
+    {
+        return Fixed16(65536 - static_cast<std::int32_t>(hash >> 47), Fixed16::RawTag());
+    }
+};
+
+// -----------------------------------------------------------------------------
+//  Interpolation kernels : weight of the second value at fraction a
+// -----------------------------------------------------------------------------
+struct LinearKernel
+{
+    template <typename T>
+    static T Weight(T a)
+    {
+        return a;
+    }
+};
+
+// 3a^2 - 2a^3, the kernel of PerlinNoise
+struct CubicKernel
+{
+    template <typename T>
+    static T Weight(T a)
+    {
+        using A = NoiseArithmetic<T>;
+        return a * a * (A::From(3.0) - A::From(2.0) * a);
+    }
+};
+
+// 6a^5 - 15a^4 + 10a^3, continuous second derivative
+struct QuinticKernel
+{
+    template <typename T>
+    static T Weight(T a)
+    {
+        using A = NoiseArithmetic<T>;
+        return a * a * a * (a * (a * A::From(6.0) - A::From(15.0)) + A::From(10.0));
+    }
+};
+
+namespace NoiseKernels {
+
+    constexpr double Power(double base, int exponent)
+    {
+        return exponent == 0 ? 1.0 : base * Power(base, exponent - 1);
+    }
+
+    // -------------------------------------------------------------------------
+    //  Smoothed value noise of PerlinNoise::GetValue : the values of the 4
+    //  corners of the cell are blurred with their 8 neighbors, then
+    //  interpolated with the kernel
+    // -------------------------------------------------------------------------
+    template <typename T, typename Kernel>
+    inline T SmoothValue(std::uint64_t seed, T x, T y)
+    {
+        using A = NoiseArithmetic<T>;
+
+        T fx, fy;
+        auto const cx = A::Floor(x, fx);
+        auto const cy = A::Floor(y, fy);
+
+        auto const n = [&](std::int64_t dx, std::int64_t dy)
+        {
+            return A::Value(LatticeHash(seed, cx + dx, cy + dy));
+        };
+
+        auto const n01 = n(-1, -1), n02 = n(1, -1), n03 = n(-1, 1), n04 = n(1, 1);
+        auto const n05 = n(-1, 0), n06 = n(1, 0), n07 = n(0, -1), n08 = n(0, 1);
+        auto const n09 = n(0, 0);
+        auto const n12 = n(2, -1), n14 = n(2, 1), n16 = n(2, 0);
+        auto const n23 = n(-1, 2), n24 = n(1, 2), n28 = n(0, 2);
+        auto const n34 = n(2, 2);
+
+        auto const corner = A::From(0.0625);
+        auto const side = A::From(0.125);
+        auto const center = A::From(0.25);
+
+        auto const x0y0 = corner * (n01 + n02 + n03 + n04) + side * (n05 + n06 + n07 + n08) + center * n09;
+        auto const x1y0 = corner * (n07 + n12 + n08 + n14) + side * (n09 + n16 + n02 + n04) + center * n06;
+        auto const x0y1 = corner * (n05 + n06 + n23 + n24) + side * (n03 + n04 + n09 + n28) + center * n08;
+        auto const x1y1 = corner * (n09 + n16 + n28 + n34) + side * (n08 + n14 + n06 + n24) + center * n04;
+
+        auto const u = Kernel::Weight(fx);
+        auto const v = Kernel::Weight(fy);
+
+        auto const v1 = x0y0 + (x1y0 - x0y0) * u;
+        auto const v2 = x0y1 + (x1y1 - x0y1) * u;
+
+        return v1 + (v2 - v1) * v;
+    }
+
+    // -------------------------------------------------------------------------
+    //  Octaves K to N - 1 added to <sum>, unrolled by the recursion. The
+    //  frequency (2^K) and the amplitude (persistence^K) of an octave are
+    //  constants of its instantiation.
+    // -------------------------------------------------------------------------
+    template <int K, int N, typename T, typename Kernel, typename Persistence>
+    struct OctaveSum
+    {
+        static T Add(std::uint64_t seed, T x, T y, T sum)
+        {
+            using A = NoiseArithmetic<T>;
+
+            constexpr double frequency = Power(2.0, K);
+            constexpr double amplitude = Power(
+                static_cast<double>(Persistence::num) / Persistence::den, K);
+
+            auto const f = A::From(frequency);
+            sum = sum + SmoothValue<T, Kernel>(seed, x * f, y * f) * A::From(amplitude);
+
+            return OctaveSum<K + 1, N, T, Kernel, Persistence>::Add(seed, x, y, sum);
+        }
+    };
+
+    template <int N, typename T, typename Kernel, typename Persistence>
+    struct OctaveSum<N, N, T, Kernel, Persistence>
+    {
+        static T Add(std::uint64_t, T, T, T sum)
+        {
+            return sum;
+        }
+    };
+}
+
+// -----------------------------------------------------------------------------
+//  Sum of octaves of smoothed value noise, specialized at compile time
+//
+//   The same sum as PerlinNoise::Total without its runtime loop : the number
+//   of octaves, the scalar type, the interpolation kernel and the persistence
+//   (a std::ratio) are template parameters. x and y are already scaled by
+//   the base frequency.
+// -----------------------------------------------------------------------------
+template <int Octaves, typename T, typename Kernel, typename Persistence = std::ratio<1, 2>>
+struct ValueNoise
+{
+    static_assert(Octaves >= 1, "ValueNoise needs at least one octave");
+
+    static T Total(std::uint64_t seed, T x, T y)
+    {
+        return NoiseKernels::OctaveSum<0, Octaves, T, Kernel, Persistence>::Add(
+            seed, x, y, NoiseArithmetic<T>::From(0.0));
+    }
+};
+
+// -----------------------------------------------------------------------------
+//  Runtime selection of a ValueNoise specialization
+// -----------------------------------------------------------------------------
+enum class NoisePrecision
+{
+    Float,
+    Double,
+    Fixed
+};
+
+enum class NoiseInterpolation
+{
+    Linear,
+    Cubic,
+    Quintic
+};
+
+// PerlinNoise::Total of a specialization, evaluated in its scalar type
+using ValueNoiseFunc = double (*)(std::uint64_t seed, double frequency, double x, double y);
+
+// Octaves of the specializations : 1 to MAX_KERNEL_OCTAVES
+int const MAX_KERNEL_OCTAVES = 8;
+
+// A persistence within this distance of 1/2 uses its specializations : the
+// amplitudes of 8 octaves differ by less than 1e-8 from the generic loop
+double const PERSISTENCE_TOLERANCE = 1e-9;
+
+// The specialization of a configuration, nullptr if there is none (octaves
+// out of range or persistence other than 1/2) : use the generic loop then
+ValueNoiseFunc SelectValueNoise(int octaves, double persistence,
+    NoisePrecision precision, NoiseInterpolation interpolation);
+
+}
+
+#endif //RPI_NOISE_KERNELS_HPP
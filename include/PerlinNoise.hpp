@@ -1,6 +1,9 @@
 #ifndef RPI_PERLIN_NOISE_HPP
 #define RPI_PERLIN_NOISE_HPP
 
+#include <cstdint>
+
+#include <NoiseKernels.hpp>
 
 namespace RPi {
 
@@ -13,9 +16,13 @@ class PerlinNoise
         PerlinNoise();
         PerlinNoise(double _persistence, double _frequency, double _amplitude, int _octaves, int _randomseed);
 
-      // Get Height
+      // Get Height : through the ValueNoise specialization of the octaves
+      // and the persistence when there is one (see SelectValueNoise)
         double GetHeight(double x, double y) const;
 
+      // Get Height through the runtime loop over the octaves
+        double GetHeightGeneric(double x, double y) const;
+
       // Get
       double Persistence() const { return persistence; }
       double Frequency()   const { return frequency;   }
@@ -26,10 +33,10 @@ class PerlinNoise
       // Set
       void Set(double _persistence, double _frequency, double _amplitude, int _octaves, int _randomseed);
 
-      void SetPersistence(double _persistence) { persistence = _persistence; }
+      void SetPersistence(double _persistence) { persistence = _persistence; SelectKernel(); }
       void SetFrequency(  double _frequency)   { frequency = _frequency;     }
       void SetAmplitude(  double _amplitude)   { amplitude = _amplitude;     }
-      void SetOctaves(    int    _octaves)     { octaves = _octaves;         }
+      void SetOctaves(    int    _octaves)     { octaves = _octaves; SelectKernel(); }
       void SetRandomSeed( int    _randomseed)  { randomseed = _randomseed;   }
 
     private:
@@ -37,10 +44,13 @@ class PerlinNoise
         double Total(double i, double j) const;
         double GetValue(double x, double y) const;
         double Interpolate(double x, double y, double a) const;
-        double Noise(int x, int y) const;
+        double Noise(std::int64_t x, std::int64_t y) const;
+
+        void SelectKernel();
 
         double persistence, frequency, amplitude;
         int octaves, randomseed;
+        ValueNoiseFunc kernel;
 };
 
 }
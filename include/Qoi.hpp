@@ -0,0 +1,34 @@
+#ifndef RPI_QOI_HPP
+#define RPI_QOI_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  QOI images (https://qoiformat.org) of RGBA pixels
+//
+//   The pixels are in the order of glReadPixels, bottom row first : the
+//   files are top row first like every other image format.
+// -----------------------------------------------------------------------------
+namespace Qoi {
+
+    void Encode(std::uint8_t const * pixels, int width, int height,
+        std::vector<std::uint8_t> & out);
+
+    // Returns false if the data is not a QOI image
+    bool Decode(std::vector<std::uint8_t> const & data, int & width, int & height,
+        std::vector<std::uint8_t> & pixels);
+
+    // Return false (and print the reason on std::cerr) on failure
+    bool Save(std::string const & filename, std::uint8_t const * pixels,
+        int width, int height);
+    bool Load(std::string const & filename, int & width, int & height,
+        std::vector<std::uint8_t> & pixels);
+}
+
+}
+
+#endif //RPI_QOI_HPP
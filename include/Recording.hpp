@@ -0,0 +1,103 @@
+#ifndef RPI_RECORDING_HPP
+#define RPI_RECORDING_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include <Input.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Recording of the input and camera pose of every frame
+//
+//   Header  : "RPIR", version (u16), reserved (u16), timestep in ms (f32),
+//             seed of std::rand (u32)
+//   Frame   : flags (u8) followed by the parts of the input that changed
+//             since the previous frame, then the camera pose
+//      - Keys     : count (u8) and codes (u16) of the pressed keys
+//      - Buttons  : mask of the pressed mouse buttons (u8)
+//      - Motion   : x, y, xRel, yRel (i16)
+//      - Wheel    : f32
+//      - Pose     : position and target (6 x f32)
+//
+//   Values are written in the byte order of the machine.
+// -----------------------------------------------------------------------------
+
+// Pose of the camera after a frame
+struct CameraPose
+{
+    glm::vec3 position;
+    glm::vec3 target;
+};
+
+class InputRecorder
+{
+    public:
+        InputRecorder();
+        ~InputRecorder();
+
+        InputRecorder(InputRecorder const &) = delete;
+        InputRecorder & operator=(InputRecorder const &) = delete;
+
+        // ---------------------------------------------------------------------
+        //  Start a recording
+        //
+        //   - filename : file to write
+        //   - timestep : simulated time between two frames in ms
+        //   - seed     : seed of std::rand used by the recorded run
+        //
+        //   returns false if the file could not be created
+        // ---------------------------------------------------------------------
+        bool open(std::string const & filename, float timestep, std::uint32_t seed);
+
+        void record(Input::State const & input, CameraPose const & pose);
+
+        void close();
+
+        bool isOpen() const;
+        std::size_t frames() const;
+
+    private:
+        std::ofstream m_file;
+        Input::State m_previous;
+        std::size_t m_frames;
+};
+
+class InputPlayer
+{
+    public:
+        InputPlayer();
+
+        InputPlayer(InputPlayer const &) = delete;
+        InputPlayer & operator=(InputPlayer const &) = delete;
+
+        // returns false if the file is missing or is not a recording
+        bool open(std::string const & filename);
+
+        // ---------------------------------------------------------------------
+        //  Read the next frame
+        //
+        //   returns false at the end of the recording
+        // ---------------------------------------------------------------------
+        bool next(Input::State & input, CameraPose & pose);
+
+        bool isOpen() const;
+        float timestep() const;
+        std::uint32_t seed() const;
+        std::size_t frames() const;
+
+    private:
+        std::ifstream m_file;
+        Input::State m_state;
+        float m_timestep;
+        std::uint32_t m_seed;
+        std::size_t m_frames;
+};
+
+}
+
+#endif //RPI_RECORDING_HPP
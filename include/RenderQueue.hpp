@@ -0,0 +1,161 @@
+#ifndef RPI_RENDER_QUEUE_HPP
+#define RPI_RENDER_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <EGLHeaders.hpp>
+
+namespace RPi {
+
+class GLSLProgram;
+class VertexFormat;
+
+// Passes of a frame, submitted in this order
+enum class RenderPass
+{
+    Opaque,      // front to back
+    Transparent, // back to front
+    Overlay      // order of submission
+};
+
+// -----------------------------------------------------------------------------
+//  One draw call and the state it needs
+//
+//   Draws glDrawElements(mode, count, indexType, first * size of an index)
+//   when indexBuffer is set, glDrawArrays(mode, first, count) otherwise.
+//   A custom draw function replaces the GL draw (the overlay text).
+// -----------------------------------------------------------------------------
+struct DrawItem
+{
+    DrawItem();
+
+    // The pointers are not owned
+    DrawItem(DrawItem const &) = default;
+    DrawItem(DrawItem &&) = default;
+
+    DrawItem & operator=(DrawItem const &) = default;
+    DrawItem & operator=(DrawItem &&) = default;
+
+    RenderPass pass;
+
+    GLSLProgram const * program;
+    GLuint vertexBuffer;
+    GLuint indexBuffer;
+    VertexFormat const * format;
+    std::size_t vertexOffset;
+
+    // Per-object uniforms, sent each time the program or the object changes.
+    // The meshes of a BufferManager page share their vertex buffer : the
+    // buffer does not tell two objects apart. Without an object, setup is
+    // sent again on every change of vertex buffer, format or offset.
+    std::function<void(GLSLProgram const &)> setup;
+    void const * object;
+
+    glm::mat4 modelView;
+
+    // Point of the object whose view distance sorts the draws
+    glm::vec3 center;
+
+    GLenum mode;
+    GLsizei first;
+    GLsizei count;
+    GLenum indexType;
+
+    std::function<void()> draw;
+};
+
+// State changes of a submitted frame
+struct RenderStats
+{
+    RenderStats();
+
+    std::size_t draws;
+    std::size_t programChanges;
+    std::size_t programBinds;   // glUseProgram calls, unbind included
+    std::size_t bufferChanges;
+    std::size_t formatChanges;
+    std::size_t setups;
+    std::size_t matrixUploads;
+
+    // Changes that the same draws would have cost in order of submission
+    std::size_t unsortedProgramChanges;
+    std::size_t unsortedBufferChanges;
+
+    // Fraction of the opaque draws that are not closer than the previous
+    // one, sorted and in order of submission. The GPU has no early-Z
+    // counter : the higher, the more hidden fragments the depth test can
+    // reject before shading them.
+    float frontToBack;
+    float unsortedFrontToBack;
+};
+
+// -----------------------------------------------------------------------------
+//  Draws of a frame sorted to minimize the state changes
+//
+//   The 64-bit sort key of a draw holds, from the most significant bits :
+//      pass (4) | program (10) | vertex buffer (14) | depth (24) | 0 (12)
+//   so the draws are grouped by pass, then program, then buffer, and go
+//   front to back inside a group (back to front for transparent draws).
+//   Programs and buffers get small numbers in order of first use.
+//
+//   The keys are radix sorted, which keeps the order of submission of draws
+//   with equal keys.
+// -----------------------------------------------------------------------------
+class RenderQueue
+{
+    public:
+        // Depth of the far plane, farther draws share the last depth value
+        RenderQueue(float farDepth = 100.f);
+
+        void clear();
+
+        void add(DrawItem const & item);
+
+        std::size_t size() const;
+
+        void sort();
+
+        // Sort if needed, then draw every item. The projection is sent to
+        // each program used.
+        void submit(glm::mat4 const & projection);
+
+        // Statistics of the last submit
+        RenderStats const & stats() const;
+
+        // Item of the i-th draw in sorted order
+        DrawItem const & sorted(std::size_t i) const;
+
+    private:
+        struct Entry
+        {
+            std::uint64_t key;
+            std::uint32_t item;
+        };
+
+        std::uint64_t key(DrawItem const & item, float depth);
+
+        // Small numbers of the programs and buffers in the keys
+        std::uint64_t programId(GLSLProgram const * program);
+        std::uint64_t bufferId(GLuint buffer);
+
+        void countUnsorted();
+
+        float m_farDepth;
+        std::vector<DrawItem> m_items;
+        std::vector<Entry> m_entries;
+        std::vector<Entry> m_scratch;
+        std::vector<float> m_depths;
+        std::vector<GLSLProgram const *> m_programs;
+        std::vector<GLuint> m_buffers;
+        bool m_sorted;
+        RenderStats m_stats;
+};
+
+}
+
+#endif //RPI_RENDER_QUEUE_HPP
@@ -0,0 +1,90 @@
+#ifndef RPI_SCENE_GRAPH_HPP
+#define RPI_SCENE_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Hierarchy of transforms stored in flat arrays
+//
+//   A node has a local matrix, relative to its parent, and a world matrix :
+//      world = world(parent) * local
+//
+//   Setting the local matrix of a node marks it dirty and update() only
+//   recomputes the world matrices of the dirty subtrees : a scene where
+//   nothing moved costs nothing.
+//
+//   The nodes are kept in depth-first order, so a parent always comes before
+//   its children and a subtree is a contiguous range : the update is a linear
+//   walk over the arrays. Adding or reparenting nodes sorts them again at the
+//   next update. Node handles stay valid across the sorts.
+// -----------------------------------------------------------------------------
+class SceneGraph
+{
+    public:
+        using Node = std::size_t;
+
+        // Parent of the root nodes
+        static Node const None;
+
+        SceneGraph();
+
+        // Add a node, returns its handle
+        Node add(Node parent = None, glm::mat4 const & local = glm::mat4(1.f));
+
+        std::size_t size() const;
+
+        Node parent(Node node) const;
+
+        // Move a node and its subtree under another parent, returns false
+        // if the parent is inside the subtree
+        bool parent(Node node, Node parent);
+
+        void local(Node node, glm::mat4 const & local);
+        glm::mat4 const & local(Node node) const;
+
+        // Transform the local matrix as glm::translate/glm::rotate would
+        void translate(Node node, glm::vec3 const & offset);
+        void rotate(Node node, float angle, glm::vec3 const & axis);
+
+        // World matrix computed by the last update
+        glm::mat4 const & world(Node node) const;
+
+        // Whether update has something to recompute
+        bool dirty() const;
+
+        // Recompute the world matrices of the dirty subtrees, returns the
+        // number of recomputed matrices
+        std::size_t update();
+
+    private:
+        // Sort the nodes in depth-first order
+        void sort();
+
+        void markDirty(std::size_t slot);
+
+        // Indexed by handle
+        std::vector<std::size_t> m_slots;
+        std::vector<Node> m_parentNodes;
+
+        // Indexed by slot (position in the depth-first order)
+        std::vector<Node> m_nodes;
+        std::vector<std::size_t> m_parents;
+        std::vector<std::size_t> m_subtrees;
+        std::vector<glm::mat4> m_locals;
+        std::vector<glm::mat4> m_worlds;
+        std::vector<std::uint8_t> m_dirty;
+
+        // Slots marked dirty since the last update
+        std::vector<std::size_t> m_dirtySlots;
+        bool m_sorted;
+};
+
+}
+
+#endif //RPI_SCENE_GRAPH_HPP
@@ -0,0 +1,95 @@
+#ifndef RPI_SPSC_QUEUE_HPP
+#define RPI_SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Bounded queue between one producer thread and one consumer thread
+//
+//   A ring of Capacity slots (a power of two) indexed by two counters : the
+//   producer only writes the tail, the consumer only writes the head, so
+//   neither push nor pop takes a lock or waits. The counters live on their
+//   own cache lines so that the two threads do not invalidate each other's
+//   line on every operation.
+// -----------------------------------------------------------------------------
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+        "The capacity must be a power of two");
+
+    public:
+        SpscQueue();
+
+        SpscQueue(SpscQueue const &) = delete;
+        SpscQueue & operator=(SpscQueue const &) = delete;
+
+        // Producer side, false when the queue is full
+        bool push(T const & value);
+
+        // Consumer side, false when the queue is empty
+        bool pop(T & value);
+
+        // Approximate when called while the other thread works
+        std::size_t size() const;
+
+    private:
+        static std::size_t const CACHE_LINE = 64;
+
+        alignas(CACHE_LINE) std::atomic<std::size_t> m_head;
+        alignas(CACHE_LINE) std::atomic<std::size_t> m_tail;
+        alignas(CACHE_LINE) std::array<T, Capacity> m_slots;
+};
+
+template <typename T, std::size_t Capacity>
+SpscQueue<T, Capacity>::SpscQueue():
+    m_head(0), m_tail(0), m_slots()
+{
+
+}
+
+template <typename T, std::size_t Capacity>
+bool SpscQueue<T, Capacity>::push(T const & value)
+{
+    auto const tail = m_tail.load(std::memory_order_relaxed);
+
+    if(tail - m_head.load(std::memory_order_acquire) == Capacity)
+    {
+        return false;
+    }
+
+    m_slots[tail & (Capacity - 1)] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T, std::size_t Capacity>
+bool SpscQueue<T, Capacity>::pop(T & value)
+{
+    auto const head = m_head.load(std::memory_order_relaxed);
+
+    if(head == m_tail.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    value = m_slots[head & (Capacity - 1)];
+    m_head.store(head + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t SpscQueue<T, Capacity>::size() const
+{
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+}
+
+}
+
+#endif //RPI_SPSC_QUEUE_HPP
@@ -5,8 +5,12 @@
 
 #include <glm/glm.hpp>
 
+#include <BufferManager.hpp>
 #include <EGLHeaders.hpp>
 #include <GLSLProgram.hpp>
+#include <Heightfield.hpp>
+#include <RenderQueue.hpp>
+#include <VertexFormat.hpp>
 
 namespace RPi {
 
@@ -19,18 +23,36 @@ class Terrain
         Terrain(Size w, Size h);
         ~Terrain();
 
+        Terrain(Terrain const &) = delete;
+        Terrain & operator=(Terrain const &) = delete;
+
         float getMaxHeight() const;
 
+        // CPU copy of the heights, for queries (the wave animation of the
+        // vertex shader is not applied)
+        Heightfield const & heightfield() const;
+
         void render(GLSLProgram const & program, glm::mat4 & projection,
             glm::mat4 & modelView);
 
+        // Add the draws of the chunks to a render queue
+        void queue(RenderQueue & queue, GLSLProgram const & program,
+            glm::mat4 const & modelView) const;
+
     private:
-        GLuint m_vbo;
+        BufferRange m_vertices;
+        BufferRange m_indices;
+        VertexFormat m_format;
+        PositionQuantizer m_quantizer;
         Size m_w;
         Size m_h;
+        Size m_columns;
+        Size m_rows;
+        Size m_rowsPerChunk;
         Size m_nbVertices;
         float m_minHeight;
         float m_maxHeight;
+        Heightfield m_heightfield;
 };
 
 }
@@ -1,6 +1,9 @@
 #ifndef RPI_TEST_APP_HPP
 #define RPI_TEST_APP_HPP
 
+#include <cstddef>
+#include <string>
+
 #include <App.hpp>
 
 namespace RPi {
@@ -12,6 +15,95 @@ class TestApp : public App
         virtual ~TestApp();
 
         virtual void run() override;
+
+        // ---------------------------------------------------------------------
+        //  Record the input and camera pose of every frame
+        //
+        //   - filename : recording to write
+        //   - timestep : simulated time between two frames in ms, the
+        //                animations no longer depend on the frame rate
+        // ---------------------------------------------------------------------
+        void record(std::string const & filename, float timestep);
+
+        // Replay a recording instead of reading the keyboard and the mouse
+        void replay(std::string const & filename);
+
+        // ---------------------------------------------------------------------
+        //  Benchmark : fly along a camera path and report the frame times of
+        //  each of its segments
+        //
+        //   - filename : path file (see CameraPath)
+        //   - duration : duration of the flight in s (0 : the one of the path)
+        //
+        //   The path advances by a fixed step per frame, so that every run
+        //   renders the same frames.
+        // ---------------------------------------------------------------------
+        void flythrough(std::string const & filename, float duration);
+
+        // ---------------------------------------------------------------------
+        //  Measure the latency from the input events to the presentation of
+        //  the frames they moved the camera of (see LatencyProbe)
+        //
+        //   - filename : CSV file the distribution is appended to, labeled
+        //                with the scheduler policy and priority
+        //   - period   : period in ms of the injected key events, 0 to
+        //                measure the events of the user
+        // ---------------------------------------------------------------------
+        void probeLatency(std::string const & filename, float period);
+
+        // ---------------------------------------------------------------------
+        //  Render more views of the scene in the same frame (see
+        //  MultiViewRenderer)
+        //
+        //   - windowViews    : views side by side in the window, the camera
+        //                      included
+        //   - offscreenViews : views rendered to framebuffer objects
+        // ---------------------------------------------------------------------
+        void views(std::size_t windowViews, std::size_t offscreenViews);
+
+        // ---------------------------------------------------------------------
+        //  Write a frame to disk every <interval> frames (see FrameCapture)
+        //
+        //   - directory : existing directory of the QOI files
+        //   - interval  : frames between two captures
+        // ---------------------------------------------------------------------
+        void capture(std::string const & directory, std::size_t interval);
+
+        // ---------------------------------------------------------------------
+        //  Render the poses of a golden directory offscreen, compare them with
+        //  its images and quit (see GoldenHarness)
+        //
+        //   - directory : golden directory
+        //   - update    : write the renders as the new golden images
+        //   - label     : name of the build in the results
+        // ---------------------------------------------------------------------
+        void golden(std::string const & directory, bool update, std::string const & label);
+
+        // ---------------------------------------------------------------------
+        //  Skip the render and the swap of the frames identical to the last
+        //  presented one (see ChangeTracker)
+        //
+        //   - sleep : time in ms the loop sleeps after a skipped frame
+        // ---------------------------------------------------------------------
+        void skipIdleFrames(float sleep);
+
+    private:
+        std::string m_recordFile;
+        std::string m_replayFile;
+        float m_timestep;
+        std::string m_pathFile;
+        float m_flightDuration;
+        std::string m_latencyFile;
+        float m_injectPeriod;
+        std::size_t m_windowViews;
+        std::size_t m_offscreenViews;
+        std::string m_captureDirectory;
+        std::size_t m_captureInterval;
+        std::string m_goldenDirectory;
+        bool m_goldenUpdate;
+        std::string m_goldenLabel;
+        bool m_skipIdle;
+        float m_idleSleep;
 };
 
 }
@@ -0,0 +1,87 @@
+#ifndef RPI_TRANSFORM_STORE_HPP
+#define RPI_TRANSFORM_STORE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace RPi {
+
+// -----------------------------------------------------------------------------
+//  Transforms of many objects in structure-of-arrays form
+//
+//   Each component (position x, y, z, rotation quaternion x, y, z, w and
+//   scale x, y, z) is stored in its own contiguous array, so the batch
+//   updates stream through memory and compose four objects at a time with
+//   SSE or NEON (scalar code when neither is available).
+//
+//   The model matrix of an object is T(position) * R(rotation) * S(scale).
+//   The matrices are only computed by updateModels/updateModelViews : the
+//   accessors return the result of the last update.
+// -----------------------------------------------------------------------------
+class TransformStore
+{
+    public:
+        using Index = std::size_t;
+
+        TransformStore();
+
+        // Add an object, returns its index
+        Index add(glm::vec3 const & position = glm::vec3(0.f),
+            glm::vec3 const & scale = glm::vec3(1.f));
+
+        void reserve(std::size_t count);
+        void clear();
+
+        std::size_t size() const;
+
+        void position(Index i, glm::vec3 const & position);
+        glm::vec3 position(Index i) const;
+
+        void scale(Index i, glm::vec3 const & scale);
+        glm::vec3 scale(Index i) const;
+
+        // Rotation quaternion (x, y, z, w), normalized by the store
+        void rotation(Index i, glm::vec4 const & quaternion);
+        glm::vec4 rotation(Index i) const;
+
+        // Rotate the object around an axis of its own frame (angle in degrees)
+        void rotate(Index i, float angle, glm::vec3 const & axis);
+
+        // Move the object along its own (rotated and scaled) axes, as
+        // glm::translate would on the model matrix
+        void translate(Index i, glm::vec3 const & offset);
+
+        // Compose the model matrices of every object
+        void updateModels();
+
+        // Compose the model-view matrices of every object (the model
+        // matrices are left untouched)
+        void updateModelViews(glm::mat4 const & view);
+
+        glm::mat4 const & model(Index i) const;
+        glm::mat4 const & modelView(Index i) const;
+
+        // Contiguous arrays of size() matrices
+        glm::mat4 const * models() const;
+        glm::mat4 const * modelViews() const;
+
+    private:
+        // Objects are processed by groups of four : the arrays are padded
+        // with identity transforms up to a multiple of four
+        void resize(std::size_t padded);
+
+        std::size_t m_size;
+
+        std::vector<float> m_px, m_py, m_pz;
+        std::vector<float> m_qx, m_qy, m_qz, m_qw;
+        std::vector<float> m_sx, m_sy, m_sz;
+
+        std::vector<glm::mat4> m_models;
+        std::vector<glm::mat4> m_modelViews;
+};
+
+}
+
+#endif //RPI_TRANSFORM_STORE_HPP
@@ -0,0 +1,165 @@
+#ifndef RPI_VERTEX_FORMAT_HPP
+#define RPI_VERTEX_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <EGLHeaders.hpp>
+#include <Enums.hpp>
+
+namespace RPi {
+
+    class GLSLProgram;
+
+    // -------------------------------------------------------------------------
+    //  Packed vertex layouts
+    //
+    //   Positions are stored on 16 bits and dequantized in the vertex shader
+    //   with the PositionScale/PositionBias uniforms (see PositionQuantizer).
+    //   Normals and colors are stored on 8 bits per component.
+    //   Every attribute is padded to 4 bytes to keep the fetches aligned.
+    // -------------------------------------------------------------------------
+    namespace Vertex {
+
+        // 12 bytes : reference layout
+        struct P32
+        {
+            float position[3];
+        };
+
+        // 8 bytes
+        struct P16
+        {
+            std::int16_t position[4];
+        };
+
+        // 12 bytes
+        struct P16C8
+        {
+            std::int16_t position[4];
+            std::uint8_t color[4];
+        };
+
+        // 12 bytes
+        struct P16N8
+        {
+            std::int16_t position[4];
+            std::int8_t  normal[4];
+        };
+
+        // 16 bytes
+        struct P16N8C8
+        {
+            std::int16_t position[4];
+            std::int8_t  normal[4];
+            std::uint8_t color[4];
+        };
+    }
+
+    // -------------------------------------------------------------------------
+    //  Scalar packing helpers
+    //
+    //   The normalized conversions follow the OpenGL ES 2.0 rule
+    //   f = (2c + 1) / (2^b - 1) used by glVertexAttribPointer.
+    // -------------------------------------------------------------------------
+    namespace Packing {
+
+        std::int16_t Snorm16(float v);
+        std::int8_t  Snorm8(float v);
+        std::uint8_t Unorm8(float v);
+        std::int16_t Fixed16(float v, unsigned int fracBits);
+
+        void Normal(glm::vec3 const & n, std::int8_t out[4]);
+        void Color(glm::vec4 const & c, std::uint8_t out[4]);
+    }
+
+    // Encoding of a 16-bit position
+    enum class PositionEncoding
+    {
+        Snorm16, // GL_SHORT normalized, mapped on the bounding box
+        Fixed16  // GL_SHORT as is, fixed-point with a power of two scale
+    };
+
+    // -------------------------------------------------------------------------
+    //  Maps float positions of a bounding box to 16-bit integers
+    //
+    //   The vertex shader gets the position back with :
+    //      position = VertexPosition.xyz * PositionScale + PositionBias
+    // -------------------------------------------------------------------------
+    class PositionQuantizer
+    {
+        public:
+            PositionQuantizer();
+            PositionQuantizer(glm::vec3 const & min, glm::vec3 const & max,
+                PositionEncoding encoding = PositionEncoding::Snorm16);
+
+            void encode(glm::vec3 const & position, std::int16_t out[4]) const;
+            glm::vec3 decode(std::int16_t const in[4]) const;
+
+            PositionEncoding encoding() const;
+            bool normalized() const;
+
+            glm::vec3 const & scale() const;
+            glm::vec3 const & bias() const;
+
+            // Send the dequantization uniforms to the program
+            void send(GLSLProgram const & program) const;
+
+            // Quantizer leaving float positions untouched
+            static void SendIdentity(GLSLProgram const & program);
+
+        private:
+            PositionEncoding m_encoding;
+            unsigned int m_fracBits;
+            glm::vec3 m_scale;
+            glm::vec3 m_bias;
+            glm::vec3 m_invScale;
+    };
+
+    // Description of one attribute inside an interleaved vertex
+    struct VertexAttribute
+    {
+        Enums::AttributeIndex index;
+        GLint size;
+        GLenum type;
+        GLboolean normalized;
+        std::size_t offset;
+    };
+
+    // -------------------------------------------------------------------------
+    //  Interleaved vertex layout bound with glVertexAttribPointer
+    // -------------------------------------------------------------------------
+    class VertexFormat
+    {
+        public:
+            VertexFormat(std::size_t stride);
+
+            VertexFormat & add(Enums::AttributeIndex index, GLint size,
+                GLenum type, GLboolean normalized, std::size_t offset);
+
+            std::size_t stride() const;
+
+            std::vector<VertexAttribute> const & attributes() const;
+
+            // Set the pointers (relative to the bound GL_ARRAY_BUFFER)
+            // and enable the arrays
+            void enable(std::size_t baseOffset = 0) const;
+            void disable() const;
+
+            // Formats of the Vertex layouts
+            static VertexFormat P32();
+            static VertexFormat P16(PositionEncoding encoding);
+            static VertexFormat P16C8(PositionEncoding encoding);
+            static VertexFormat P16N8(PositionEncoding encoding);
+            static VertexFormat P16N8C8(PositionEncoding encoding);
+
+        private:
+            std::vector<VertexAttribute> m_attributes;
+            std::size_t m_stride;
+    };
+}
+
+#endif //RPI_VERTEX_FORMAT_HPP
@@ -12,7 +12,8 @@ enum WindowFlag : WindowFlags
     WINDOW_ALPHA       = 1 << 0,
     WINDOW_DEPTH       = 1 << 1,
     WINDOW_STENCIL     = 1 << 2,
-    WINDOW_MULTISAMPLE = 1 << 3
+    WINDOW_MULTISAMPLE = 1 << 3,   // 4x
+    WINDOW_TRUE_COLOR  = 1 << 4    // RGB 888 instead of 565
 };
 
 class Window
@@ -30,6 +31,7 @@ class Window
         void clear() const;
         void display() const;
         void displayText(std::string const & text) const;
+        void displayText(char const * text) const;
 
         void grabMousePointer(bool grab) const;
         void showMousePointer(bool show) const;
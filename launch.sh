@@ -11,7 +11,17 @@ SCREEN_W_HALF=$[SCREEN_W / 2]
 SCREEN_H=900
 LAG=6
 
+# Optional recording (made with `$EXE -r <file>`) replayed by both apps so
+# that they render the same frames
+REPLAY=${1:+-R $1}
+
+# Optional input latency probe : LATENCY=latency.csv ./launch.sh appends the
+# input-to-present latency of both apps to latency.csv, with key events
+# injected every INJECT ms
+INJECT=${INJECT:-50}
+PROBE=${LATENCY:+-L $LATENCY -i $INJECT}
+
 sudo echo "Launching apps"
 
-sudo $EXE -s $SCHED1 -p $P1 -x 0 -w $SCREEN_W_HALF -h $SCREEN_H -l $LAG &
-sudo $EXE -s $SCHED2 -p $P2 -x $SCREEN_W_HALF -w $SCREEN_W_HALF -h $SCREEN_H -l $LAG &
+sudo $EXE -s $SCHED1 -p $P1 -x 0 -w $SCREEN_W_HALF -h $SCREEN_H -l $LAG $REPLAY $PROBE &
+sudo $EXE -s $SCHED2 -p $P2 -x $SCREEN_W_HALF -w $SCREEN_W_HALF -h $SCREEN_H -l $LAG $REPLAY $PROBE &
@@ -4,6 +4,10 @@ varying vec4 color;
 
 void main()
 {
+#ifdef LIGHTING
+    gl_FragColor = color;
+#else
     gl_FragColor = vec4(0.0, 0.0, 1.0, 1.0);
     /*gl_FragColor = color;*/
+#endif
 }
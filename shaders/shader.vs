@@ -1,15 +1,28 @@
 attribute vec4 VertexPosition;
+#ifdef LIGHTING
+attribute vec3 VertexNormal;
+#endif
 
 uniform mat4 MatModelView;
 uniform mat4 MatProjection;
-uniform float time;
-uniform float random;
+uniform vec3 PositionScale;
+uniform vec3 PositionBias;
+// Animation parameters, evaluated once per tick on the CPU (Animator) :
+//   Animation[0].x : height scale of the wave
+//   Animation[0].y : amplitude of the current cycle of the wave
+uniform vec4 Animation[4];
 uniform float maxHeight;
 uniform float terrainWidth;
 uniform float terrainHeight;
 
 varying vec4 color;
 
+#ifdef LIGHTING
+// Normalized direction towards the light
+const vec3 LightDirection = vec3(0.4082, 0.8165, 0.4082);
+const float Ambient = 0.25;
+#endif
+
 vec4 calc_color(float h)
 {
     vec4 max_color = vec4(1.0, 0.2, 0.5, 1.0);
@@ -31,10 +44,23 @@ vec4 rainbow(float x, float y, float z)
 
 void main()
 {
-    float h = VertexPosition.y * cos(time) * random;
+    // Dequantize the 16-bit position
+    vec3 position = VertexPosition.xyz * PositionScale + PositionBias;
+
+    float wave = Animation[0].x;
+    float h = position.y * wave;
     /*color = calc_color(h);*/
-    color = rainbow(VertexPosition.x, VertexPosition.y, VertexPosition.z);
-    vec4 cam_pos = MatModelView * vec4(VertexPosition.x, h, VertexPosition.zw);
+    color = rainbow(position.x, position.y, position.z);
+
+#ifdef LIGHTING
+    // Scaling the heights by <wave> scales the slopes of the normals
+    vec3 normal = normalize(vec3(VertexNormal.x * wave, VertexNormal.y,
+        VertexNormal.z * wave));
+    float diffuse = max(dot(normal, LightDirection), 0.0);
+    color = vec4(calc_color(h).xyz * (Ambient + (1.0 - Ambient) * diffuse), 1.0);
+#endif
+
+    vec4 cam_pos = MatModelView * vec4(position.x, h, position.z, 1.0);
     gl_Position  = MatProjection * cam_pos;
 
     /*gl_Position = VertexPosition;*/
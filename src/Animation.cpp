@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <Animation.hpp>
+#include <EGLHeaders.hpp>
+#include <GLSLProgram.hpp>
+
+namespace RPi {
+
+AnimationCurve::AnimationCurve():
+    m_table(1, 0.f), m_period(1.f), m_rate(1.f)
+{
+
+}
+
+AnimationCurve::AnimationCurve(std::function<float(float)> const & f, float period,
+    std::size_t samples):
+    m_table(std::max<std::size_t>(samples, 1)), m_period(period > 0.f ? period : 1.f),
+    m_rate(static_cast<float>(m_table.size()) / m_period)
+{
+    for(std::size_t i = 0; i < m_table.size(); ++i)
+    {
+        m_table[i] = f(static_cast<float>(i) / m_rate);
+    }
+}
+
+float AnimationCurve::period() const
+{
+    return m_period;
+}
+
+std::size_t AnimationCurve::samples() const
+{
+    return m_table.size();
+}
+
+float AnimationCurve::sample(float t) const
+{
+    auto const size = m_table.size();
+    auto const length = static_cast<float>(size);
+
+    // Position in the table, wrapped without a division
+    auto x = t * m_rate;
+    x -= std::floor(x * (1.f / length)) * length;
+
+    auto const i = std::min(static_cast<std::size_t>(x), size - 1);
+    auto const j = i + 1 < size ? i + 1 : 0;
+    auto const u = x - static_cast<float>(i);
+
+    return m_table[i] + (m_table[j] - m_table[i]) * u;
+}
+
+AnimationBlock::AnimationBlock():
+    m_values(), m_version(1), m_uploaded()
+{
+    m_values.fill(0.f);
+}
+
+void AnimationBlock::set(std::size_t param, float value)
+{
+    assert(param < m_values.size());
+
+    // Any change bumps the version, written without float equality
+    if(m_values[param] < value || m_values[param] > value)
+    {
+        m_values[param] = value;
+        ++m_version;
+    }
+}
+
+float AnimationBlock::get(std::size_t param) const
+{
+    assert(param < m_values.size());
+
+    return m_values[param];
+}
+
+float const * AnimationBlock::data() const
+{
+    return m_values.data();
+}
+
+std::uint32_t AnimationBlock::version() const
+{
+    return m_version;
+}
+
+bool AnimationBlock::upload(GLSLProgram const & program)
+{
+    auto uploaded = std::find_if(m_uploaded.begin(), m_uploaded.end(),
+        [&](std::pair<GLSLProgram const *, std::uint32_t> const & p)
+        {
+            return p.first == &program;
+        });
+
+    if(uploaded == m_uploaded.end())
+    {
+        m_uploaded.emplace_back(&program, 0);
+        uploaded = m_uploaded.end() - 1;
+    }
+    else if(uploaded->second == m_version)
+    {
+        return false;
+    }
+
+    program.sendVec4Array("Animation", m_values.data(), SIZE);
+    uploaded->second = m_version;
+
+    return true;
+}
+
+Animator::Animator(float tick):
+    m_tracks(), m_block(), m_tick(tick > 0.f ? tick : 1.f), m_ticks(0),
+    m_elapsed(0.f), m_evaluated(false)
+{
+
+}
+
+Animator::Track Animator::add(AnimationCurve const & curve, std::size_t param, float scale)
+{
+    m_tracks.push_back({ curve, param, scale });
+
+    if(m_evaluated) evaluate(m_tracks.back());
+
+    return m_tracks.size() - 1;
+}
+
+void Animator::scale(Track track, float scale)
+{
+    assert(track < m_tracks.size());
+
+    m_tracks[track].scale = scale;
+
+    if(m_evaluated) evaluate(m_tracks[track]);
+}
+
+std::size_t Animator::loops(Track track) const
+{
+    assert(track < m_tracks.size());
+
+    return static_cast<std::size_t>(time() / m_tracks[track].curve.period());
+}
+
+bool Animator::advance(float ms)
+{
+    m_elapsed += ms;
+
+    if(m_evaluated && m_elapsed < m_tick) return false;
+
+    // Frames longer than a tick skip the ticks in between
+    auto const ticks = static_cast<std::uint64_t>(m_elapsed / m_tick);
+
+    m_ticks += ticks;
+    m_elapsed -= static_cast<float>(ticks) * m_tick;
+
+    for(auto const & track : m_tracks) evaluate(track);
+
+    m_evaluated = true;
+
+    return true;
+}
+
+double Animator::time() const
+{
+    return static_cast<double>(m_ticks) * m_tick;
+}
+
+AnimationBlock & Animator::block()
+{
+    return m_block;
+}
+
+AnimationBlock const & Animator::block() const
+{
+    return m_block;
+}
+
+void Animator::evaluate(TrackData const & track)
+{
+    // Within the period : no float precision lost after hours of animation
+    auto const period = static_cast<double>(track.curve.period());
+    auto const t = time() - std::floor(time() / period) * period;
+
+    m_block.set(track.param, track.curve.sample(static_cast<float>(t)) * track.scale);
+}
+
+}
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <iostream>
+
+#include <BufferManager.hpp>
+
+namespace RPi {
+
+namespace {
+
+    // Alignment of the ranges, enough for any vertex attribute
+    std::size_t const ALIGNMENT = 16;
+
+    std::size_t align_up(std::size_t size)
+    {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+}
+
+BufferRange::BufferRange():
+    buffer(0), offset(0), size(0)
+{
+
+}
+
+bool BufferRange::valid() const
+{
+    return buffer != 0;
+}
+
+BufferStats::BufferStats():
+    buffers(0), allocatedBytes(0), peakBytes(0), usedBytes(0), ranges(0),
+    streamedBytes(0), orphans(0)
+{
+
+}
+
+BufferManager::BufferManager(std::size_t pageSize, std::size_t streamSize):
+    m_pageSize(align_up(pageSize)), m_streamSize(align_up(streamSize)),
+    m_pages(), m_rings(), m_stats()
+{
+
+}
+
+BufferManager::~BufferManager()
+{
+    for(auto const & page : m_pages)
+    {
+        deleteBuffer(page.buffer, page.size);
+    }
+
+    for(auto const & ring : m_rings)
+    {
+        deleteBuffer(ring.buffer, ring.size);
+    }
+}
+
+BufferRange BufferManager::allocate(GLenum target, void const * data, std::size_t size)
+{
+    BufferRange range;
+
+    if(size == 0) return range;
+
+    auto const aligned = align_up(size);
+
+    // First fit in the pages of the target
+    for(auto & page : m_pages)
+    {
+        if(page.target != target) continue;
+
+        auto const block = std::find_if(page.free.begin(), page.free.end(),
+            [aligned](Block const & b) { return b.size >= aligned; });
+
+        if(block == page.free.end()) continue;
+
+        range.buffer = page.buffer;
+        range.offset = block->offset;
+
+        block->offset += aligned;
+        block->size -= aligned;
+
+        if(block->size == 0) page.free.erase(block);
+
+        page.used += aligned;
+        break;
+    }
+
+    if(!range.valid())
+    {
+        // Geometry bigger than a page gets a buffer of its own, filled at
+        // creation
+        if(aligned >= m_pageSize)
+        {
+            range.buffer = createBuffer(target, aligned, data, GL_STATIC_DRAW);
+            m_pages.push_back({ target, range.buffer, aligned, aligned, {} });
+            data = nullptr;
+        }
+        else
+        {
+            range.buffer = createBuffer(target, m_pageSize, nullptr, GL_STATIC_DRAW);
+            m_pages.push_back({ target, range.buffer, m_pageSize, aligned,
+                { { aligned, m_pageSize - aligned } } });
+        }
+    }
+
+    range.size = size;
+
+    if(data != nullptr)
+    {
+        glBindBuffer(target, range.buffer);
+        glBufferSubData(target, range.offset, size, data);
+        glBindBuffer(target, 0);
+    }
+
+    m_stats.usedBytes += aligned;
+    ++m_stats.ranges;
+
+    return range;
+}
+
+void BufferManager::release(BufferRange & range)
+{
+    if(!range.valid()) return;
+
+    auto const page = std::find_if(m_pages.begin(), m_pages.end(),
+        [&range](Page const & p) { return p.buffer == range.buffer; });
+
+    if(page == m_pages.end())
+    {
+        std::cerr << "BufferManager::release : Unknown buffer " << range.buffer << std::endl;
+        return;
+    }
+
+    Block const block = { range.offset, align_up(range.size) };
+
+    page->used -= block.size;
+    m_stats.usedBytes -= block.size;
+    --m_stats.ranges;
+
+    range = BufferRange();
+
+    if(page->used == 0)
+    {
+        deleteBuffer(page->buffer, page->size);
+        m_pages.erase(page);
+        return;
+    }
+
+    // Insert the block and merge it with its free neighbours
+    auto & free = page->free;
+
+    auto next = std::lower_bound(free.begin(), free.end(), block,
+        [](Block const & a, Block const & b) { return a.offset < b.offset; });
+
+    next = free.insert(next, block);
+
+    if(next + 1 != free.end() && next->offset + next->size == (next + 1)->offset)
+    {
+        next->size += (next + 1)->size;
+        free.erase(next + 1);
+    }
+
+    if(next != free.begin() && (next - 1)->offset + (next - 1)->size == next->offset)
+    {
+        (next - 1)->size += next->size;
+        free.erase(next);
+    }
+}
+
+BufferRange BufferManager::stream(GLenum target, void const * data, std::size_t size)
+{
+    BufferRange range;
+
+    if(size == 0) return range;
+
+    auto & r = ring(target);
+
+    glBindBuffer(target, r.buffer);
+
+    if(size > r.size)
+    {
+        // Too big for the ring : grow it
+        auto const grown = std::max(2 * r.size, align_up(size));
+
+        glBufferData(target, grown, nullptr, GL_STREAM_DRAW);
+
+        m_stats.allocatedBytes += grown - r.size;
+        m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.allocatedBytes);
+
+        r.size = grown;
+        r.head = 0;
+        ++m_stats.orphans;
+    }
+    else if(r.head + size > r.size)
+    {
+        // Orphan the storage the pending draws may still read
+        glBufferData(target, r.size, nullptr, GL_STREAM_DRAW);
+
+        r.head = 0;
+        ++m_stats.orphans;
+    }
+
+    glBufferSubData(target, r.head, size, data);
+    glBindBuffer(target, 0);
+
+    range.buffer = r.buffer;
+    range.offset = r.head;
+    range.size = size;
+
+    r.head = align_up(r.head + size);
+    m_stats.streamedBytes += size;
+
+    return range;
+}
+
+BufferStats const & BufferManager::stats() const
+{
+    return m_stats;
+}
+
+BufferManager & BufferManager::Default()
+{
+    static BufferManager manager;
+    return manager;
+}
+
+GLuint BufferManager::createBuffer(GLenum target, std::size_t size,
+    void const * data, GLenum usage)
+{
+    GLuint buffer = 0;
+
+    glGenBuffers(1, &buffer);
+
+    glBindBuffer(target, buffer);
+    glBufferData(target, size, data, usage);
+    glBindBuffer(target, 0);
+
+    ++m_stats.buffers;
+    m_stats.allocatedBytes += size;
+    m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.allocatedBytes);
+
+    return buffer;
+}
+
+void BufferManager::deleteBuffer(GLuint buffer, std::size_t size)
+{
+    glDeleteBuffers(1, &buffer);
+
+    --m_stats.buffers;
+    m_stats.allocatedBytes -= size;
+}
+
+BufferManager::Ring & BufferManager::ring(GLenum target)
+{
+    for(auto & r : m_rings)
+    {
+        if(r.target == target) return r;
+    }
+
+    auto const buffer = createBuffer(target, m_streamSize, nullptr, GL_STREAM_DRAW);
+
+    m_rings.push_back({ target, buffer, m_streamSize, 0 });
+
+    return m_rings.back();
+}
+
+}
@@ -3,6 +3,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <Camera.hpp>
+#include <Heightfield.hpp>
 
 namespace RPi {
 
@@ -10,7 +11,8 @@ Camera::Camera(glm::vec3 const & position, glm::vec3 const & t, glm::vec3 const
     float sensibility, float speed):
     m_phi(0), m_theta(0), m_position(position), m_target(t), m_up(up),
     m_orientation(), m_sideShift(), m_modelview(), m_sensibility(sensibility),
-    m_speed(speed), m_mouseEnabled(true), m_needUpdateMV(true)
+    m_speed(speed), m_mouseEnabled(true), m_terrain(nullptr), m_clearance(1.f),
+    m_followTerrain(false), m_needUpdateMV(true)
 {
     target(t);
     m_sideShift = glm::normalize(glm::cross(m_up, m_orientation));
@@ -30,6 +32,8 @@ glm::mat4 const & Camera::lookAt()
 
 void Camera::move(Input const & input)
 {
+    auto const previous = m_position;
+
     if(m_mouseEnabled && input.mouseMoved())
     {
         this->orient(static_cast<float>(input.getXRel()),
@@ -66,6 +70,8 @@ void Camera::move(Input const & input)
         m_position -= m_up * m_speed;
     }
 
+    collide(previous);
+
     m_target = m_position + m_orientation;
     m_needUpdateMV = true;
 }
@@ -169,6 +175,39 @@ bool Camera::isMouseEnabled() const
     return m_mouseEnabled;
 }
 
+void Camera::followTerrain(Heightfield const * heightfield, float clearance,
+    bool follow)
+{
+    m_terrain = heightfield;
+    m_clearance = clearance;
+    m_followTerrain = follow;
+}
+
+void Camera::collide(glm::vec3 const & previous)
+{
+    if(m_terrain == nullptr) return;
+
+    // Stay above the ground
+    auto const ground = m_terrain->heightAt(m_position.x, m_position.z) + m_clearance;
+
+    if(m_followTerrain || m_position.y < ground)
+    {
+        m_position.y = ground;
+    }
+
+    if(m_followTerrain || m_position == previous) return;
+
+    // Both ends of the move are above the ground : a hit in between means
+    // that the camera would go through a ridge
+    auto const offset = glm::vec3(0.f, m_clearance - 1e-3f, 0.f);
+    glm::vec3 hit;
+
+    if(m_terrain->intersect(previous - offset, m_position - offset, hit))
+    {
+        m_position = previous;
+    }
+}
+
 void Camera::orient(float xRel, float yRel)
 {
     m_phi += -yRel * m_sensibility;
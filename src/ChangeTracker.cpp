@@ -0,0 +1,68 @@
+#include <glm/gtc/type_ptr.hpp>
+
+#include <ChangeTracker.hpp>
+
+namespace RPi {
+
+ChangeTracker::ChangeTracker():
+    m_inputs(), m_presented(), m_invalid(true), m_presentedFrames(0), m_skippedFrames(0)
+{
+
+}
+
+void ChangeTracker::begin()
+{
+    m_inputs.clear();
+}
+
+void ChangeTracker::track(glm::mat4 const & matrix)
+{
+    track(glm::value_ptr(matrix), sizeof(matrix));
+}
+
+void ChangeTracker::track(float value)
+{
+    track(&value, sizeof(value));
+}
+
+void ChangeTracker::track(void const * data, std::size_t size)
+{
+    auto const bytes = static_cast<std::uint8_t const *>(data);
+
+    m_inputs.insert(m_inputs.end(), bytes, bytes + size);
+}
+
+void ChangeTracker::invalidate()
+{
+    m_invalid = true;
+}
+
+bool ChangeTracker::changed() const
+{
+    return m_invalid || m_inputs != m_presented;
+}
+
+void ChangeTracker::presented()
+{
+    // The next begin() clears the previous reference
+    m_presented.swap(m_inputs);
+    m_invalid = false;
+    ++m_presentedFrames;
+}
+
+void ChangeTracker::skipped()
+{
+    ++m_skippedFrames;
+}
+
+std::size_t ChangeTracker::presentedFrames() const
+{
+    return m_presentedFrames;
+}
+
+std::size_t ChangeTracker::skippedFrames() const
+{
+    return m_skippedFrames;
+}
+
+}
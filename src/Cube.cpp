@@ -1,150 +1,149 @@
-#include <iostream>
 #include <glm/gtx/transform.hpp>
 
+#include <BufferManager.hpp>
 #include <Cube.hpp>
 #include <OpenGL.hpp>
-//#include <OpenGLHeaders.hpp>
+#include <RenderQueue.hpp>
+#include <TransformStore.hpp>
+#include <VertexFormat.hpp>
 
 namespace RPi {
 
-Cube::Cube(float size):
-    m_vao(0), m_vbo(0), m_vboIndices(0), m_transform()
-{
-    size /= 2;
+namespace {
 
-    //float verticesTmp[] = { 1.0f,  1.0f,  1.0f, // Vertex 0 (X, Y, Z)
-        //-1.0f,  1.0f,  1.0f, // Vertex 1 (X, Y, Z)
-        //-1.0f, -1.0f,  1.0f, // Vertex 2 (X, Y, Z)
-         //1.0f, -1.0f,  1.0f, // Vertex 3 (X, Y, Z)
-         //1.0f,  1.0f, -1.0f, // Vertex 4 (X, Y, Z)
-        //-1.0f,  1.0f, -1.0f, // Vertex 5 (X, Y, Z)
-        //-1.0f, -1.0f, -1.0f, // Vertex 6 (X, Y, Z)
-         //1.0f, -1.0f, -1.0f  // Vertex 7 (X, Y, Z)
-    //};
+    VertexFormat const & cube_format()
+    {
+        static VertexFormat const format =
+            VertexFormat::P16(PositionEncoding::Snorm16);
+        return format;
+    }
 
+    // -------------------------------------------------------------------------
+    //  Unit cube centered on the origin, shared by every cube
+    // -------------------------------------------------------------------------
+    struct Geometry
+    {
+        Geometry();
+        ~Geometry();
 
-    float verticesTmp[] = {-size, -size, -size,    size, -size, -size,   size, size, -size,     // Face 1
-                       -size, -size, -size,   -size, size, -size,    size, size, -size,     // Face 1
+        PositionQuantizer quantizer;
+        BufferRange vertices;
+    };
 
-                        size, -size, size,     size, -size, -size,   size, size, -size,     // Face 2
-                        size, -size, size,     size, size, size,     size, size, -size,     // Face 2
+    Geometry::Geometry():
+        quantizer(glm::vec3(-0.5f), glm::vec3(0.5f)), vertices()
+    {
+        float const s = 0.5f;
 
-                       -size, -size, size,     size, -size, size,    size, -size, -size,    // Face 3
-                       -size, -size, size,    -size, -size, -size,   size, -size, -size,    // Face 3
+        float const positions[] = {
+            -s, -s, -s,    s, -s, -s,    s,  s, -s,     // Face 1
+            -s, -s, -s,   -s,  s, -s,    s,  s, -s,     // Face 1
 
-                       -size, -size, size,     size, -size, size,    size, size, size,      // Face 4
-                       -size, -size, size,    -size, size, size,     size, size, size,      // Face 4
+             s, -s,  s,    s, -s, -s,    s,  s, -s,     // Face 2
+             s, -s,  s,    s,  s,  s,    s,  s, -s,     // Face 2
 
-                       -size, -size, -size,   -size, -size, size,   -size, size, size,      // Face 5
-                       -size, -size, -size,   -size, size, -size,   -size, size, size,      // Face 5
+            -s, -s,  s,    s, -s,  s,    s, -s, -s,     // Face 3
+            -s, -s,  s,   -s, -s, -s,    s, -s, -s,     // Face 3
 
-                       -size, size, size,      size, size, size,     size, size, -size,     // Face 6
-                       -size, size, size,     -size, size, -size,    size, size, -size};    // Face 6 */
+            -s, -s,  s,    s, -s,  s,    s,  s,  s,     // Face 4
+            -s, -s,  s,   -s,  s,  s,    s,  s,  s,     // Face 4
 
-    float colorsTmp[] = {1.0, 0.0, 0.0,   1.0, 0.0, 0.0,   1.0, 0.0, 0.0,     // Face 1
-                     1.0, 0.0, 0.0,   1.0, 0.0, 0.0,   1.0, 0.0, 0.0,     // Face 1
+            -s, -s, -s,   -s, -s,  s,   -s,  s,  s,     // Face 5
+            -s, -s, -s,   -s,  s, -s,   -s,  s,  s,     // Face 5
 
-                     0.0, 1.0, 0.0,   0.0, 1.0, 0.0,   0.0, 1.0, 0.0,     // Face 2
-                     0.0, 1.0, 0.0,   0.0, 1.0, 0.0,   0.0, 1.0, 0.0,     // Face 2
+            -s,  s,  s,    s,  s,  s,    s,  s, -s,     // Face 6
+            -s,  s,  s,   -s,  s, -s,    s,  s, -s      // Face 6
+        };
 
-                     0.0, 0.0, 1.0,   0.0, 0.0, 1.0,   0.0, 0.0, 1.0,     // Face 3
-                     0.0, 0.0, 1.0,   0.0, 0.0, 1.0,   0.0, 0.0, 1.0,     // Face 3
+        // Positions only : shader.vs colors the cubes from their positions
+        Vertex::P16 data[36];
 
-                     1.0, 0.0, 0.0,   1.0, 0.0, 0.0,   1.0, 0.0, 0.0,     // Face 4
-                     1.0, 0.0, 0.0,   1.0, 0.0, 0.0,   1.0, 0.0, 0.0,     // Face 4
+        for(int i = 0; i < 36; ++i)
+        {
+            quantizer.encode(glm::vec3(positions[3 * i], positions[3 * i + 1],
+                positions[3 * i + 2]), data[i].position);
+        }
 
-                     0.0, 1.0, 0.0,   0.0, 1.0, 0.0,   0.0, 1.0, 0.0,     // Face 5
-                     0.0, 1.0, 0.0,   0.0, 1.0, 0.0,   0.0, 1.0, 0.0,     // Face 5
+        vertices = BufferManager::Default().allocate(GL_ARRAY_BUFFER,
+            data, sizeof(data));
+    }
 
-                     0.0, 0.0, 1.0,   0.0, 0.0, 1.0,   0.0, 0.0, 1.0,     // Face 6
-                     0.0, 0.0, 1.0,   0.0, 0.0, 1.0,   0.0, 0.0, 1.0};    // Face 6
+    Geometry::~Geometry()
+    {
+        BufferManager::Default().release(vertices);
+    }
 
-    for(int i = 0; i < 108; ++i)
+    // Created on first use, once a context is current
+    Geometry const & geometry()
     {
-        m_vertices[i] = verticesTmp[i];
-        m_colors[i]   = colorsTmp[i];
+        static Geometry const g;
+        return g;
     }
-    // Create Vertex Array Object
-    //GLuint vao;
-    //glGenVertexArrays(1, &m_vao);
-    //glBindVertexArray(m_vao);
-
-    // Create a Vertex Buffer Object and copy the vertex data to it
-    //GLuint vbo;
-    glGenBuffers(1, &m_vbo);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, 108 * sizeof(float), m_vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    //glEnableVertexAttribArray(0);
-    //glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, static_cast<void *>(nullptr));
-
-    //glBindVertexArray(0);
-    
-
-    GLuint indices[] = {
-        0, 1,
-        1, 2,
-        2, 3,
-        3, 0,
-        4, 5,
-        5, 6,
-        6, 7,
-        7, 4,
-        0, 4,
-        1, 5,
-        2, 6,
-        3, 7
-    };
 
-    glGenBuffers(1, &m_vboIndices);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vboIndices);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, 24 * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
-        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, 24 * sizeof(unsigned int), indices);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
+    void bind(GLSLProgram const & program, glm::mat4 const & projection)
+    {
+        auto const & g = geometry();
 
-Cube::~Cube()
-{
-    //glDeleteBuffers(GL_ARRAY_BUFFER, &m_vbo);
-    //glDeleteBuffers(GL_ELEMENT_ARRAY_BUFFER, &m_vboIndices);
-    //glDeleteVertexArrays(1, &m_vao);
-}
+        program.bind();
 
-void Cube::render(GLSLProgram const & program, glm::mat4 & projection, glm::mat4 & modelView)
-{
-    program.bind();
+        glBindBuffer(GL_ARRAY_BUFFER, g.vertices.buffer);
+        cube_format().enable(g.vertices.offset);
 
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        //glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vboIndices);
+        program.sendMatrix("MatProjection", projection);
+        g.quantizer.send(program);
+    }
 
-        glVertexAttribPointer(OpenGL::AttributeIndex[Enums::AttributeIndex_Position],
-            3, GL_FLOAT, GL_FALSE, 0, 0);
-        //glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, m_vertices);
-        glEnableVertexAttribArray(0);
+    void unbind(GLSLProgram const & program)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        cube_format().disable();
 
-        program.sendMatrix("MatProjection", projection);
-        program.sendMatrix("MatModelView", modelView * m_transform);
+        program.unbind();
+    }
 
+    // Draw of the unit cube, without its model-view matrix
+    DrawItem draw_item(GLSLProgram const & program)
+    {
+        auto const & g = geometry();
 
-        //glDrawElements(GL_LINE_STRIP, 12, GL_UNSIGNED_INT, static_cast<void *>(nullptr));
+        DrawItem item;
 
+        item.program = &program;
+        item.vertexBuffer = g.vertices.buffer;
+        item.vertexOffset = g.vertices.offset;
+        item.format = &cube_format();
+        item.mode = GL_LINE_STRIP;
+        item.count = 36;
 
-        //glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, m_colors);
-        //glEnableVertexAttribArray(1);
-        //glDrawArrays(GL_TRIANGLES, 0, 36);
+        item.setup = [](GLSLProgram const & p)
+        {
+            geometry().quantizer.send(p);
+        };
+        item.object = &g;
 
-        glDrawArrays(GL_LINE_STRIP, 0, 108 / 3);
-        //glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return item;
+    }
+}
 
+Cube::Cube(float size):
+    m_transform(1.f), m_scale(glm::scale(glm::mat4(1.f), glm::vec3(size)))
+{
+    geometry();
+}
+
+Cube::~Cube()
+{
+
+}
 
+void Cube::render(GLSLProgram const & program, glm::mat4 & projection, glm::mat4 & modelView)
+{
+    bind(program, projection);
 
-        //glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
+        program.sendMatrix("MatModelView", modelView * m_transform * m_scale);
+        glDrawArrays(GL_LINE_STRIP, 0, 36);
 
-    program.unbind();
+    unbind(program);
 }
 
 void Cube::rotate(float angle, glm::vec3 const & axis)
@@ -157,4 +156,42 @@ void Cube::translate(glm::vec3 const & axis)
     m_transform = glm::translate(m_transform, axis);
 }
 
+void Cube::Render(GLSLProgram const & program, glm::mat4 const & projection,
+    TransformStore const & transforms)
+{
+    bind(program, projection);
+
+        for(std::size_t i = 0; i < transforms.size(); ++i)
+        {
+            program.sendMatrix("MatModelView", transforms.modelView(i));
+            glDrawArrays(GL_LINE_STRIP, 0, 36);
+        }
+
+    unbind(program);
+}
+
+void Cube::Queue(RenderQueue & queue, GLSLProgram const & program,
+    TransformStore const & transforms)
+{
+    auto item = draw_item(program);
+
+    for(std::size_t i = 0; i < transforms.size(); ++i)
+    {
+        item.modelView = transforms.modelView(i);
+        queue.add(item);
+    }
+}
+
+void Cube::Queue(RenderQueue & queue, GLSLProgram const & program,
+    TransformStore const & transforms, glm::mat4 const & view)
+{
+    auto item = draw_item(program);
+
+    for(std::size_t i = 0; i < transforms.size(); ++i)
+    {
+        item.modelView = view * transforms.model(i);
+        queue.add(item);
+    }
+}
+
 }
@@ -0,0 +1,278 @@
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#include <EGLConfigSelector.hpp>
+
+namespace RPi {
+
+namespace {
+
+    // Penalty of every extra bit or sample : the color and the samples are
+    // read and written by every fragment, depth and stencil only when tested
+    int const COLOR_BIT   = 8;
+    int const ALPHA_BIT   = 4;
+    int const DEPTH_BIT   = 2;
+    int const STENCIL_BIT = 2;
+    int const SAMPLE      = 32;
+    int const SLOW_CONFIG = 1000;
+
+    std::mutex s_mutex;
+
+    // Config id chosen for (display, request key)
+    std::map<std::pair<EGLDisplay, std::string>, EGLint> s_chosen;
+
+    // "Broadcom 1.4", identifies the configs of a display across runs
+    std::string driver_name(EGLDisplay display)
+    {
+        auto const vendor = eglQueryString(display, EGL_VENDOR);
+        auto const version = eglQueryString(display, EGL_VERSION);
+
+        std::string name = vendor != nullptr ? vendor : "?";
+        name += " ";
+        name += version != nullptr ? version : "?";
+
+        return name;
+    }
+
+    // Lines "<request key> <config id> <driver>"
+    bool load_cached(std::string const & filename, std::string const & key,
+        std::string const & driver, EGLint & id)
+    {
+        std::ifstream file(filename);
+
+        std::string line;
+
+        while(std::getline(file, line))
+        {
+            std::istringstream in(line);
+
+            std::string lineKey;
+            EGLint lineId = 0;
+
+            if(!(in >> lineKey >> lineId) || lineKey != key) continue;
+
+            std::string lineDriver;
+            std::getline(in >> std::ws, lineDriver);
+
+            if(lineDriver == driver)
+            {
+                id = lineId;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool save_cached(std::string const & filename, std::string const & key,
+        std::string const & driver, EGLint id)
+    {
+        std::vector<std::string> lines;
+
+        {
+            std::ifstream file(filename);
+
+            std::string line;
+
+            while(std::getline(file, line))
+            {
+                std::istringstream in(line);
+
+                std::string lineKey;
+                EGLint lineId = 0;
+                std::string lineDriver;
+
+                if(!(in >> lineKey >> lineId)) continue;
+
+                std::getline(in >> std::ws, lineDriver);
+
+                if(lineKey != key || lineDriver != driver) lines.push_back(line);
+            }
+        }
+
+        std::ofstream file(filename, std::ios::trunc);
+
+        if(!file)
+        {
+            std::cerr << "EGLConfigSelector : Failed to write " << filename << std::endl;
+            return false;
+        }
+
+        for(auto const & line : lines) file << line << "\n";
+
+        file << key << " " << id << " " << driver << std::endl;
+
+        return true;
+    }
+
+    // The config of the given id if it still serves the request
+    bool config_by_id(EGLDisplay display, EGLint id, EGLConfigRequest const & request,
+        EGLConfigInfo & chosen)
+    {
+        EGLint const attribList[] = { EGL_CONFIG_ID, id, EGL_NONE };
+
+        EGLConfig config;
+        EGLint nbConfigs = 0;
+
+        if(eglChooseConfig(display, attribList, &config, 1, &nbConfigs) == EGL_FALSE ||
+           nbConfigs != 1)
+        {
+            return false;
+        }
+
+        auto const info = EGLIntrospection::QueryConfig(display, config);
+
+        if(info.id != id || EGLConfigSelector::Score(info, request) < 0) return false;
+
+        chosen = info;
+
+        return true;
+    }
+}
+
+EGLConfigRequest EGLConfigRequest::FillRate()
+{
+    return { 16, 0, 0, 0, 0 };
+}
+
+EGLConfigRequest EGLConfigRequest::Quality()
+{
+    return { 24, 0, 24, 0, 4 };
+}
+
+std::string EGLConfigRequest::key() const
+{
+    std::ostringstream out;
+    out << "c" << colorBits << "a" << alphaBits << "d" << depthBits
+        << "s" << stencilBits << "m" << samples;
+    return out.str();
+}
+
+std::string EGLConfigSelector::s_cacheFile = "";
+
+int EGLConfigSelector::Score(EGLConfigInfo const & info, EGLConfigRequest const & request)
+{
+    auto const colorBits = info.red + info.green + info.blue;
+
+    if(!(info.surfaceType & EGL_WINDOW_BIT) ||
+       !(info.renderableType & EGL_OPENGL_ES2_BIT) ||
+       info.caveat == EGL_NON_CONFORMANT_CONFIG ||
+       colorBits < request.colorBits ||
+       info.alpha < request.alphaBits ||
+       info.depth < request.depthBits ||
+       info.stencil < request.stencilBits ||
+       info.samples < request.samples)
+    {
+        return -1;
+    }
+
+    auto score = 0;
+
+    score += (colorBits - request.colorBits) * COLOR_BIT;
+    score += (info.alpha - request.alphaBits) * ALPHA_BIT;
+    score += (info.depth - request.depthBits) * DEPTH_BIT;
+    score += (info.stencil - request.stencilBits) * STENCIL_BIT;
+    score += (info.samples - request.samples) * SAMPLE;
+
+    if(info.caveat == EGL_SLOW_CONFIG) score += SLOW_CONFIG;
+
+    return score;
+}
+
+bool EGLConfigSelector::Select(std::vector<EGLConfigInfo> const & configs,
+    EGLConfigRequest const & request, EGLConfigInfo & chosen)
+{
+    auto best = -1;
+    EGLConfigInfo const * bestInfo = nullptr;
+
+    for(auto const & info : configs)
+    {
+        auto const score = Score(info, request);
+
+        if(score < 0) continue;
+
+        if(bestInfo == nullptr || score < best || (score == best && info.id < bestInfo->id))
+        {
+            best = score;
+            bestInfo = &info;
+        }
+    }
+
+    if(bestInfo == nullptr) return false;
+
+    chosen = *bestInfo;
+
+    return true;
+}
+
+bool EGLConfigSelector::Choose(EGLDisplay display, EGLConfigRequest const & request,
+    EGLConfigInfo & chosen)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    auto const key = request.key();
+    auto const driver = driver_name(display);
+
+    EGLint id = 0;
+
+    auto const cached = s_chosen.find(std::make_pair(display, key));
+
+    if(cached != s_chosen.end())
+    {
+        id = cached->second;
+    }
+    else if(!s_cacheFile.empty())
+    {
+        load_cached(s_cacheFile, key, driver, id);
+    }
+
+    // A cached id that no longer serves the request (new driver, edited
+    // file) falls back to the full selection
+    if(id != 0 && config_by_id(display, id, request, chosen))
+    {
+        s_chosen[std::make_pair(display, key)] = chosen.id;
+
+        std::cout << "EGL config " << EGLIntrospection::Describe(chosen)
+                  << " (cached)" << std::endl;
+
+        return true;
+    }
+
+    auto const configs = EGLIntrospection::QueryConfigs(display);
+
+    if(!Select(configs, request, chosen))
+    {
+        std::cerr << "EGLConfigSelector::Choose : None of the " << configs.size()
+                  << " configs serves " << key << std::endl;
+        return false;
+    }
+
+    s_chosen[std::make_pair(display, key)] = chosen.id;
+
+    if(!s_cacheFile.empty()) save_cached(s_cacheFile, key, driver, chosen.id);
+
+    std::cout << "EGL config " << EGLIntrospection::Describe(chosen) << " (best of "
+              << configs.size() << ")" << std::endl;
+
+    return true;
+}
+
+void EGLConfigSelector::SetCacheFile(std::string const & filename)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    s_cacheFile = filename;
+}
+
+void EGLConfigSelector::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    s_chosen.clear();
+}
+
+}
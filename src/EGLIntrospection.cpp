@@ -11,6 +11,7 @@ namespace
     int s_minorVersion = 0;
     std::string s_version = "";
     std::string s_config  = "";
+    std::vector<RPi::EGLConfigInfo> s_configs;
 
     // =========================================================================
     //   Initialization and introspection functions
@@ -43,95 +44,57 @@ namespace
         s_version = version.str();
     }
 
-    void get_config()
+    EGLint get_attrib(EGLDisplay display, EGLConfig config, EGLint attribute)
     {
+        EGLint value = 0;
+        eglGetConfigAttrib(display, config, attribute, &value);
+        return value;
+    }
 
-        std::ostringstream info;
-
-        EGLint nbConfigs;
-
-        // Get the number of configs
-        auto config = eglGetConfigs(s_display, nullptr, 0, &nbConfigs);
-        assert(config != EGL_FALSE);
-
-        std::vector<EGLConfig> configs;
-        configs.resize(nbConfigs);
+    char const * caveat_name(EGLint caveat)
+    {
+        switch(caveat)
+        {
+            case EGL_NONE : return "EGL_NONE";
+            case EGL_SLOW_CONFIG : return "EGL_SLOW_CONFIG";
+            case EGL_NON_CONFORMANT_CONFIG : return "EGL_NON_CONFORMANT_CONFIG";
+            default : return "?";
+        }
+    }
 
-        config = eglGetConfigs(s_display, &configs[0], nbConfigs, &nbConfigs);
-        assert(config != EGL_FALSE);
+    void get_config()
+    {
+        s_configs = RPi::EGLIntrospection::QueryConfigs(s_display);
 
-        EGLint value;
+        std::ostringstream info;
 
-        for(auto i = 0; i < nbConfigs; ++i)
+        for(std::size_t i = 0; i < s_configs.size(); ++i)
         {
+            auto const & c = s_configs[i];
+
             info << "============" << "\n";
             info << " Config #" << i << "\n";
             info << "============" << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_BUFFER_SIZE, &value);
-            info << "Buffer Size " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_RED_SIZE, &value);
-            info << "Red Size " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_GREEN_SIZE, &value);
-            info << "Green Size " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_BLUE_SIZE, &value);
-            info << "Blue Size " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_ALPHA_SIZE, &value);
-            info << "Alpha Size " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_CONFIG_CAVEAT, &value);
-            switch(value)
-            {
-                case EGL_NONE :
-                    info << "Config caveat  EGL_NONE\n";
-                    break;
-                case EGL_SLOW_CONFIG :
-                    info << "Config caveat  EGL_SLOW_CONFIG\n";
-                    break;
-
-                default : break;
-            }
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_CONFIG_ID, &value);
-            info << "Config ID " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_DEPTH_SIZE, &value);
-            info << "Depth size " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_MAX_PBUFFER_WIDTH, &value);
-            info << "Max pbuffer width " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_MAX_PBUFFER_HEIGHT, &value);
-            info << "Max pbuffer height " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_MAX_PBUFFER_PIXELS, &value);
-            info << "Max pbuffer pixels " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_NATIVE_RENDERABLE, &value);
-            info << "Native renderable " << (value ? "true" : "false") << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_NATIVE_VISUAL_ID, &value);
-            info << "Native visual ID " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_NATIVE_VISUAL_TYPE, &value);
-            info << "Native visual type " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_SAMPLE_BUFFERS, &value);
-            info << "Sample Buffers " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_SAMPLES, &value);
-            info << "Samples " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_SURFACE_TYPE, &value);
-            info << "Surface type " << value << "\n";
-
-            eglGetConfigAttrib(s_display, configs[i], EGL_TRANSPARENT_TYPE, &value);
-            info << "Transparent type " << value << "\n";
-
+            info << "Buffer Size " << c.bufferSize << "\n";
+            info << "Red Size " << c.red << "\n";
+            info << "Green Size " << c.green << "\n";
+            info << "Blue Size " << c.blue << "\n";
+            info << "Alpha Size " << c.alpha << "\n";
+            info << "Config caveat  " << caveat_name(c.caveat) << "\n";
+            info << "Config ID " << c.id << "\n";
+            info << "Depth size " << c.depth << "\n";
+            info << "Stencil size " << c.stencil << "\n";
+            info << "Max pbuffer width " << c.maxPbufferWidth << "\n";
+            info << "Max pbuffer height " << c.maxPbufferHeight << "\n";
+            info << "Max pbuffer pixels " << c.maxPbufferPixels << "\n";
+            info << "Native renderable " << (c.nativeRenderable ? "true" : "false") << "\n";
+            info << "Native visual ID " << c.nativeVisualId << "\n";
+            info << "Native visual type " << c.nativeVisualType << "\n";
+            info << "Sample Buffers " << c.sampleBuffers << "\n";
+            info << "Samples " << c.samples << "\n";
+            info << "Surface type " << c.surfaceType << "\n";
+            info << "Renderable type " << c.renderableType << "\n";
+            info << "Transparent type " << c.transparentType << "\n";
             info << "\n";
         }
 
@@ -190,4 +153,85 @@ std::string EGLIntrospection::GetConfig()
 
     return s_config;
 }
+
+std::vector<EGLConfigInfo> const & EGLIntrospection::GetConfigs()
+{
+    // EGLInstropection module must be initialized
+    assert(s_initialized);
+
+    return s_configs;
+}
+
+std::vector<EGLConfigInfo> EGLIntrospection::QueryConfigs(EGLDisplay display)
+{
+    std::vector<EGLConfigInfo> infos;
+
+    EGLint nbConfigs = 0;
+
+    // Get the number of configs
+    if(eglGetConfigs(display, nullptr, 0, &nbConfigs) == EGL_FALSE || nbConfigs <= 0)
+    {
+        return infos;
+    }
+
+    std::vector<EGLConfig> configs(nbConfigs);
+
+    if(eglGetConfigs(display, &configs[0], nbConfigs, &nbConfigs) == EGL_FALSE)
+    {
+        return infos;
+    }
+
+    infos.reserve(nbConfigs);
+
+    for(auto i = 0; i < nbConfigs; ++i)
+    {
+        infos.push_back(QueryConfig(display, configs[i]));
+    }
+
+    return infos;
+}
+
+EGLConfigInfo EGLIntrospection::QueryConfig(EGLDisplay display, EGLConfig config)
+{
+    EGLConfigInfo info;
+
+    info.config           = config;
+    info.id               = get_attrib(display, config, EGL_CONFIG_ID);
+    info.bufferSize       = get_attrib(display, config, EGL_BUFFER_SIZE);
+    info.red              = get_attrib(display, config, EGL_RED_SIZE);
+    info.green            = get_attrib(display, config, EGL_GREEN_SIZE);
+    info.blue             = get_attrib(display, config, EGL_BLUE_SIZE);
+    info.alpha            = get_attrib(display, config, EGL_ALPHA_SIZE);
+    info.depth            = get_attrib(display, config, EGL_DEPTH_SIZE);
+    info.stencil          = get_attrib(display, config, EGL_STENCIL_SIZE);
+    info.sampleBuffers    = get_attrib(display, config, EGL_SAMPLE_BUFFERS);
+    info.samples          = get_attrib(display, config, EGL_SAMPLES);
+    info.caveat           = get_attrib(display, config, EGL_CONFIG_CAVEAT);
+    info.surfaceType      = get_attrib(display, config, EGL_SURFACE_TYPE);
+    info.renderableType   = get_attrib(display, config, EGL_RENDERABLE_TYPE);
+    info.nativeRenderable = get_attrib(display, config, EGL_NATIVE_RENDERABLE);
+    info.nativeVisualId   = get_attrib(display, config, EGL_NATIVE_VISUAL_ID);
+    info.nativeVisualType = get_attrib(display, config, EGL_NATIVE_VISUAL_TYPE);
+    info.maxPbufferWidth  = get_attrib(display, config, EGL_MAX_PBUFFER_WIDTH);
+    info.maxPbufferHeight = get_attrib(display, config, EGL_MAX_PBUFFER_HEIGHT);
+    info.maxPbufferPixels = get_attrib(display, config, EGL_MAX_PBUFFER_PIXELS);
+    info.transparentType  = get_attrib(display, config, EGL_TRANSPARENT_TYPE);
+
+    return info;
+}
+
+std::string EGLIntrospection::Describe(EGLConfigInfo const & info)
+{
+    std::ostringstream out;
+
+    out << "#" << info.id
+        << " RGBA " << info.red << info.green << info.blue << info.alpha
+        << " depth " << info.depth
+        << " stencil " << info.stencil
+        << " samples " << info.samples;
+
+    if(info.caveat != EGL_NONE) out << " " << caveat_name(info.caveat);
+
+    return out.str();
+}
 }
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <Flythrough.hpp>
+
+namespace RPi {
+
+namespace {
+
+    // Uniform Catmull-Rom spline between p1 and p2
+    glm::vec3 catmull_rom(glm::vec3 const & p0, glm::vec3 const & p1,
+        glm::vec3 const & p2, glm::vec3 const & p3, float t)
+    {
+        auto const t2 = t * t;
+        auto const t3 = t2 * t;
+
+        return 0.5f * ((2.f * p1) + (p2 - p0) * t
+            + (2.f * p0 - 5.f * p1 + 4.f * p2 - p3) * t2
+            + (3.f * p1 - p0 - 3.f * p2 + p3) * t3);
+    }
+
+    // Value of sorted <v> at the percentile p
+    float percentile(std::vector<float> const & v, float p)
+    {
+        auto const i = static_cast<std::size_t>(p * static_cast<float>(v.size() - 1) + 0.5f);
+        return v[std::min(i, v.size() - 1)];
+    }
+}
+
+// =============================================================================
+//   CameraPath
+// =============================================================================
+
+CameraPath::CameraPath():
+    m_keyframes(), m_segments()
+{
+
+}
+
+bool CameraPath::load(std::string const & filename)
+{
+    std::ifstream file(filename);
+
+    if(!file)
+    {
+        std::cerr << "CameraPath::load : Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    m_keyframes.clear();
+    m_segments.clear();
+
+    std::string line;
+    std::size_t number = 0;
+
+    while(std::getline(file, line))
+    {
+        ++number;
+
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream ss(line);
+        Keyframe k;
+
+        if(!(ss >> k.time))
+        {
+            // Empty line
+            if(ss.eof() && line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+            std::cerr << "CameraPath::load : " << filename << ":" << number
+                      << " : time expected" << std::endl;
+            return false;
+        }
+
+        auto & p = k.pose.position;
+        auto & t = k.pose.target;
+
+        if(!(ss >> p.x >> p.y >> p.z >> t.x >> t.y >> t.z))
+        {
+            std::cerr << "CameraPath::load : " << filename << ":" << number
+                      << " : position and target expected" << std::endl;
+            return false;
+        }
+
+        if(!m_keyframes.empty() && k.time <= m_keyframes.back().time)
+        {
+            std::cerr << "CameraPath::load : " << filename << ":" << number
+                      << " : keyframes must be sorted by time" << std::endl;
+            return false;
+        }
+
+        std::string name;
+        std::getline(ss >> std::ws, name);
+        name = name.substr(0, name.find_last_not_of(" \t\r") + 1);
+
+        if(!name.empty() || m_segments.empty())
+        {
+            m_segments.push_back(name.empty() ? "path" : name);
+        }
+
+        k.segment = m_segments.size() - 1;
+        m_keyframes.push_back(k);
+    }
+
+    if(m_keyframes.size() < 2)
+    {
+        std::cerr << "CameraPath::load : " << filename
+                  << " : at least two keyframes are needed" << std::endl;
+        return false;
+    }
+
+    // The path starts at 0
+    auto const start = m_keyframes.front().time;
+    for(auto & k : m_keyframes) k.time -= start;
+
+    return true;
+}
+
+CameraPose CameraPath::pose(float t) const
+{
+    auto const & k = m_keyframes;
+
+    t = std::min(std::max(t, k.front().time), k.back().time);
+
+    // Keyframe i such that k[i].time <= t < k[i + 1].time
+    auto const next = std::upper_bound(k.begin(), k.end(), t,
+        [](float time, Keyframe const & key) { return time < key.time; });
+
+    auto const i1 = std::min<std::size_t>(
+        static_cast<std::size_t>(std::max<std::ptrdiff_t>(next - k.begin() - 1, 0)),
+        k.size() - 2);
+    auto const i0 = i1 > 0 ? i1 - 1 : i1;
+    auto const i2 = i1 + 1;
+    auto const i3 = std::min(i2 + 1, k.size() - 1);
+
+    auto const u = (t - k[i1].time) / (k[i2].time - k[i1].time);
+
+    CameraPose pose;
+    pose.position = catmull_rom(k[i0].pose.position, k[i1].pose.position,
+        k[i2].pose.position, k[i3].pose.position, u);
+    pose.target = catmull_rom(k[i0].pose.target, k[i1].pose.target,
+        k[i2].pose.target, k[i3].pose.target, u);
+
+    return pose;
+}
+
+std::size_t CameraPath::segment(float t) const
+{
+    auto const next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), t,
+        [](float time, Keyframe const & key) { return time < key.time; });
+
+    return next == m_keyframes.begin() ? 0 : (next - 1)->segment;
+}
+
+std::vector<std::string> const & CameraPath::segments() const
+{
+    return m_segments;
+}
+
+float CameraPath::duration() const
+{
+    return m_keyframes.empty() ? 0.f : m_keyframes.back().time;
+}
+
+std::vector<float> CameraPath::times() const
+{
+    std::vector<float> times;
+    times.reserve(m_keyframes.size());
+
+    for(auto const & keyframe : m_keyframes)
+    {
+        times.push_back(keyframe.time);
+    }
+
+    return times;
+}
+
+// =============================================================================
+//   FrameTimeStats
+// =============================================================================
+
+FrameTimeStats::FrameTimeStats(std::vector<std::string> const & segments):
+    m_names(segments), m_times(segments.size())
+{
+
+}
+
+void FrameTimeStats::reserve(std::size_t frames)
+{
+    for(auto & times : m_times)
+    {
+        times.reserve(frames);
+    }
+}
+
+void FrameTimeStats::add(std::size_t segment, float ms)
+{
+    if(segment < m_times.size())
+    {
+        m_times[segment].push_back(ms);
+    }
+}
+
+void FrameTimeStats::report(std::ostream & out) const
+{
+    char line[256];
+
+    std::snprintf(line, sizeof(line), "%-20s %7s %9s %9s %9s %9s %9s %8s\n",
+        "segment", "frames", "mean ms", "p50 ms", "p95 ms", "p99 ms", "max ms", "FPS");
+    out << line;
+
+    std::vector<float> all;
+
+    auto const print = [&](std::string const & name, std::vector<float> times)
+    {
+        if(times.empty()) return;
+
+        std::sort(times.begin(), times.end());
+
+        double sum = 0.0;
+        for(auto t : times) sum += t;
+
+        auto const mean = sum / static_cast<double>(times.size());
+
+        std::snprintf(line, sizeof(line), "%-20s %7zu %9.3f %9.3f %9.3f %9.3f %9.3f %8.1f\n",
+            name.c_str(), times.size(), mean, percentile(times, 0.5f),
+            percentile(times, 0.95f), percentile(times, 0.99f), times.back(),
+            mean > 0.0 ? 1000.0 / mean : 0.0);
+        out << line;
+    };
+
+    for(std::size_t s = 0; s < m_times.size(); ++s)
+    {
+        print(m_names[s], m_times[s]);
+        all.insert(all.end(), m_times[s].begin(), m_times[s].end());
+    }
+
+    print("all", all);
+}
+
+}
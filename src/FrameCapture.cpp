@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include <EGLHeaders.hpp>
+#include <FrameCapture.hpp>
+#include <Qoi.hpp>
+
+namespace RPi {
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+}
+
+CaptureStats::CaptureStats():
+    captured(0), written(0), dropped(0), readbackMs(0.0), maxReadbackMs(0.f),
+    encodeMs(0.0), bytes(0)
+{
+
+}
+
+FrameCapture::FrameCapture():
+    m_directory(), m_interval(0), m_frame(0), m_buffers(), m_next(0),
+    m_pending(), m_writer(), m_mutex(), m_wake(), m_quit(false), m_stats(),
+    m_written(0), m_bytes(0), m_encodeUs(0)
+{
+
+}
+
+FrameCapture::~FrameCapture()
+{
+    stop();
+}
+
+void FrameCapture::start(std::string const & directory, std::size_t interval)
+{
+    stop();
+
+    m_directory = directory;
+    m_interval = interval > 0 ? interval : 1;
+    m_frame = 0;
+    m_quit = false;
+    m_stats = CaptureStats();
+    m_written = 0;
+    m_bytes = 0;
+    m_encodeUs = 0;
+
+    m_writer = std::thread(&FrameCapture::write, this);
+}
+
+void FrameCapture::stop()
+{
+    if(!m_writer.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+
+    m_wake.notify_one();
+    m_writer.join();
+}
+
+bool FrameCapture::capturing() const
+{
+    return m_writer.joinable();
+}
+
+void FrameCapture::frame(int width, int height)
+{
+    if(!capturing() || m_frame++ % m_interval != 0) return;
+
+    auto & buffer = m_buffers[m_next];
+
+    if(buffer.busy)
+    {
+        ++m_stats.dropped;
+        return;
+    }
+
+    auto const start = Clock::now();
+
+    buffer.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+    buffer.width = width;
+    buffer.height = height;
+    buffer.frame = m_frame - 1;
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffer.pixels.data());
+
+    auto const readback = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+    m_stats.readbackMs += readback;
+    m_stats.maxReadbackMs = std::max(m_stats.maxReadbackMs, readback);
+    ++m_stats.captured;
+
+    buffer.busy = true;
+    m_pending.push(m_next);
+    m_next = (m_next + 1) % BUFFERS;
+
+    // Taking the lock orders the push before the wait of the writer
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+
+    m_wake.notify_one();
+}
+
+CaptureStats FrameCapture::stats() const
+{
+    auto stats = m_stats;
+
+    stats.written = m_written;
+    stats.bytes = m_bytes;
+    stats.encodeMs = static_cast<double>(m_encodeUs) / 1000.0;
+
+    return stats;
+}
+
+void FrameCapture::report(std::ostream & out) const
+{
+    auto const s = stats();
+    auto const captured = static_cast<double>(s.captured > 0 ? s.captured : 1);
+    auto const written = static_cast<double>(s.written > 0 ? s.written : 1);
+
+    out << "Capture " << m_directory << " : " << s.captured << " frames read back, "
+        << s.written << " written (" << s.bytes / 1024 << " KB), " << s.dropped
+        << " dropped" << std::endl;
+    out << "  readback on the render thread : " << s.readbackMs / captured
+        << " ms mean, " << s.maxReadbackMs << " ms max" << std::endl;
+    out << "  encode and write on the writer thread : " << s.encodeMs / written
+        << " ms mean" << std::endl;
+}
+
+void FrameCapture::write()
+{
+    std::vector<std::uint8_t> encoded;
+
+    for(;;)
+    {
+        std::size_t i;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_wake.wait(lock, [&]() { return m_quit || m_pending.size() > 0; });
+
+            // Write the pending frames before quitting
+            if(!m_pending.pop(i)) return;
+        }
+
+        auto & buffer = m_buffers[i];
+        auto const start = Clock::now();
+
+        Qoi::Encode(buffer.pixels.data(), buffer.width, buffer.height, encoded);
+
+        // Nothing of the buffer is read after this : the render thread may
+        // fill it again
+        auto const frame = buffer.frame;
+        buffer.busy = false;
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "/frame_%06zu.qoi", frame);
+
+        auto const filename = m_directory + name;
+        auto const file = std::fopen(filename.c_str(), "wb");
+
+        if(file == nullptr || std::fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size())
+        {
+            std::cerr << "FrameCapture::write : Failed to write " << filename << std::endl;
+        }
+        else
+        {
+            ++m_written;
+            m_bytes += encoded.size();
+        }
+
+        if(file != nullptr) std::fclose(file);
+
+        m_encodeUs += static_cast<std::uint64_t>(std::chrono::duration_cast<
+            std::chrono::microseconds>(Clock::now() - start).count());
+    }
+}
+
+}
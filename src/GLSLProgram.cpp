@@ -1,4 +1,5 @@
 #include <array>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -6,6 +7,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <GLSLProgram.hpp>
+#include <Memory.hpp>
 #include <OpenGL.hpp>
 #include <OpenGLIntrospection.hpp>
 
@@ -46,6 +48,30 @@ namespace {
         return content;
     }
 
+    // Insert the #defines after the #version directive if any
+    std::string add_defines(std::string const & source,
+        std::vector<std::string> const & defines)
+    {
+        if(defines.empty()) return source;
+
+        std::string header;
+
+        for(auto const & define : defines)
+        {
+            header += "#define " + define + "\n";
+        }
+
+        std::string::size_type position = 0;
+
+        if(source.compare(0, 8, "#version") == 0)
+        {
+            position = source.find('\n');
+            position = position == std::string::npos ? source.length() : position + 1;
+        }
+
+        return source.substr(0, position) + header + source.substr(position);
+    }
+
     struct LocationBinding
     {
         LocationBinding(GLint index, GLchar const * name):
@@ -64,6 +90,7 @@ namespace {
         {OpenGL::AttributeIndex[AttributeIndex_Normal],    "VertexNormal"  },
         {OpenGL::AttributeIndex[AttributeIndex_Tangent],   "VertexTangent" },
         {OpenGL::AttributeIndex[AttributeIndex_TexCoord],  "VertexTexCoord"},
+        {OpenGL::AttributeIndex[AttributeIndex_Color],     "VertexColor"   },
         {OpenGL::AttributeIndex[AttributeIndex_UserData0], "VertexUserData0"},
         {OpenGL::AttributeIndex[AttributeIndex_UserData1], "VertexUserData1"},
         {OpenGL::AttributeIndex[AttributeIndex_UserData2], "VertexUserData2"},
@@ -77,10 +104,27 @@ namespace {
         {OpenGL::AttributeIndex[AttributeIndex_InstanceData4], "InstanceData4"},
         {OpenGL::AttributeIndex[AttributeIndex_InstanceData5], "InstanceData5"}
      }};
+
+    // Program in use, unknown after the deletion of the bound program
+    // (its name may be given again to a new program)
+    GLint const UNKNOWN_PROGRAM = -1;
+
+    GLint s_boundProgram = UNKNOWN_PROGRAM;
+    std::size_t s_bindCount = 0;
+
+    void use_program(GLint id)
+    {
+        if(id == s_boundProgram) return;
+
+        glUseProgram(static_cast<GLuint>(id));
+
+        s_boundProgram = id;
+        ++s_bindCount;
+    }
 }
 
 
-GLSLProgram::GLSLProgram(): m_id(0), m_log(""), m_linked(false)
+GLSLProgram::GLSLProgram(): m_id(0), m_log(""), m_linked(false), m_uniforms()
 {
     m_id = glCreateProgram();
 
@@ -101,11 +145,18 @@ GLSLProgram::GLSLProgram(): m_id(0), m_log(""), m_linked(false)
 GLSLProgram::~GLSLProgram()
 {
     glDeleteProgram(m_id);    
+
+    if(s_boundProgram == m_id) s_boundProgram = UNKNOWN_PROGRAM;
 }
 
 void GLSLProgram::bind() const
 {
-    glUseProgram(m_id);
+    use_program(m_id);
+}
+
+std::size_t GLSLProgram::BindCount()
+{
+    return s_bindCount;
 }
 
 
@@ -116,7 +167,20 @@ std::string const & GLSLProgram::getLog() const
 
 int GLSLProgram::getUniformLocation(std::string const & uniform) const
 {
-    return glGetUniformLocation(m_id, uniform.c_str());
+    return this->getUniformLocation(uniform.c_str());
+}
+
+int GLSLProgram::getUniformLocation(char const * uniform) const
+{
+    for(auto const & u : m_uniforms)
+    {
+        if(std::strcmp(u.name.c_str(), uniform) == 0) return u.location;
+    }
+
+    auto const location = glGetUniformLocation(m_id, uniform);
+    m_uniforms.push_back({ uniform, location });
+
+    return location;
 }
 
 
@@ -128,6 +192,7 @@ bool GLSLProgram::isLinked() const
 bool GLSLProgram::link()
 {
     glLinkProgram(m_id);
+    m_uniforms.clear();
 
     return true;
 
@@ -157,13 +222,21 @@ bool GLSLProgram::link()
     //}
 }
 
-bool GLSLProgram::loadShaderFromFile(Enums::ShaderType type, std::string const & filename)
+bool GLSLProgram::loadShaderFromFile(Enums::ShaderType type, std::string const & filename,
+    std::vector<std::string> const & defines)
 {
-    return this->loadShader(type, get_file_content(filename));
+    Memory::TagScope tag(Memory::Tag::Shaders);
+
+    return this->loadShader(type, get_file_content(filename), defines);
 }
 
-bool GLSLProgram::loadShader(Enums::ShaderType type, std::string const & source)
+bool GLSLProgram::loadShader(Enums::ShaderType type, std::string const & src,
+    std::vector<std::string> const & defines)
 {
+    Memory::TagScope tag(Memory::Tag::Shaders);
+
+    auto const source = add_defines(src, defines);
+
     GLuint shader = glCreateShader(OpenGL::ShaderType[type]);
 
     if(shader == 0)
@@ -218,22 +291,58 @@ bool GLSLProgram::loadShader(Enums::ShaderType type, std::string const & source)
 }
 
 void GLSLProgram::sendMatrix(std::string const & uniform, glm::mat4 const & matrix) const
+{
+    this->sendMatrix(uniform.c_str(), matrix);
+}
+
+void GLSLProgram::sendFloat(std::string const & uniform, float f) const
+{
+    this->sendFloat(uniform.c_str(), f);
+}
+
+void GLSLProgram::sendVec3(std::string const & uniform, glm::vec3 const & v) const
+{
+    this->sendVec3(uniform.c_str(), v);
+}
+
+void GLSLProgram::sendVec4Array(std::string const & uniform, float const * values,
+    std::size_t count) const
+{
+    this->sendVec4Array(uniform.c_str(), values, count);
+}
+
+void GLSLProgram::sendMatrix(char const * uniform, glm::mat4 const & matrix) const
 {
     this->bind();
     auto location = this->getUniformLocation(uniform);
     glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
-void GLSLProgram::sendFloat(std::string const & uniform, float f) const
+void GLSLProgram::sendFloat(char const * uniform, float f) const
 {
     this->bind();
     auto location = this->getUniformLocation(uniform);
     glUniform1f(location, f);
 }
 
+void GLSLProgram::sendVec3(char const * uniform, glm::vec3 const & v) const
+{
+    this->bind();
+    auto location = this->getUniformLocation(uniform);
+    glUniform3fv(location, 1, glm::value_ptr(v));
+}
+
+void GLSLProgram::sendVec4Array(char const * uniform, float const * values,
+    std::size_t count) const
+{
+    this->bind();
+    auto location = this->getUniformLocation(uniform);
+    glUniform4fv(location, static_cast<GLsizei>(count), values);
+}
+
 void GLSLProgram::unbind() const
 {
-    glUseProgram(0);
+    use_program(0);
 }
 
 }
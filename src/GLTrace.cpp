@@ -0,0 +1,600 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <EGLHeaders.hpp>
+#include <GLTrace.hpp>
+
+namespace RPi {
+
+namespace {
+
+    #define RPI_GL_TRACE_NAME(name) #name,
+
+    char const * const ENTRY_NAMES[] =
+    {
+        RPI_GL_TRACE_ENTRIES(RPI_GL_TRACE_NAME)
+    };
+
+    #undef RPI_GL_TRACE_NAME
+
+    // Calls are buffered and written by blocks
+    std::size_t const FLUSH_SIZE = 1 << 20;
+
+    // The traced calls are the ones of the render thread : no lock
+    std::FILE * s_file = nullptr;
+    std::vector<char> s_buffer;
+    std::uint64_t s_calls = 0;
+    std::uint64_t s_bytes = 0;
+
+    void flush()
+    {
+        if(s_file == nullptr || s_buffer.empty()) return;
+
+        std::fwrite(s_buffer.data(), 1, s_buffer.size(), s_file);
+        s_bytes += s_buffer.size();
+        s_buffer.clear();
+    }
+
+    void put(void const * data, std::size_t size)
+    {
+        auto const bytes = static_cast<char const *>(data);
+        s_buffer.insert(s_buffer.end(), bytes, bytes + size);
+    }
+
+    // The calls start on 4 bytes, like their arguments
+    void pad()
+    {
+        while(s_buffer.size() % 4 != 0) s_buffer.push_back(0);
+    }
+
+#ifdef RPI_TRACE_GL
+
+    using Clock = std::chrono::steady_clock;
+
+    GLint s_unpackAlignment = 4;
+
+    // -------------------------------------------------------------------------
+    //  One call of the trace, written when the object is destroyed : the
+    //  wrappers build it in one expression after the real call
+    // -------------------------------------------------------------------------
+    class Record
+    {
+        public:
+            Record(GLEntry entry, Clock::time_point start):
+                m_start(s_buffer.size()), m_args(0), m_payload(0)
+            {
+                if(s_file == nullptr) return;
+
+                auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - start).count();
+                auto const duration = static_cast<std::uint32_t>(
+                    ns < 0xffffffffll ? ns : 0xffffffffll);
+
+                auto const id = static_cast<std::uint16_t>(entry);
+                std::uint8_t const counts[2] = { 0, 0 };
+                std::uint32_t const payload = 0;
+
+                put(&id, sizeof(id));
+                put(counts, sizeof(counts));
+                put(&payload, sizeof(payload));
+                put(&duration, sizeof(duration));
+            }
+
+            ~Record()
+            {
+                if(s_file == nullptr) return;
+
+                auto const header = &s_buffer[m_start];
+
+                header[2] = static_cast<char>(m_args);
+                std::memcpy(header + 4, &m_payload, sizeof(m_payload));
+
+                pad();
+                ++s_calls;
+
+                if(s_buffer.size() >= FLUSH_SIZE) flush();
+            }
+
+            Record(Record const &) = delete;
+            Record & operator=(Record const &) = delete;
+
+            Record & arg(std::uint32_t value)
+            {
+                if(s_file == nullptr) return *this;
+
+                put(&value, sizeof(value));
+                ++m_args;
+                return *this;
+            }
+
+            Record & arg(GLint value)
+            {
+                return arg(static_cast<std::uint32_t>(value));
+            }
+
+            Record & arg(GLfloat value)
+            {
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return arg(bits);
+            }
+
+            Record & arg(void const * offset)
+            {
+                return arg(static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(offset)));
+            }
+
+            Record & payload(void const * data, std::size_t size)
+            {
+                if(s_file == nullptr || data == nullptr) return *this;
+
+                put(data, size);
+                m_payload += static_cast<std::uint32_t>(size);
+                return *this;
+            }
+
+        private:
+            std::size_t m_start;
+            std::uint32_t m_args;
+            std::uint32_t m_payload;
+    };
+
+    Clock::time_point start()
+    {
+        return s_file != nullptr ? Clock::now() : Clock::time_point();
+    }
+
+    // Bytes of an image of glTexImage2D
+    std::size_t image_size(GLsizei width, GLsizei height, GLenum format, GLenum type)
+    {
+        std::size_t pixel = 4;
+
+        if(type != GL_UNSIGNED_BYTE)
+        {
+            pixel = 2; // 565, 4444 and 5551
+        }
+        else if(format == GL_RGB)
+        {
+            pixel = 3;
+        }
+        else if(format == GL_LUMINANCE_ALPHA)
+        {
+            pixel = 2;
+        }
+        else if(format == GL_LUMINANCE || format == GL_ALPHA)
+        {
+            pixel = 1;
+        }
+
+        auto const alignment = static_cast<std::size_t>(s_unpackAlignment);
+        auto const row = (width * pixel + alignment - 1) / alignment * alignment;
+
+        return row * static_cast<std::size_t>(height);
+    }
+
+#endif
+}
+
+char const * GLTrace::EntryName(GLEntry entry)
+{
+    auto const i = static_cast<std::size_t>(entry);
+    return i < static_cast<std::size_t>(GLEntry::Count) ? ENTRY_NAMES[i] : "unknown";
+}
+
+bool GLTrace::Enabled()
+{
+#ifdef RPI_TRACE_GL
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool GLTrace::Start(std::string const & filename)
+{
+    if(!Enabled())
+    {
+        std::cerr << "GLTrace::Start : Build with TRACE_GL=1 (after make clear) "
+                  << "to trace the GL calls" << std::endl;
+        return false;
+    }
+
+    Stop();
+
+    s_file = std::fopen(filename.c_str(), "wb");
+
+    if(s_file == nullptr)
+    {
+        std::cerr << "GLTrace::Start : Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    s_buffer.reserve(FLUSH_SIZE + 4096);
+    s_calls = 0;
+    s_bytes = 0;
+
+    auto const count = static_cast<std::uint32_t>(GLEntry::Count);
+
+    put("RPGL", 4);
+    put(&VERSION, sizeof(VERSION));
+    put(&count, sizeof(count));
+
+    for(auto name : ENTRY_NAMES)
+    {
+        auto const length = static_cast<std::uint8_t>(std::strlen(name));
+
+        put(&length, sizeof(length));
+        put(name, length);
+    }
+
+    pad();
+
+    return true;
+}
+
+void GLTrace::Stop()
+{
+    if(s_file == nullptr) return;
+
+    flush();
+    std::fclose(s_file);
+    s_file = nullptr;
+}
+
+bool GLTrace::Recording()
+{
+    return s_file != nullptr;
+}
+
+std::uint64_t GLTrace::Calls()
+{
+    return s_calls;
+}
+
+std::uint64_t GLTrace::Bytes()
+{
+    return s_bytes + s_buffer.size();
+}
+
+}
+
+#ifdef RPI_TRACE_GL
+
+// -----------------------------------------------------------------------------
+//  Wrappers : the linker redirects the calls of the application to
+//  __wrap_<name>, __real_<name> is the entry point of the driver
+// -----------------------------------------------------------------------------
+
+using RPi::GLEntry;
+using RPi::Record;
+using RPi::start;
+
+extern "C" {
+
+#define RPI_GL_REAL(ret, name, params) \
+    ret GL_APIENTRY __real_##name params; \
+    ret GL_APIENTRY __wrap_##name params;
+
+RPI_GL_REAL(void, glAttachShader, (GLuint, GLuint))
+RPI_GL_REAL(void, glBindAttribLocation, (GLuint, GLuint, GLchar const *))
+RPI_GL_REAL(void, glBindBuffer, (GLenum, GLuint))
+RPI_GL_REAL(void, glBindFramebuffer, (GLenum, GLuint))
+RPI_GL_REAL(void, glBindRenderbuffer, (GLenum, GLuint))
+RPI_GL_REAL(void, glBindTexture, (GLenum, GLuint))
+RPI_GL_REAL(void, glBufferData, (GLenum, GLsizeiptr, void const *, GLenum))
+RPI_GL_REAL(void, glBufferSubData, (GLenum, GLintptr, GLsizeiptr, void const *))
+RPI_GL_REAL(GLenum, glCheckFramebufferStatus, (GLenum))
+RPI_GL_REAL(void, glClear, (GLbitfield))
+RPI_GL_REAL(void, glClearColor, (GLfloat, GLfloat, GLfloat, GLfloat))
+RPI_GL_REAL(void, glCompileShader, (GLuint))
+RPI_GL_REAL(GLuint, glCreateProgram, (void))
+RPI_GL_REAL(GLuint, glCreateShader, (GLenum))
+RPI_GL_REAL(void, glDeleteBuffers, (GLsizei, GLuint const *))
+RPI_GL_REAL(void, glDeleteFramebuffers, (GLsizei, GLuint const *))
+RPI_GL_REAL(void, glDeleteProgram, (GLuint))
+RPI_GL_REAL(void, glDeleteRenderbuffers, (GLsizei, GLuint const *))
+RPI_GL_REAL(void, glDeleteShader, (GLuint))
+RPI_GL_REAL(void, glDeleteTextures, (GLsizei, GLuint const *))
+RPI_GL_REAL(void, glDisable, (GLenum))
+RPI_GL_REAL(void, glDisableVertexAttribArray, (GLuint))
+RPI_GL_REAL(void, glDrawArrays, (GLenum, GLint, GLsizei))
+RPI_GL_REAL(void, glDrawElements, (GLenum, GLsizei, GLenum, void const *))
+RPI_GL_REAL(void, glEnable, (GLenum))
+RPI_GL_REAL(void, glEnableVertexAttribArray, (GLuint))
+RPI_GL_REAL(void, glFinish, (void))
+RPI_GL_REAL(void, glFramebufferRenderbuffer, (GLenum, GLenum, GLenum, GLuint))
+RPI_GL_REAL(void, glFramebufferTexture2D, (GLenum, GLenum, GLenum, GLuint, GLint))
+RPI_GL_REAL(void, glGenBuffers, (GLsizei, GLuint *))
+RPI_GL_REAL(void, glGenFramebuffers, (GLsizei, GLuint *))
+RPI_GL_REAL(void, glGenRenderbuffers, (GLsizei, GLuint *))
+RPI_GL_REAL(void, glGenTextures, (GLsizei, GLuint *))
+RPI_GL_REAL(void, glGetShaderInfoLog, (GLuint, GLsizei, GLsizei *, GLchar *))
+RPI_GL_REAL(void, glGetShaderiv, (GLuint, GLenum, GLint *))
+RPI_GL_REAL(GLint, glGetUniformLocation, (GLuint, GLchar const *))
+RPI_GL_REAL(void, glLinkProgram, (GLuint))
+RPI_GL_REAL(void, glPixelStorei, (GLenum, GLint))
+RPI_GL_REAL(void, glReadPixels, (GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void *))
+RPI_GL_REAL(void, glRenderbufferStorage, (GLenum, GLenum, GLsizei, GLsizei))
+RPI_GL_REAL(void, glScissor, (GLint, GLint, GLsizei, GLsizei))
+RPI_GL_REAL(void, glShaderSource, (GLuint, GLsizei, GLchar const * const *, GLint const *))
+RPI_GL_REAL(void, glTexImage2D, (GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, void const *))
+RPI_GL_REAL(void, glTexParameteri, (GLenum, GLenum, GLint))
+RPI_GL_REAL(void, glUniform1f, (GLint, GLfloat))
+RPI_GL_REAL(void, glUniform3fv, (GLint, GLsizei, GLfloat const *))
+RPI_GL_REAL(void, glUniform4fv, (GLint, GLsizei, GLfloat const *))
+RPI_GL_REAL(void, glUniformMatrix4fv, (GLint, GLsizei, GLboolean, GLfloat const *))
+RPI_GL_REAL(void, glUseProgram, (GLuint))
+RPI_GL_REAL(void, glVertexAttribPointer, (GLuint, GLint, GLenum, GLboolean, GLsizei, void const *))
+RPI_GL_REAL(void, glViewport, (GLint, GLint, GLsizei, GLsizei))
+RPI_GL_REAL(EGLBoolean, eglSwapBuffers, (EGLDisplay, EGLSurface))
+
+#undef RPI_GL_REAL
+
+// Calls without data : the arguments only
+#define RPI_GL_WRAP_1(name, T1) \
+    void GL_APIENTRY __wrap_##name(T1 a) \
+    { \
+        auto const t = start(); \
+        __real_##name(a); \
+        Record(GLEntry::name, t).arg(a); \
+    }
+
+#define RPI_GL_WRAP_2(name, T1, T2) \
+    void GL_APIENTRY __wrap_##name(T1 a, T2 b) \
+    { \
+        auto const t = start(); \
+        __real_##name(a, b); \
+        Record(GLEntry::name, t).arg(a).arg(b); \
+    }
+
+#define RPI_GL_WRAP_3(name, T1, T2, T3) \
+    void GL_APIENTRY __wrap_##name(T1 a, T2 b, T3 c) \
+    { \
+        auto const t = start(); \
+        __real_##name(a, b, c); \
+        Record(GLEntry::name, t).arg(a).arg(b).arg(c); \
+    }
+
+#define RPI_GL_WRAP_4(name, T1, T2, T3, T4) \
+    void GL_APIENTRY __wrap_##name(T1 a, T2 b, T3 c, T4 d) \
+    { \
+        auto const t = start(); \
+        __real_##name(a, b, c, d); \
+        Record(GLEntry::name, t).arg(a).arg(b).arg(c).arg(d); \
+    }
+
+// Calls generating or deleting names : the names are the payload
+#define RPI_GL_WRAP_NAMES(name, T) \
+    void GL_APIENTRY __wrap_##name(GLsizei n, T names) \
+    { \
+        auto const t = start(); \
+        __real_##name(n, names); \
+        Record(GLEntry::name, t).arg(n).payload(names, n * sizeof(GLuint)); \
+    }
+
+RPI_GL_WRAP_2(glAttachShader, GLuint, GLuint)
+RPI_GL_WRAP_2(glBindBuffer, GLenum, GLuint)
+RPI_GL_WRAP_2(glBindFramebuffer, GLenum, GLuint)
+RPI_GL_WRAP_2(glBindRenderbuffer, GLenum, GLuint)
+RPI_GL_WRAP_2(glBindTexture, GLenum, GLuint)
+RPI_GL_WRAP_1(glClear, GLbitfield)
+RPI_GL_WRAP_4(glClearColor, GLfloat, GLfloat, GLfloat, GLfloat)
+RPI_GL_WRAP_1(glCompileShader, GLuint)
+RPI_GL_WRAP_NAMES(glDeleteBuffers, GLuint const *)
+RPI_GL_WRAP_NAMES(glDeleteFramebuffers, GLuint const *)
+RPI_GL_WRAP_1(glDeleteProgram, GLuint)
+RPI_GL_WRAP_NAMES(glDeleteRenderbuffers, GLuint const *)
+RPI_GL_WRAP_1(glDeleteShader, GLuint)
+RPI_GL_WRAP_NAMES(glDeleteTextures, GLuint const *)
+RPI_GL_WRAP_1(glDisable, GLenum)
+RPI_GL_WRAP_1(glDisableVertexAttribArray, GLuint)
+RPI_GL_WRAP_3(glDrawArrays, GLenum, GLint, GLsizei)
+RPI_GL_WRAP_4(glDrawElements, GLenum, GLsizei, GLenum, void const *)
+RPI_GL_WRAP_1(glEnable, GLenum)
+RPI_GL_WRAP_1(glEnableVertexAttribArray, GLuint)
+RPI_GL_WRAP_4(glFramebufferRenderbuffer, GLenum, GLenum, GLenum, GLuint)
+RPI_GL_WRAP_NAMES(glGenBuffers, GLuint *)
+RPI_GL_WRAP_NAMES(glGenFramebuffers, GLuint *)
+RPI_GL_WRAP_NAMES(glGenRenderbuffers, GLuint *)
+RPI_GL_WRAP_NAMES(glGenTextures, GLuint *)
+RPI_GL_WRAP_1(glLinkProgram, GLuint)
+RPI_GL_WRAP_4(glRenderbufferStorage, GLenum, GLenum, GLsizei, GLsizei)
+RPI_GL_WRAP_4(glScissor, GLint, GLint, GLsizei, GLsizei)
+RPI_GL_WRAP_3(glTexParameteri, GLenum, GLenum, GLint)
+RPI_GL_WRAP_2(glUniform1f, GLint, GLfloat)
+RPI_GL_WRAP_1(glUseProgram, GLuint)
+RPI_GL_WRAP_4(glViewport, GLint, GLint, GLsizei, GLsizei)
+
+#undef RPI_GL_WRAP_1
+#undef RPI_GL_WRAP_2
+#undef RPI_GL_WRAP_3
+#undef RPI_GL_WRAP_4
+#undef RPI_GL_WRAP_NAMES
+
+void GL_APIENTRY __wrap_glBindAttribLocation(GLuint program, GLuint index, GLchar const * name)
+{
+    auto const t = start();
+    __real_glBindAttribLocation(program, index, name);
+    Record(GLEntry::glBindAttribLocation, t).arg(program).arg(index)
+        .payload(name, std::strlen(name));
+}
+
+void GL_APIENTRY __wrap_glBufferData(GLenum target, GLsizeiptr size, void const * data,
+    GLenum usage)
+{
+    auto const t = start();
+    __real_glBufferData(target, size, data, usage);
+    Record(GLEntry::glBufferData, t).arg(target).arg(static_cast<std::uint32_t>(size))
+        .arg(usage).payload(data, static_cast<std::size_t>(size));
+}
+
+void GL_APIENTRY __wrap_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size,
+    void const * data)
+{
+    auto const t = start();
+    __real_glBufferSubData(target, offset, size, data);
+    Record(GLEntry::glBufferSubData, t).arg(target).arg(static_cast<std::uint32_t>(offset))
+        .arg(static_cast<std::uint32_t>(size)).payload(data, static_cast<std::size_t>(size));
+}
+
+GLenum GL_APIENTRY __wrap_glCheckFramebufferStatus(GLenum target)
+{
+    auto const t = start();
+    auto const status = __real_glCheckFramebufferStatus(target);
+    Record(GLEntry::glCheckFramebufferStatus, t).arg(target).arg(status);
+    return status;
+}
+
+GLuint GL_APIENTRY __wrap_glCreateProgram(void)
+{
+    auto const t = start();
+    auto const program = __real_glCreateProgram();
+    Record(GLEntry::glCreateProgram, t).arg(program);
+    return program;
+}
+
+GLuint GL_APIENTRY __wrap_glCreateShader(GLenum type)
+{
+    auto const t = start();
+    auto const shader = __real_glCreateShader(type);
+    Record(GLEntry::glCreateShader, t).arg(type).arg(shader);
+    return shader;
+}
+
+void GL_APIENTRY __wrap_glFinish(void)
+{
+    auto const t = start();
+    __real_glFinish();
+    Record(GLEntry::glFinish, t);
+}
+
+void GL_APIENTRY __wrap_glFramebufferTexture2D(GLenum target, GLenum attachment,
+    GLenum textarget, GLuint texture, GLint level)
+{
+    auto const t = start();
+    __real_glFramebufferTexture2D(target, attachment, textarget, texture, level);
+    Record(GLEntry::glFramebufferTexture2D, t).arg(target).arg(attachment).arg(textarget)
+        .arg(texture).arg(level);
+}
+
+void GL_APIENTRY __wrap_glGetShaderInfoLog(GLuint shader, GLsizei size, GLsizei * length,
+    GLchar * log)
+{
+    auto const t = start();
+    __real_glGetShaderInfoLog(shader, size, length, log);
+    Record(GLEntry::glGetShaderInfoLog, t).arg(shader).arg(size);
+}
+
+void GL_APIENTRY __wrap_glGetShaderiv(GLuint shader, GLenum pname, GLint * params)
+{
+    auto const t = start();
+    __real_glGetShaderiv(shader, pname, params);
+    Record(GLEntry::glGetShaderiv, t).arg(shader).arg(pname);
+}
+
+GLint GL_APIENTRY __wrap_glGetUniformLocation(GLuint program, GLchar const * name)
+{
+    auto const t = start();
+    auto const location = __real_glGetUniformLocation(program, name);
+    Record(GLEntry::glGetUniformLocation, t).arg(program).arg(location)
+        .payload(name, std::strlen(name));
+    return location;
+}
+
+void GL_APIENTRY __wrap_glPixelStorei(GLenum pname, GLint param)
+{
+    if(pname == GL_UNPACK_ALIGNMENT) RPi::s_unpackAlignment = param;
+
+    auto const t = start();
+    __real_glPixelStorei(pname, param);
+    Record(GLEntry::glPixelStorei, t).arg(pname).arg(param);
+}
+
+void GL_APIENTRY __wrap_glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height,
+    GLenum format, GLenum type, void * pixels)
+{
+    auto const t = start();
+    __real_glReadPixels(x, y, width, height, format, type, pixels);
+    Record(GLEntry::glReadPixels, t).arg(x).arg(y).arg(width).arg(height).arg(format)
+        .arg(type);
+}
+
+void GL_APIENTRY __wrap_glShaderSource(GLuint shader, GLsizei count,
+    GLchar const * const * strings, GLint const * lengths)
+{
+    auto const t = start();
+    __real_glShaderSource(shader, count, strings, lengths);
+
+    // Length of each string, then its characters
+    Record record(GLEntry::glShaderSource, t);
+    record.arg(shader).arg(count);
+
+    for(GLsizei i = 0; i < count; ++i)
+    {
+        auto const length = static_cast<std::uint32_t>(lengths != nullptr && lengths[i] >= 0 ?
+            lengths[i] : std::strlen(strings[i]));
+
+        record.payload(&length, sizeof(length)).payload(strings[i], length);
+    }
+}
+
+void GL_APIENTRY __wrap_glTexImage2D(GLenum target, GLint level, GLint internalformat,
+    GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type,
+    void const * pixels)
+{
+    auto const t = start();
+    __real_glTexImage2D(target, level, internalformat, width, height, border, format,
+        type, pixels);
+    Record(GLEntry::glTexImage2D, t).arg(target).arg(level).arg(internalformat)
+        .arg(width).arg(height).arg(border).arg(format).arg(type)
+        .payload(pixels, RPi::image_size(width, height, format, type));
+}
+
+void GL_APIENTRY __wrap_glUniform3fv(GLint location, GLsizei count, GLfloat const * value)
+{
+    auto const t = start();
+    __real_glUniform3fv(location, count, value);
+    Record(GLEntry::glUniform3fv, t).arg(location).arg(count)
+        .payload(value, count * 3 * sizeof(GLfloat));
+}
+
+void GL_APIENTRY __wrap_glUniform4fv(GLint location, GLsizei count, GLfloat const * value)
+{
+    auto const t = start();
+    __real_glUniform4fv(location, count, value);
+    Record(GLEntry::glUniform4fv, t).arg(location).arg(count)
+        .payload(value, count * 4 * sizeof(GLfloat));
+}
+
+void GL_APIENTRY __wrap_glUniformMatrix4fv(GLint location, GLsizei count,
+    GLboolean transpose, GLfloat const * value)
+{
+    auto const t = start();
+    __real_glUniformMatrix4fv(location, count, transpose, value);
+    Record(GLEntry::glUniformMatrix4fv, t).arg(location).arg(count)
+        .arg(static_cast<std::uint32_t>(transpose)).payload(value, count * 16 * sizeof(GLfloat));
+}
+
+void GL_APIENTRY __wrap_glVertexAttribPointer(GLuint index, GLint size, GLenum type,
+    GLboolean normalized, GLsizei stride, void const * pointer)
+{
+    auto const t = start();
+    __real_glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    Record(GLEntry::glVertexAttribPointer, t).arg(index).arg(size).arg(type)
+        .arg(static_cast<std::uint32_t>(normalized)).arg(stride).arg(pointer);
+}
+
+EGLBoolean EGLAPIENTRY __wrap_eglSwapBuffers(EGLDisplay display, EGLSurface surface)
+{
+    auto const t = start();
+    auto const swapped = __real_eglSwapBuffers(display, surface);
+    Record(GLEntry::eglSwapBuffers, t);
+    return swapped;
+}
+
+}
+
+#endif
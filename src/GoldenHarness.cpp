@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include <EGLHeaders.hpp>
+#include <Flythrough.hpp>
+#include <GoldenHarness.hpp>
+#include <Qoi.hpp>
+
+namespace RPi {
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    float elapsed_ms(Clock::time_point start, Clock::time_point end)
+    {
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    // Squared YIQ difference of pixelmatch, at most MAX_DELTA
+    float const MAX_DELTA = 35215.f;
+
+    float color_delta(std::uint8_t const * a, std::uint8_t const * b)
+    {
+        auto const dr = static_cast<float>(a[0]) - b[0];
+        auto const dg = static_cast<float>(a[1]) - b[1];
+        auto const db = static_cast<float>(a[2]) - b[2];
+
+        auto const y = dr * 0.29889531f + dg * 0.58662247f + db * 0.11448223f;
+        auto const i = dr * 0.59597799f - dg * 0.27417610f - db * 0.32180189f;
+        auto const q = dr * 0.21147017f - dg * 0.52261711f + db * 0.31114694f;
+
+        return 0.5053f * y * y + 0.299f * i * i + 0.1957f * q * q;
+    }
+
+    // "3_cube field" -> "3_cube_field"
+    std::string file_name(std::size_t index, std::string const & segment)
+    {
+        auto name = std::to_string(index) + "_" + segment;
+        std::replace(name.begin(), name.end(), ' ', '_');
+        std::replace(name.begin(), name.end(), '/', '_');
+        return name;
+    }
+
+    double different_percent(ImageDiff const & diff)
+    {
+        return 100.0 * static_cast<double>(diff.different) /
+            static_cast<double>(std::max<std::size_t>(diff.pixels, 1));
+    }
+}
+
+ImageDiff CompareImages(std::uint8_t const * expected, std::uint8_t const * actual,
+    int width, int height, float threshold, std::vector<std::uint8_t> * diff)
+{
+    ImageDiff result = { static_cast<std::size_t>(width) * height, 0, 0.f, 0.0 };
+
+    if(diff != nullptr) diff->resize(result.pixels * 4);
+
+    for(std::size_t i = 0; i < result.pixels; ++i)
+    {
+        auto const delta = std::sqrt(color_delta(expected + i * 4, actual + i * 4) / MAX_DELTA);
+
+        result.maxDelta = std::max(result.maxDelta, delta);
+        result.meanDelta += delta;
+
+        auto const different = delta > threshold;
+
+        if(different) ++result.different;
+
+        if(diff != nullptr)
+        {
+            auto const out = &(*diff)[i * 4];
+
+            if(different)
+            {
+                out[0] = 255;
+                out[1] = 0;
+                out[2] = 0;
+            }
+            else
+            {
+                // Faded gray of the expected pixel
+                auto const gray = static_cast<std::uint8_t>(192 + (expected[i * 4] +
+                    expected[i * 4 + 1] + expected[i * 4 + 2]) / 12);
+
+                out[0] = gray;
+                out[1] = gray;
+                out[2] = gray;
+            }
+
+            out[3] = 255;
+        }
+    }
+
+    if(result.pixels > 0) result.meanDelta /= static_cast<double>(result.pixels);
+
+    return result;
+}
+
+GoldenResult::GoldenResult():
+    name(), cpuMs(0.f), frameMs(0.f), diff(), passed(false), skipped(false)
+{
+
+}
+
+GoldenHarness::GoldenHarness(std::string const & directory, int width, int height):
+    m_directory(directory), m_target(), m_threshold(0.1f), m_maxDifferent(0.005f),
+    m_repetitions(30), m_results()
+{
+    m_target.create(width, height);
+}
+
+void GoldenHarness::tolerance(float threshold, float maxDifferent)
+{
+    m_threshold = threshold;
+    m_maxDifferent = maxDifferent;
+}
+
+void GoldenHarness::repetitions(std::size_t frames)
+{
+    m_repetitions = std::max<std::size_t>(frames, 1);
+}
+
+RenderTarget const & GoldenHarness::target() const
+{
+    return m_target;
+}
+
+bool GoldenHarness::run(RenderFunc const & render, bool update, std::string const & label)
+{
+    m_results.clear();
+
+    if(!m_target.valid())
+    {
+        std::cerr << "GoldenHarness::run : No offscreen target" << std::endl;
+        return false;
+    }
+
+    CameraPath path;
+
+    if(!path.load(m_directory + "/poses.path")) return false;
+
+    auto const width = m_target.width();
+    auto const height = m_target.height();
+
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+    std::vector<std::uint8_t> golden;
+    std::vector<std::uint8_t> diff;
+
+    auto passed = true;
+    auto const times = path.times();
+
+    for(std::size_t i = 0; i < times.size(); ++i)
+    {
+        auto const pose = path.pose(times[i]);
+
+        GoldenResult result;
+        result.name = file_name(i, path.segments()[path.segment(times[i])]);
+
+        // The first frame pays for the uploads and the shader warm-up
+        render(pose);
+        glFinish();
+
+        float cpuMs = 0.f;
+        float frameMs = 0.f;
+
+        for(std::size_t r = 0; r < m_repetitions; ++r)
+        {
+            auto const start = Clock::now();
+
+            render(pose);
+
+            auto const submitted = Clock::now();
+
+            glFinish();
+
+            cpuMs += elapsed_ms(start, submitted);
+            frameMs += elapsed_ms(start, Clock::now());
+        }
+
+        result.cpuMs = cpuMs / static_cast<float>(m_repetitions);
+        result.frameMs = frameMs / static_cast<float>(m_repetitions);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_target.framebuffer());
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        auto const goldenFile = m_directory + "/" + result.name + ".qoi";
+
+        if(update)
+        {
+            result.diff = { pixels.size() / 4, 0, 0.f, 0.0 };
+            result.passed = Qoi::Save(goldenFile, pixels.data(), width, height);
+        }
+        else
+        {
+            int goldenWidth = 0;
+            int goldenHeight = 0;
+
+            if(!std::ifstream(goldenFile).good())
+            {
+                std::cout << "GoldenHarness::run : No golden image for " << result.name
+                          << ", skipped (write it with -u)" << std::endl;
+
+                result.diff = { pixels.size() / 4, 0, 0.f, 0.0 };
+                result.passed = true;
+                result.skipped = true;
+            }
+            else if(!Qoi::Load(goldenFile, goldenWidth, goldenHeight, golden) ||
+               goldenWidth != width || goldenHeight != height)
+            {
+                std::cerr << "GoldenHarness::run : No " << width << "x" << height
+                          << " golden image for " << result.name << std::endl;
+
+                result.diff = { pixels.size() / 4, pixels.size() / 4, 1.f, 1.0 };
+                result.passed = false;
+            }
+            else
+            {
+                result.diff = CompareImages(golden.data(), pixels.data(), width, height,
+                    m_threshold, &diff);
+                result.passed = result.diff.different <=
+                    static_cast<std::size_t>(m_maxDifferent * static_cast<float>(result.diff.pixels));
+
+                if(!result.passed)
+                {
+                    Qoi::Save(m_directory + "/" + result.name + ".diff.qoi",
+                        diff.data(), width, height);
+                }
+            }
+
+            if(!result.passed || result.skipped)
+            {
+                Qoi::Save(m_directory + "/" + result.name + ".new.qoi",
+                    pixels.data(), width, height);
+            }
+        }
+
+        passed = passed && result.passed;
+        m_results.push_back(result);
+    }
+
+    append(label);
+
+    return passed;
+}
+
+std::vector<GoldenResult> const & GoldenHarness::results() const
+{
+    return m_results;
+}
+
+void GoldenHarness::report(std::ostream & out) const
+{
+    char line[256];
+
+    std::snprintf(line, sizeof(line), "%-24s %9s %9s %11s %9s %6s\n",
+        "golden pose", "cpu ms", "frame ms", "different %", "max diff", "");
+    out << line;
+
+    for(auto const & r : m_results)
+    {
+        std::snprintf(line, sizeof(line), "%-24s %9.3f %9.3f %11.3f %9.3f %6s\n",
+            r.name.c_str(), r.cpuMs, r.frameMs,
+            different_percent(r.diff),
+            r.diff.maxDelta, r.skipped ? "skip" : r.passed ? "ok" : "FAIL");
+        out << line;
+    }
+}
+
+bool GoldenHarness::append(std::string const & label) const
+{
+    auto const filename = m_directory + "/results.csv";
+
+    std::ifstream existing(filename);
+    auto const header = !existing.good();
+    existing.close();
+
+    std::ofstream file(filename, std::ios::app);
+
+    if(!file)
+    {
+        std::cerr << "GoldenHarness::append : Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    if(header)
+    {
+        file << "label,pose,cpu_ms,frame_ms,different_pct,max_delta,mean_delta,passed,skipped"
+             << std::endl;
+    }
+
+    char line[256];
+
+    for(auto const & r : m_results)
+    {
+        std::snprintf(line, sizeof(line), "%s,%s,%.3f,%.3f,%.3f,%.4f,%.5f,%d,%d",
+            label.c_str(), r.name.c_str(), r.cpuMs, r.frameMs,
+            different_percent(r.diff),
+            r.diff.maxDelta, r.diff.meanDelta, r.passed ? 1 : 0, r.skipped ? 1 : 0);
+        file << line << std::endl;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,407 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <Heightfield.hpp>
+
+namespace RPi {
+
+// Ray expressed in grid units on the xz plane and in world units along y
+struct Heightfield::Ray
+{
+    float ox, oy, oz;
+    float dx, dy, dz;
+};
+
+namespace {
+
+    // Below this, a direction or a coefficient is treated as zero
+    float const EPSILON = 1e-12f;
+
+    // Clip [tMin, tMax] to the slab [lo, hi] crossed by o + t * d
+    bool clip(float o, float d, float lo, float hi, float & tMin, float & tMax)
+    {
+        if(std::fabs(d) < EPSILON)
+        {
+            return o >= lo && o <= hi;
+        }
+
+        auto const inv = 1.f / d;
+        auto t0 = (lo - o) * inv;
+        auto t1 = (hi - o) * inv;
+
+        if(t0 > t1) std::swap(t0, t1);
+
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+
+        return tMin <= tMax;
+    }
+
+    // Lowest root of a t^2 + b t + c in [tMin, tMax]
+    bool lowest_root(float a, float b, float c, float tMin, float tMax, float & t)
+    {
+        float roots[2];
+        auto nbRoots = 0;
+
+        if(std::fabs(a) < EPSILON)
+        {
+            if(std::fabs(b) < EPSILON) return false;
+            roots[nbRoots++] = -c / b;
+        }
+        else
+        {
+            auto const disc = b * b - 4.f * a * c;
+            if(disc < 0.f) return false;
+
+            auto const q = -0.5f * (b + std::copysign(std::sqrt(disc), b));
+
+            roots[nbRoots++] = q / a;
+            if(std::fabs(q) >= EPSILON) roots[nbRoots++] = c / q;
+        }
+
+        auto found = false;
+
+        for(auto i = 0; i < nbRoots; ++i)
+        {
+            if(roots[i] >= tMin && roots[i] <= tMax && (!found || roots[i] < t))
+            {
+                t = roots[i];
+                found = true;
+            }
+        }
+
+        return found;
+    }
+}
+
+Heightfield::Heightfield(Size width, Size depth, float spacing):
+    m_width(width), m_depth(depth), m_spacing(spacing),
+    m_heights(width * depth, 0.f), m_pyramid()
+{
+    assert(width > 0 && depth > 0);
+}
+
+Heightfield::Size Heightfield::width() const
+{
+    return m_width;
+}
+
+Heightfield::Size Heightfield::depth() const
+{
+    return m_depth;
+}
+
+float Heightfield::spacing() const
+{
+    return m_spacing;
+}
+
+float & Heightfield::at(Size x, Size z)
+{
+    return m_heights[z * m_width + x];
+}
+
+float Heightfield::at(Size x, Size z) const
+{
+    return m_heights[z * m_width + x];
+}
+
+float * Heightfield::row(Size z)
+{
+    return &m_heights[z * m_width];
+}
+
+float const * Heightfield::row(Size z) const
+{
+    return &m_heights[z * m_width];
+}
+
+float Heightfield::minHeight() const
+{
+    return *std::min_element(m_heights.begin(), m_heights.end());
+}
+
+float Heightfield::maxHeight() const
+{
+    return *std::max_element(m_heights.begin(), m_heights.end());
+}
+
+void Heightfield::normalRow(Size z, float * __restrict nx,
+    float * __restrict ny, float * __restrict nz) const
+{
+    // Neighbour rows, clamped on the borders
+    auto const zm = z > 0 ? z - 1 : z;
+    auto const zp = z + 1 < m_depth ? z + 1 : z;
+
+    float const * __restrict up   = row(zm);
+    float const * __restrict down = row(zp);
+    float const * __restrict cur  = row(z);
+
+    auto const invDz  = zp > zm ? 1.f / (static_cast<float>(zp - zm) * m_spacing) : 0.f;
+    auto const invDx2 = 0.5f / m_spacing;
+    auto const invDx  = 1.f / m_spacing;
+
+    auto const w = m_width;
+
+    // The loops below only touch contiguous arrays and have no branch
+    // so that they are vectorized by the compiler
+    for(Size x = 0; x < w; ++x)
+    {
+        nz[x] = (up[x] - down[x]) * invDz;
+    }
+
+    for(Size x = 1; x + 1 < w; ++x)
+    {
+        nx[x] = (cur[x - 1] - cur[x + 1]) * invDx2;
+    }
+
+    if(w > 1)
+    {
+        nx[0]     = (cur[0] - cur[1]) * invDx;
+        nx[w - 1] = (cur[w - 2] - cur[w - 1]) * invDx;
+    }
+    else
+    {
+        nx[0] = 0.f;
+    }
+
+    // Normalize (-dh/dx, 1, -dh/dz)
+    for(Size x = 0; x < w; ++x)
+    {
+        auto const invLength = 1.f / std::sqrt(nx[x] * nx[x] + 1.f + nz[x] * nz[x]);
+
+        nx[x] *= invLength;
+        ny[x]  = invLength;
+        nz[x] *= invLength;
+    }
+}
+
+void Heightfield::updatePyramid()
+{
+    m_pyramid.clear();
+
+    if(m_width < 2 || m_depth < 2) return;
+
+    // Level 0 : bounds of the cells
+    Level level = { m_width - 1, m_depth - 1, {} };
+    level.bounds.resize(level.width * level.depth);
+
+    for(Size z = 0; z < level.depth; ++z)
+    {
+        auto const r0 = row(z);
+        auto const r1 = row(z + 1);
+
+        for(Size x = 0; x < level.width; ++x)
+        {
+            auto & b = level.bounds[z * level.width + x];
+            b.min = std::min(std::min(r0[x], r0[x + 1]), std::min(r1[x], r1[x + 1]));
+            b.max = std::max(std::max(r0[x], r0[x + 1]), std::max(r1[x], r1[x + 1]));
+        }
+    }
+
+    m_pyramid.push_back(std::move(level));
+
+    // Merge 2 x 2 nodes until a single node covers the grid
+    while(m_pyramid.back().width > 1 || m_pyramid.back().depth > 1)
+    {
+        auto const & fine = m_pyramid.back();
+
+        Level coarse = { (fine.width + 1) / 2, (fine.depth + 1) / 2, {} };
+        coarse.bounds.resize(coarse.width * coarse.depth);
+
+        for(Size z = 0; z < coarse.depth; ++z)
+        {
+            for(Size x = 0; x < coarse.width; ++x)
+            {
+                Bounds b = fine.bounds[2 * z * fine.width + 2 * x];
+
+                for(Size cz = 2 * z; cz < std::min(2 * z + 2, fine.depth); ++cz)
+                {
+                    for(Size cx = 2 * x; cx < std::min(2 * x + 2, fine.width); ++cx)
+                    {
+                        auto const & c = fine.bounds[cz * fine.width + cx];
+                        b.min = std::min(b.min, c.min);
+                        b.max = std::max(b.max, c.max);
+                    }
+                }
+
+                coarse.bounds[z * coarse.width + x] = b;
+            }
+        }
+
+        m_pyramid.push_back(std::move(coarse));
+    }
+}
+
+float Heightfield::heightAt(float x, float z) const
+{
+    auto const maxX = static_cast<float>(m_width - 1);
+    auto const maxZ = static_cast<float>(m_depth - 1);
+
+    auto const gx = std::min(std::max(x / m_spacing, 0.f), maxX);
+    auto const gz = std::min(std::max(z / m_spacing, 0.f), maxZ);
+
+    auto const x0 = std::min(static_cast<Size>(gx), m_width > 1 ? m_width - 2 : 0);
+    auto const z0 = std::min(static_cast<Size>(gz), m_depth > 1 ? m_depth - 2 : 0);
+    auto const x1 = std::min(x0 + 1, m_width - 1);
+    auto const z1 = std::min(z0 + 1, m_depth - 1);
+
+    auto const u = gx - static_cast<float>(x0);
+    auto const v = gz - static_cast<float>(z0);
+
+    auto const h0 = at(x0, z0) + (at(x1, z0) - at(x0, z0)) * u;
+    auto const h1 = at(x0, z1) + (at(x1, z1) - at(x0, z1)) * u;
+
+    return h0 + (h1 - h0) * v;
+}
+
+glm::vec3 Heightfield::normalAt(float x, float z) const
+{
+    if(m_width < 2 || m_depth < 2) return glm::vec3(0.f, 1.f, 0.f);
+
+    auto const gx = std::min(std::max(x / m_spacing, 0.f), static_cast<float>(m_width - 1));
+    auto const gz = std::min(std::max(z / m_spacing, 0.f), static_cast<float>(m_depth - 1));
+
+    auto const x0 = std::min(static_cast<Size>(gx), m_width - 2);
+    auto const z0 = std::min(static_cast<Size>(gz), m_depth - 2);
+
+    auto const u = gx - static_cast<float>(x0);
+    auto const v = gz - static_cast<float>(z0);
+
+    auto const h00 = at(x0, z0);
+    auto const h10 = at(x0 + 1, z0);
+    auto const h01 = at(x0, z0 + 1);
+    auto const h11 = at(x0 + 1, z0 + 1);
+
+    // Gradient of the bilinear patch
+    auto const dhdx = ((h10 - h00) * (1.f - v) + (h11 - h01) * v) / m_spacing;
+    auto const dhdz = ((h01 - h00) * (1.f - u) + (h11 - h10) * u) / m_spacing;
+
+    return glm::normalize(glm::vec3(-dhdx, 1.f, -dhdz));
+}
+
+bool Heightfield::intersect(glm::vec3 const & from, glm::vec3 const & to,
+    glm::vec3 & hit) const
+{
+    float t = 0.f;
+
+    if(!raycast(from, to - from, 1.f, t)) return false;
+
+    hit = from + (to - from) * t;
+    return true;
+}
+
+bool Heightfield::raycast(glm::vec3 const & origin, glm::vec3 const & direction,
+    float tMax, float & t) const
+{
+    if(m_pyramid.empty()) return false;
+
+    Ray const ray =
+    {
+        origin.x / m_spacing, origin.y, origin.z / m_spacing,
+        direction.x / m_spacing, direction.y, direction.z / m_spacing
+    };
+
+    return visit(ray, m_pyramid.size() - 1, 0, 0, 0.f, tMax, t);
+}
+
+bool Heightfield::visit(Ray const & ray, Size level, Size x, Size z,
+    float tMin, float tMax, float & t) const
+{
+    auto const & l = m_pyramid[level];
+    auto const & cells = m_pyramid.front();
+    auto const & bounds = l.bounds[z * l.width + x];
+
+    // Footprint of the node in grid units
+    auto const shift = Size(1) << level;
+    auto const x0 = static_cast<float>(x * shift);
+    auto const z0 = static_cast<float>(z * shift);
+    auto const x1 = static_cast<float>(std::min((x + 1) * shift, cells.width));
+    auto const z1 = static_cast<float>(std::min((z + 1) * shift, cells.depth));
+
+    if(!clip(ray.ox, ray.dx, x0, x1, tMin, tMax)) return false;
+    if(!clip(ray.oz, ray.dz, z0, z1, tMin, tMax)) return false;
+
+    auto const yIn  = ray.oy + ray.dy * tMin;
+    auto const yOut = ray.oy + ray.dy * tMax;
+
+    // Ray above everything the node contains
+    if(std::min(yIn, yOut) > bounds.max) return false;
+
+    // Ray already under the surface when entering the node
+    if(yIn < bounds.min)
+    {
+        t = tMin;
+        return true;
+    }
+
+    if(level == 0)
+    {
+        return intersectCell(ray, x, z, tMin, tMax, t);
+    }
+
+    // Visit the children front to back : a ray crosses at most one of the
+    // two children which are neither the nearest nor the farthest
+    auto const & child = m_pyramid[level - 1];
+    Size const xs[2] = { ray.dx >= 0.f ? 0u : 1u, ray.dx >= 0.f ? 1u : 0u };
+    Size const zs[2] = { ray.dz >= 0.f ? 0u : 1u, ray.dz >= 0.f ? 1u : 0u };
+    Size const order[4][2] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
+
+    for(auto const & o : order)
+    {
+        auto const cx = 2 * x + xs[o[0]];
+        auto const cz = 2 * z + zs[o[1]];
+
+        if(cx < child.width && cz < child.depth &&
+            visit(ray, level - 1, cx, cz, tMin, tMax, t))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Heightfield::intersectCell(Ray const & ray, Size x, Size z,
+    float tMin, float tMax, float & t) const
+{
+    // Bilinear patch h(u, v) = a + b u + c v + d u v over the cell
+    auto const h00 = at(x, z);
+    auto const h10 = at(x + 1, z);
+    auto const h01 = at(x, z + 1);
+    auto const h11 = at(x + 1, z + 1);
+
+    auto const a = h00;
+    auto const b = h10 - h00;
+    auto const c = h01 - h00;
+    auto const d = h00 - h10 - h01 + h11;
+
+    auto const u0 = ray.ox - static_cast<float>(x);
+    auto const v0 = ray.oz - static_cast<float>(z);
+
+    // Height of the ray above the patch : f(t) = qa t^2 + qb t + qc
+    auto const qa = -d * ray.dx * ray.dz;
+    auto const qb = ray.dy - b * ray.dx - c * ray.dz - d * (u0 * ray.dz + v0 * ray.dx);
+    auto const qc = ray.oy - a - b * u0 - c * v0 - d * u0 * v0;
+
+    auto const f = [&](float s) { return (qa * s + qb) * s + qc; };
+
+    if(f(tMin) <= 0.f)
+    {
+        t = tMin;
+        return true;
+    }
+
+    if(lowest_root(qa, qb, qc, tMin, tMax, t)) return true;
+
+    if(f(tMax) <= 0.f)
+    {
+        t = tMax;
+        return true;
+    }
+
+    return false;
+}
+
+}
@@ -1,121 +1,260 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
 #include <limits>
-#include <iostream>
 
 #include <Input.hpp>
+#include <Memory.hpp>
+#include <SpscQueue.hpp>
 
-namespace RPi {
+namespace {
 
-Input::Input():
-    m_events(), m_keys(), m_mouseBtns(),
-    m_x(0), m_y(0), m_xRel(0), m_yRel(0), m_wheel(0)
-{
-    for(auto & k : m_keys)
-        k = false;
+    using RPi::Input;
+    using RPi::InputEvent;
 
-    for(auto & b : m_mouseBtns)
-        b = false;
-}
+    using EventQueue = RPi::SpscQueue<InputEvent, 1024>;
 
+    EventQueue & event_queue()
+    {
+        static EventQueue queue;
+        return queue;
+    }
 
-Input::~Input()
-{
-    std::cout << "Input destroyed" << std::endl;
-}
-
+    EventQueue & injected_queue()
+    {
+        static EventQueue queue;
+        return queue;
+    }
 
-void Input::updateEvents()
-{
-    m_xRel  = 0;
-    m_yRel  = 0;
-    m_wheel = 0;
+    std::atomic<std::size_t> s_dropped(0);
 
-    while(SDL_PollEvent(&m_events))
+    // -------------------------------------------------------------------------
+    //  SDL event filter, called by the thread pumping the events. The events
+    //  are moved to the queue : nothing is left in the SDL queue.
+    // -------------------------------------------------------------------------
+    int queue_event(SDL_Event const * e)
     {
-        switch(m_events.type)
+        InputEvent event = {};
+        event.time = Input::Now();
+
+        switch(e->type)
         {
             case SDL_KEYDOWN:
-                m_keys[m_events.key.keysym.sym] = true;
-            break;
-
-
             case SDL_KEYUP:
-                m_keys[m_events.key.keysym.sym] = false;
+                event.type = e->type == SDL_KEYDOWN ? InputEvent::KeyDown : InputEvent::KeyUp;
+                event.key = static_cast<std::uint16_t>(e->key.keysym.sym);
             break;
 
-
             case SDL_MOUSEBUTTONDOWN:
-                m_mouseBtns[m_events.button.button] = true;
+            case SDL_MOUSEBUTTONUP:
+                event.type = e->type == SDL_MOUSEBUTTONDOWN ?
+                    InputEvent::ButtonDown : InputEvent::ButtonUp;
+                event.button = e->button.button;
             break;
 
-            case SDL_MOUSEBUTTONUP:
-                m_mouseBtns[m_events.button.button] = false;
+            case SDL_MOUSEMOTION:
+                event.type = InputEvent::Motion;
+                event.x = static_cast<std::int16_t>(e->motion.x);
+                event.y = static_cast<std::int16_t>(e->motion.y);
+                event.xRel = e->motion.xrel;
+                event.yRel = e->motion.yrel;
             break;
 
+            default: return 0;
+        }
 
-            case SDL_MOUSEMOTION:
+        if(!event_queue().push(event))
+        {
+            s_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
 
-                m_x = m_events.motion.x;
-                m_y = m_events.motion.y;
+        return 0;
+    }
+}
 
-                m_xRel = m_events.motion.xrel;
-                m_yRel = m_events.motion.yrel;
+namespace RPi {
 
-            break;
+Input::State::State():
+    keys(), mouseBtns(), x(0), y(0), xRel(0), yRel(0), wheel(0)
+{
+    for(auto & k : keys)
+        k = false;
+
+    for(auto & b : mouseBtns)
+        b = false;
+}
+
+Input::Input():
+    m_state(), m_events(0), m_oldestEvent(0), m_newestEvent(0)
+{
+    // Create the queues before the filter and the injecting thread can use
+    // them
+    event_queue();
+    injected_queue();
+    SDL_SetEventFilter(&queue_event);
+}
+
+
+Input::~Input()
+{
+
+}
+
+
+void Input::updateEvents()
+{
+    Memory::TagScope tag(Memory::Tag::Input);
+
+    m_state.xRel  = 0;
+    m_state.yRel  = 0;
+    m_state.wheel = 0;
+
+    // Runs the filter on this thread when SDL has no event thread, does
+    // nothing otherwise
+    SDL_PumpEvents();
+
+    m_events = 0;
+    m_oldestEvent = 0;
+    m_newestEvent = 0;
+
+    InputEvent event;
 
-            //case SDL_MOUSEWHEEL:
-                //m_wheel = static_cast<float>(m_events.wheel.y);
-            //break;
+    for(auto queue : { &event_queue(), &injected_queue() })
+    {
+        while(queue->pop(event))
+        {
+            apply(event);
 
-            default: break;
+            if(m_events++ == 0 || event.time < m_oldestEvent) m_oldestEvent = event.time;
+            m_newestEvent = std::max(m_newestEvent, event.time);
         }
     }
 }
 
+void Input::apply(InputEvent const & event)
+{
+    switch(event.type)
+    {
+        case InputEvent::KeyDown:
+        case InputEvent::KeyUp:
+            if(event.key < m_state.keys.size())
+            {
+                m_state.keys[event.key] = event.type == InputEvent::KeyDown;
+            }
+        break;
+
+        case InputEvent::ButtonDown:
+        case InputEvent::ButtonUp:
+            if(event.button < m_state.mouseBtns.size())
+            {
+                m_state.mouseBtns[event.button] = event.type == InputEvent::ButtonDown;
+            }
+        break;
+
+        case InputEvent::Motion:
+
+            m_state.x = event.x;
+            m_state.y = event.y;
+
+            // Sum of the motions since the last frame
+            m_state.xRel += event.xRel;
+            m_state.yRel += event.yRel;
+
+        break;
+    }
+}
+
 bool Input::isKeyPressed(SDLKey key) const
 {
-    return m_keys[key];
+    return m_state.keys[key];
 }
 
 
 bool Input::isMouseBtnPressed(const Uint8 btn) const
 {
-    return m_mouseBtns[btn];
+    return m_state.mouseBtns[btn];
 }
 
 
 bool Input::mouseMoved() const
 {
-    return m_xRel != 0 || m_yRel != 0;
+    return m_state.xRel != 0 || m_state.yRel != 0;
 }
 
 bool Input::mouseWheelMoved() const
 {
-    return m_wheel > std::numeric_limits<float>::epsilon();
+    return m_state.wheel > std::numeric_limits<float>::epsilon();
 }
 
 int Input::getX() const
 {
-    return m_x;
+    return m_state.x;
 }
 
 int Input::getY() const
 {
-    return m_y;
+    return m_state.y;
 }
 
 int Input::getXRel() const
 {
-    return m_xRel;
+    return m_state.xRel;
 }
 
 int Input::getYRel() const
 {
-    return m_yRel;
+    return m_state.yRel;
 }
 
 float Input::getMouseWheel() const
 {
-    return m_wheel;
+    return m_state.wheel;
+}
+
+Input::State const & Input::state() const
+{
+    return m_state;
+}
+
+void Input::state(State const & state)
+{
+    m_state = state;
+}
+
+std::size_t Input::events() const
+{
+    return m_events;
+}
+
+std::uint64_t Input::oldestEventTime() const
+{
+    return m_oldestEvent;
+}
+
+std::uint64_t Input::newestEventTime() const
+{
+    return m_newestEvent;
+}
+
+std::uint64_t Input::Now()
+{
+    using namespace std::chrono;
+
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::size_t Input::DroppedEvents()
+{
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+bool Input::Inject(InputEvent const & event)
+{
+    if(injected_queue().push(event)) return true;
+
+    s_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
 }
 
 }
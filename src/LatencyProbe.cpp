@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include <Input.hpp>
+#include <LatencyProbe.hpp>
+
+namespace RPi {
+
+namespace {
+
+    // Nearest rank percentile of sorted values
+    float percentile(std::vector<float> const & sorted, float p)
+    {
+        auto const rank = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5f);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    struct Summary
+    {
+        std::size_t count;
+        double mean;
+        float p50;
+        float p95;
+        float p99;
+        float max;
+    };
+
+    Summary summarize(std::vector<float> latencies)
+    {
+        Summary s = { latencies.size(), 0.0, 0.f, 0.f, 0.f, 0.f };
+
+        if(latencies.empty()) return s;
+
+        std::sort(latencies.begin(), latencies.end());
+
+        for(auto l : latencies) s.mean += l;
+
+        s.mean /= static_cast<double>(latencies.size());
+        s.p50 = percentile(latencies, 0.5f);
+        s.p95 = percentile(latencies, 0.95f);
+        s.p99 = percentile(latencies, 0.99f);
+        s.max = latencies.back();
+
+        return s;
+    }
+}
+
+LatencyProbe::LatencyProbe():
+    m_latencies(), m_pending(0), m_injector(), m_injecting(false)
+{
+    // A few minutes of samples at 60 Hz without allocating during the run
+    m_latencies.reserve(16384);
+}
+
+LatencyProbe::~LatencyProbe()
+{
+    stop();
+}
+
+void LatencyProbe::inject(float period)
+{
+    stop();
+
+    m_injecting = true;
+
+    m_injector = std::thread([this, period]()
+    {
+        auto const step = std::chrono::microseconds(static_cast<long long>(period * 1000.f));
+        auto next = std::chrono::steady_clock::now() + step;
+
+        // Left press, left release, right press, right release : the camera
+        // comes back to where it was
+        SDLKey const keys[] = { SDLK_LEFT, SDLK_LEFT, SDLK_RIGHT, SDLK_RIGHT };
+        std::size_t i = 0;
+
+        while(m_injecting)
+        {
+            std::this_thread::sleep_until(next);
+            next += step;
+
+            InputEvent event = {};
+            event.time = Input::Now();
+            event.type = i % 2 == 0 ? InputEvent::KeyDown : InputEvent::KeyUp;
+            event.key = static_cast<std::uint16_t>(keys[i % 4]);
+
+            Input::Inject(event);
+            ++i;
+        }
+    });
+}
+
+void LatencyProbe::consumed(std::uint64_t eventTime)
+{
+    if(m_pending == 0 || eventTime < m_pending)
+    {
+        m_pending = eventTime;
+    }
+}
+
+void LatencyProbe::presented()
+{
+    if(m_pending == 0) return;
+
+    m_latencies.push_back((Input::Now() - m_pending) / 1000.f);
+    m_pending = 0;
+}
+
+std::size_t LatencyProbe::samples() const
+{
+    return m_latencies.size();
+}
+
+void LatencyProbe::report(std::ostream & out, std::string const & label) const
+{
+    auto const s = summarize(m_latencies);
+
+    char line[256];
+
+    std::snprintf(line, sizeof(line), "%-24s %7s %9s %9s %9s %9s %9s\n",
+        "input to present", "samples", "mean ms", "p50 ms", "p95 ms", "p99 ms", "max ms");
+    out << line;
+
+    std::snprintf(line, sizeof(line), "%-24s %7zu %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+        label.c_str(), s.count, s.mean, s.p50, s.p95, s.p99, s.max);
+    out << line;
+}
+
+bool LatencyProbe::append(std::string const & filename, std::string const & label) const
+{
+    std::ifstream existing(filename);
+    auto const header = !existing.good();
+    existing.close();
+
+    std::ofstream file(filename, std::ios::app);
+
+    if(!file)
+    {
+        std::cerr << "LatencyProbe::append : Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    if(header)
+    {
+        file << "label,samples,mean_ms,p50_ms,p95_ms,p99_ms,max_ms" << std::endl;
+    }
+
+    auto const s = summarize(m_latencies);
+
+    char line[256];
+
+    std::snprintf(line, sizeof(line), "%s,%zu,%.3f,%.3f,%.3f,%.3f,%.3f",
+        label.c_str(), s.count, s.mean, s.p50, s.p95, s.p99, s.max);
+    file << line << std::endl;
+
+    return true;
+}
+
+void LatencyProbe::stop()
+{
+    m_injecting = false;
+
+    if(m_injector.joinable())
+    {
+        m_injector.join();
+    }
+}
+
+}
@@ -0,0 +1,403 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+#include <Memory.hpp>
+
+namespace {
+
+    using RPi::Memory::Tag;
+
+    std::atomic<std::size_t> s_allocations(0);
+    std::atomic<std::size_t> s_deallocations(0);
+
+#ifdef RPI_MEMORY_TRACKING
+
+    // Prefix of a tracked block, keeps the alignment of operator new
+    union Header
+    {
+        struct
+        {
+            std::size_t size;
+            Tag tag;
+        } info;
+
+        std::max_align_t alignment;
+    };
+
+    struct Counters
+    {
+        std::atomic<std::size_t> live;
+        std::atomic<std::size_t> peak;
+        std::atomic<std::size_t> allocations;
+        std::atomic<std::size_t> deallocations;
+    };
+
+    // Zero-initialized before any dynamic initialization, so operator new
+    // can be called by the constructors of other static objects
+    Counters s_tags[static_cast<int>(Tag::Count)];
+
+    thread_local Tag t_tag = Tag::General;
+
+    void * track(void * p, std::size_t size)
+    {
+        auto const header = static_cast<Header *>(p);
+        auto & c = s_tags[static_cast<int>(t_tag)];
+
+        header->info.size = size;
+        header->info.tag = t_tag;
+
+        c.allocations.fetch_add(1, std::memory_order_relaxed);
+
+        auto const live = c.live.fetch_add(size, std::memory_order_relaxed) + size;
+        auto peak = c.peak.load(std::memory_order_relaxed);
+
+        while(live > peak &&
+            !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+
+        }
+
+        return header + 1;
+    }
+
+    void * untrack(void * p)
+    {
+        auto const header = static_cast<Header *>(p) - 1;
+        auto & c = s_tags[static_cast<int>(header->info.tag)];
+
+        c.deallocations.fetch_add(1, std::memory_order_relaxed);
+        c.live.fetch_sub(header->info.size, std::memory_order_relaxed);
+
+        return header;
+    }
+
+    std::size_t const HEADER_SIZE = sizeof(Header);
+
+#else
+
+    void * track(void * p, std::size_t) { return p; }
+    void * untrack(void * p) { return p; }
+
+    std::size_t const HEADER_SIZE = 0;
+
+#endif
+
+    void * counted_new(std::size_t size)
+    {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+
+        for(;;)
+        {
+            if(auto p = std::malloc(HEADER_SIZE + (size == 0 ? 1 : size)))
+            {
+                return track(p, size);
+            }
+
+            auto const handler = std::get_new_handler();
+            if(handler == nullptr) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void counted_delete(void * p)
+    {
+        if(p == nullptr) return;
+
+        s_deallocations.fetch_add(1, std::memory_order_relaxed);
+        std::free(untrack(p));
+    }
+
+    std::size_t align_up(std::size_t offset, std::size_t alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+// =============================================================================
+//   Replacement of the global allocation functions
+// =============================================================================
+
+void * operator new(std::size_t size)
+{
+    return counted_new(size);
+}
+
+void * operator new[](std::size_t size)
+{
+    return counted_new(size);
+}
+
+void * operator new(std::size_t size, std::nothrow_t const &) noexcept
+{
+    try { return counted_new(size); }
+    catch(std::bad_alloc const &) { return nullptr; }
+}
+
+void * operator new[](std::size_t size, std::nothrow_t const &) noexcept
+{
+    try { return counted_new(size); }
+    catch(std::bad_alloc const &) { return nullptr; }
+}
+
+void operator delete(void * p) noexcept
+{
+    counted_delete(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+    counted_delete(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+    counted_delete(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept
+{
+    counted_delete(p);
+}
+
+void operator delete(void * p, std::nothrow_t const &) noexcept
+{
+    counted_delete(p);
+}
+
+void operator delete[](void * p, std::nothrow_t const &) noexcept
+{
+    counted_delete(p);
+}
+
+namespace RPi {
+
+namespace Memory {
+
+std::size_t Allocations()
+{
+    return s_allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t Deallocations()
+{
+    return s_deallocations.load(std::memory_order_relaxed);
+}
+
+char const * TagName(Tag tag)
+{
+    static char const * const names[] = {
+        "General", "Terrain", "Shaders", "Input", "Fonts", "Scene", "Recording"
+    };
+
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<int>(Tag::Count),
+        "Missing tag name");
+
+    return tag < Tag::Count ? names[static_cast<int>(tag)] : "?";
+}
+
+#ifdef RPI_MEMORY_TRACKING
+
+bool TrackingEnabled()
+{
+    return true;
+}
+
+TagStats Stats(Tag tag)
+{
+    auto const & c = s_tags[static_cast<int>(tag)];
+
+    return {
+        c.live.load(std::memory_order_relaxed),
+        c.peak.load(std::memory_order_relaxed),
+        c.allocations.load(std::memory_order_relaxed),
+        c.deallocations.load(std::memory_order_relaxed)
+    };
+}
+
+Tag CurrentTag()
+{
+    return t_tag;
+}
+
+TagScope::TagScope(Tag tag):
+    m_previous(t_tag)
+{
+    t_tag = tag;
+}
+
+TagScope::~TagScope()
+{
+    t_tag = m_previous;
+}
+
+#else
+
+bool TrackingEnabled()
+{
+    return false;
+}
+
+TagStats Stats(Tag)
+{
+    return { 0, 0, 0, 0 };
+}
+
+Tag CurrentTag()
+{
+    return Tag::General;
+}
+
+#endif
+
+void Report(std::ostream & out)
+{
+    char line[128];
+
+    std::snprintf(line, sizeof(line), "Heap : %zu allocations, %zu deallocations",
+        Allocations(), Deallocations());
+    out << line << std::endl;
+
+    if(!TrackingEnabled())
+    {
+        out << "  (build with MEMORY_TRACKING=1 for the usage per subsystem)" << std::endl;
+        return;
+    }
+
+    std::snprintf(line, sizeof(line), "  %-10s %12s %12s %10s %10s",
+        "tag", "live (KB)", "peak (KB)", "allocs", "frees");
+    out << line << std::endl;
+
+    for(int t = 0; t < static_cast<int>(Tag::Count); ++t)
+    {
+        auto const tag = static_cast<Tag>(t);
+        auto const stats = Stats(tag);
+
+        std::snprintf(line, sizeof(line), "  %-10s %12.1f %12.1f %10zu %10zu",
+            TagName(tag), static_cast<double>(stats.liveBytes) / 1024.0,
+            static_cast<double>(stats.peakBytes) / 1024.0,
+            stats.allocations, stats.deallocations);
+        out << line << std::endl;
+    }
+}
+
+// =============================================================================
+//   FrameArena
+// =============================================================================
+
+FrameArena::FrameArena(std::size_t capacity):
+    m_buffer(nullptr), m_capacity(0), m_used(0), m_overflowBytes(0),
+    m_peak(0), m_overflows(0), m_blocks()
+{
+    grow(capacity);
+}
+
+FrameArena::~FrameArena()
+{
+    reset();
+    std::free(m_buffer);
+}
+
+void * FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    auto const offset = align_up(m_used, alignment);
+
+    if(offset + size <= m_capacity)
+    {
+        m_used = offset + size;
+        m_peak = std::max(m_peak, m_used + m_overflowBytes);
+
+        return m_buffer + offset;
+    }
+
+    // Full : fall back on the heap until the next reset
+    auto const block = std::malloc(std::max<std::size_t>(size, 1));
+
+    if(block == nullptr) throw std::bad_alloc();
+
+    m_blocks.push_back(block);
+    m_overflowBytes += size + alignment;
+    m_peak = std::max(m_peak, m_used + m_overflowBytes);
+    ++m_overflows;
+
+    return block;
+}
+
+char const * FrameArena::format(char const * fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    auto const length = std::vsnprintf(nullptr, 0, fmt, args);
+    va_end(args);
+
+    if(length < 0) return "";
+
+    auto const text = array<char>(static_cast<std::size_t>(length) + 1);
+
+    va_start(args, fmt);
+    std::vsnprintf(text, static_cast<std::size_t>(length) + 1, fmt, args);
+    va_end(args);
+
+    return text;
+}
+
+void FrameArena::reset()
+{
+    for(auto block : m_blocks)
+    {
+        std::free(block);
+    }
+
+    m_blocks.clear();
+
+    // Make room for the busiest frame so far
+    if(m_peak > m_capacity)
+    {
+        grow(m_peak);
+    }
+
+    m_used = 0;
+    m_overflowBytes = 0;
+}
+
+std::size_t FrameArena::used() const
+{
+    return m_used + m_overflowBytes;
+}
+
+std::size_t FrameArena::capacity() const
+{
+    return m_capacity;
+}
+
+std::size_t FrameArena::peak() const
+{
+    return m_peak;
+}
+
+std::size_t FrameArena::overflows() const
+{
+    return m_overflows;
+}
+
+void FrameArena::grow(std::size_t capacity)
+{
+    capacity = align_up(capacity, alignof(std::max_align_t));
+
+    auto const buffer = static_cast<char *>(std::realloc(m_buffer, capacity));
+
+    if(buffer == nullptr) throw std::bad_alloc();
+
+    m_buffer = buffer;
+    m_capacity = capacity;
+
+    // The blocks list must not allocate while overflowing
+    m_blocks.reserve(16);
+}
+
+}
+
+}
@@ -0,0 +1,291 @@
+#include <chrono>
+#include <iostream>
+
+#include <MultiView.hpp>
+
+namespace RPi {
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    float elapsed_ms(Clock::time_point start)
+    {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+}
+
+// =============================================================================
+//   RenderTarget
+// =============================================================================
+
+RenderTarget::RenderTarget():
+    m_framebuffer(0), m_texture(0), m_depth(0), m_width(0), m_height(0)
+{
+
+}
+
+RenderTarget::~RenderTarget()
+{
+    destroy();
+}
+
+bool RenderTarget::create(int width, int height)
+{
+    destroy();
+
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+        GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &m_depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+        m_texture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+        m_depth);
+
+    auto const status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "RenderTarget::create : Incomplete framebuffer (0x"
+                  << std::hex << status << std::dec << ")" << std::endl;
+        destroy();
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+
+    return true;
+}
+
+void RenderTarget::destroy()
+{
+    if(m_framebuffer != 0) glDeleteFramebuffers(1, &m_framebuffer);
+    if(m_depth != 0) glDeleteRenderbuffers(1, &m_depth);
+    if(m_texture != 0) glDeleteTextures(1, &m_texture);
+
+    m_framebuffer = 0;
+    m_depth = 0;
+    m_texture = 0;
+    m_width = 0;
+    m_height = 0;
+}
+
+bool RenderTarget::valid() const
+{
+    return m_framebuffer != 0;
+}
+
+GLuint RenderTarget::framebuffer() const
+{
+    return m_framebuffer;
+}
+
+GLuint RenderTarget::texture() const
+{
+    return m_texture;
+}
+
+int RenderTarget::width() const
+{
+    return m_width;
+}
+
+int RenderTarget::height() const
+{
+    return m_height;
+}
+
+// =============================================================================
+//   MultiViewRenderer
+// =============================================================================
+
+View::View():
+    name(), target(nullptr), viewport({ 0, 0, 0, 0 }), projection(1.f),
+    clearColor(0.f), thread(0), job()
+{
+
+}
+
+ViewStats::ViewStats():
+    jobMs(0.f), submitMs(0.f), draws(0)
+{
+
+}
+
+MultiViewRenderer::MultiViewRenderer(float farDepth):
+    m_farDepth(farDepth), m_views(), m_queues(), m_stats(), m_workers(),
+    m_mutex(), m_start(), m_finish(), m_frame(0), m_running(0), m_quit(false)
+{
+
+}
+
+MultiViewRenderer::~MultiViewRenderer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+
+    m_start.notify_all();
+
+    for(auto & worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t MultiViewRenderer::add(View const & view)
+{
+    m_views.push_back(view);
+    m_queues.emplace_back(new RenderQueue(m_farDepth));
+    m_stats.emplace_back();
+
+    while(m_workers.size() < view.thread)
+    {
+        // m_frame only changes in render(), on this thread
+        m_workers.emplace_back(&MultiViewRenderer::work, this, m_workers.size() + 1,
+            m_frame);
+    }
+
+    return m_views.size() - 1;
+}
+
+View & MultiViewRenderer::view(std::size_t i)
+{
+    return m_views[i];
+}
+
+std::size_t MultiViewRenderer::size() const
+{
+    return m_views.size();
+}
+
+RenderQueue & MultiViewRenderer::queue(std::size_t i)
+{
+    return *m_queues[i];
+}
+
+void MultiViewRenderer::render()
+{
+    if(!m_workers.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = m_workers.size();
+            ++m_frame;
+        }
+
+        m_start.notify_all();
+    }
+
+    runJobs(0);
+
+    if(!m_workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finish.wait(lock, [this]() { return m_running == 0; });
+    }
+
+    Viewport const * window = nullptr;
+
+    for(std::size_t i = 0; i < m_views.size(); ++i)
+    {
+        auto const & view = m_views[i];
+        auto const & v = view.viewport;
+
+        auto const start = Clock::now();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, view.target ? view.target->framebuffer() : 0);
+        glViewport(v.x, v.y, v.width, v.height);
+
+        // Only clear the rectangle of the view
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(v.x, v.y, v.width, v.height);
+        glClearColor(view.clearColor.x, view.clearColor.y, view.clearColor.z,
+            view.clearColor.w);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+
+        auto & queue = *m_queues[i];
+
+        queue.submit(view.projection);
+        queue.clear();
+
+        m_stats[i].submitMs = elapsed_ms(start);
+        m_stats[i].draws = queue.stats().draws;
+
+        if(view.target == nullptr && window == nullptr) window = &v;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(window != nullptr)
+    {
+        glViewport(window->x, window->y, window->width, window->height);
+    }
+}
+
+ViewStats const & MultiViewRenderer::stats(std::size_t i) const
+{
+    return m_stats[i];
+}
+
+void MultiViewRenderer::runJobs(std::size_t thread)
+{
+    for(std::size_t i = 0; i < m_views.size(); ++i)
+    {
+        auto const & view = m_views[i];
+
+        if(view.thread != thread || !view.job) continue;
+
+        auto const start = Clock::now();
+
+        view.job(*m_queues[i]);
+
+        m_stats[i].jobMs = elapsed_ms(start);
+    }
+}
+
+void MultiViewRenderer::work(std::size_t thread, std::size_t frame)
+{
+    // Views are added between frames : <frame> is the last one rendered
+    for(;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_start.wait(lock, [&]() { return m_quit || m_frame != frame; });
+
+            if(m_quit) return;
+
+            frame = m_frame;
+        }
+
+        runJobs(thread);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if(--m_running == 0) m_finish.notify_one();
+        }
+    }
+}
+
+}
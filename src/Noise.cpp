@@ -0,0 +1,667 @@
+#include <cmath>
+#include <numeric>
+
+#include <Noise.hpp>
+
+namespace RPi {
+
+namespace {
+
+    // Gradients of the simplex noise : midpoints of the edges of a cube
+    int const s_grad3[12][3] =
+    {
+        { 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+        { 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+        { 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 }
+    };
+
+    template <typename T>
+    inline int fast_floor(T x)
+    {
+        auto const i = static_cast<int>(x);
+        return x < static_cast<T>(i) ? i - 1 : i;
+    }
+
+    // 6t^5 - 15t^4 + 10t^3
+    template <typename T>
+    inline T fade(T t)
+    {
+        return t * t * t * (t * (t * T(6) - T(15)) + T(10));
+    }
+
+    template <typename T>
+    inline T lerp(T a, T b, T t)
+    {
+        return a + t * (b - a);
+    }
+
+    // Gradients of the improved noise : the 12 of the simplex noise padded
+    // to 16 to be indexed by (hash & 15)
+    int const s_grad4[16][3] =
+    {
+        { 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+        { 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+        { 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 },
+        { 1, 1, 0 }, { 0, -1, 1 }, { -1, 1, 0 }, { 0, -1, -1 }
+    };
+
+    template <typename T>
+    inline T dot(int const g[3], T x, T y)
+    {
+        return static_cast<T>(g[0]) * x + static_cast<T>(g[1]) * y;
+    }
+
+    template <typename T>
+    inline T dot(int const g[3], T x, T y, T z)
+    {
+        return static_cast<T>(g[0]) * x + static_cast<T>(g[1]) * y
+            + static_cast<T>(g[2]) * z;
+    }
+
+    // Table lookup rather than the usual bit tests : the branches of the
+    // latter are mispredicted once the octaves get smaller than the grid
+    template <typename T>
+    inline T grad(std::uint8_t hash, T x, T y, T z)
+    {
+        return dot(s_grad4[hash & 15], x, y, z);
+    }
+
+    template <typename T>
+    inline T grad(std::uint8_t hash, T x, T y)
+    {
+        return dot(s_grad4[hash & 15], x, y);
+    }
+}
+
+namespace {
+
+    inline std::uint64_t hash(std::uint64_t seed, std::int64_t x, std::int64_t y)
+    {
+        return LatticeHash(seed, x, y);
+    }
+
+    inline std::uint64_t hash(std::uint64_t seed, std::int64_t x, std::int64_t y,
+        std::int64_t z)
+    {
+        auto h = hash(seed, x, y);
+        return LatticeMix(h ^ static_cast<std::uint64_t>(z) * 0x165667B19E3779F9ull);
+    }
+
+    // Cell wrapped in [0, period), untouched when the axis is not periodic
+    inline std::int64_t wrap(std::int64_t cell, std::int64_t period)
+    {
+        if(period <= 0) return cell;
+
+        cell %= period;
+        return cell < 0 ? cell + period : cell;
+    }
+
+    // -------------------------------------------------------------------------
+    //  Split (origin + x) * frequency into a cell and a fraction in [0, 1)
+    //
+    //   The origin is scaled in double and only its fraction is added to the
+    //   local position. Two chunks thus get the same cell and fraction for a
+    //   point of their shared border when the products are exact.
+    // -------------------------------------------------------------------------
+    template <typename T>
+    inline std::int64_t split(std::int64_t origin, T x, double frequency, T & fraction)
+    {
+        auto const scaled = static_cast<double>(origin) * frequency;
+        auto const cell = std::floor(scaled);
+
+        auto const t = static_cast<T>(scaled - cell) + x * static_cast<T>(frequency);
+        auto const i = std::floor(t);
+
+        fraction = t - i;
+        return static_cast<std::int64_t>(cell) + static_cast<std::int64_t>(i);
+    }
+
+    inline Lattice scale(Lattice const & period, double frequency)
+    {
+        return Lattice(std::llround(static_cast<double>(period.x) * frequency),
+            std::llround(static_cast<double>(period.y) * frequency),
+            std::llround(static_cast<double>(period.z) * frequency));
+    }
+
+    template <typename T>
+    inline T lattice_grad(std::uint64_t h, T x, T y)
+    {
+        return dot(s_grad4[h >> 60], x, y);
+    }
+
+    template <typename T>
+    inline T lattice_grad(std::uint64_t h, T x, T y, T z)
+    {
+        return dot(s_grad4[h >> 60], x, y, z);
+    }
+
+    template <typename T>
+    T lattice_perlin(std::uint64_t seed, std::int64_t cx, std::int64_t cy,
+        T x, T y, Lattice const & period)
+    {
+        auto const x0 = wrap(cx, period.x);
+        auto const x1 = wrap(cx + 1, period.x);
+        auto const y0 = wrap(cy, period.y);
+        auto const y1 = wrap(cy + 1, period.y);
+
+        auto const u = fade(x);
+        auto const v = fade(y);
+
+        return lerp(
+            lerp(lattice_grad(hash(seed, x0, y0), x, y),
+                 lattice_grad(hash(seed, x1, y0), x - T(1), y), u),
+            lerp(lattice_grad(hash(seed, x0, y1), x, y - T(1)),
+                 lattice_grad(hash(seed, x1, y1), x - T(1), y - T(1)), u),
+            v);
+    }
+
+    template <typename T>
+    T lattice_perlin(std::uint64_t seed, std::int64_t cx, std::int64_t cy,
+        std::int64_t cz, T x, T y, T z, Lattice const & period)
+    {
+        auto const x0 = wrap(cx, period.x);
+        auto const x1 = wrap(cx + 1, period.x);
+        auto const y0 = wrap(cy, period.y);
+        auto const y1 = wrap(cy + 1, period.y);
+        auto const z0 = wrap(cz, period.z);
+        auto const z1 = wrap(cz + 1, period.z);
+
+        auto const u = fade(x);
+        auto const v = fade(y);
+        auto const w = fade(z);
+
+        auto const xm = x - T(1);
+        auto const ym = y - T(1);
+        auto const zm = z - T(1);
+
+        return lerp(
+            lerp(lerp(lattice_grad(hash(seed, x0, y0, z0), x,  y,  z),
+                      lattice_grad(hash(seed, x1, y0, z0), xm, y,  z),  u),
+                 lerp(lattice_grad(hash(seed, x0, y1, z0), x,  ym, z),
+                      lattice_grad(hash(seed, x1, y1, z0), xm, ym, z),  u), v),
+            lerp(lerp(lattice_grad(hash(seed, x0, y0, z1), x,  y,  zm),
+                      lattice_grad(hash(seed, x1, y0, z1), xm, y,  zm), u),
+                 lerp(lattice_grad(hash(seed, x0, y1, z1), x,  ym, zm),
+                      lattice_grad(hash(seed, x1, y1, z1), xm, ym, zm), u), v),
+            w);
+    }
+
+    // Move a split coordinate by d, keeping the fraction in [0, 1)
+    template <typename T>
+    inline std::int64_t displace(std::int64_t cell, T d, T & fraction)
+    {
+        auto const t = fraction + d;
+        auto const i = std::floor(t);
+
+        fraction = t - i;
+        return cell + static_cast<std::int64_t>(i);
+    }
+
+    // -------------------------------------------------------------------------
+    //  Sum of octaves of lattice Perlin noise at origin + p + d
+    //
+    //   The displacement d is added once the position is split, so that it
+    //   does not break the exactness of the split on chunk borders.
+    // -------------------------------------------------------------------------
+    template <typename T>
+    T lattice_fbm(std::uint64_t seed, Fractal<T> const & f, Lattice const & origin,
+        T x, T y, T dx, T dy, Lattice const & period)
+    {
+        T sum = T(0);
+        double frequency = f.frequency;
+        T amplitude = f.amplitude;
+
+        for(int o = 0; o < f.octaves; ++o)
+        {
+            auto const scaled = static_cast<T>(frequency);
+
+            T fx, fy;
+            auto cx = split(origin.x, x, frequency, fx);
+            auto cy = split(origin.y, y, frequency, fy);
+
+            cx = displace(cx, dx * scaled, fx);
+            cy = displace(cy, dy * scaled, fy);
+
+            sum += amplitude * lattice_perlin(seed, cx, cy, fx, fy,
+                scale(period, frequency));
+
+            frequency *= f.lacunarity;
+            amplitude *= f.gain;
+        }
+
+        return sum;
+    }
+
+    template <typename T>
+    T lattice_fbm(std::uint64_t seed, Fractal<T> const & f, Lattice const & origin,
+        T x, T y, T z, T dx, T dy, T dz, Lattice const & period)
+    {
+        T sum = T(0);
+        double frequency = f.frequency;
+        T amplitude = f.amplitude;
+
+        for(int o = 0; o < f.octaves; ++o)
+        {
+            auto const scaled = static_cast<T>(frequency);
+
+            T fx, fy, fz;
+            auto cx = split(origin.x, x, frequency, fx);
+            auto cy = split(origin.y, y, frequency, fy);
+            auto cz = split(origin.z, z, frequency, fz);
+
+            cx = displace(cx, dx * scaled, fx);
+            cy = displace(cy, dy * scaled, fy);
+            cz = displace(cz, dz * scaled, fz);
+
+            sum += amplitude * lattice_perlin(seed, cx, cy, cz, fx, fy, fz,
+                scale(period, frequency));
+
+            frequency *= f.lacunarity;
+            amplitude *= f.gain;
+        }
+
+        return sum;
+    }
+
+    // Origins of the displacement fields of the domain warping, in cells
+    Lattice const WARP_X(5179, -3407, 1291);
+    Lattice const WARP_Y(-8233, 6007, -4519);
+    Lattice const WARP_Z(2711, 9341, -7027);
+
+    inline Lattice offset(Lattice const & a, Lattice const & b)
+    {
+        return Lattice(a.x + b.x, a.y + b.y, a.z + b.z);
+    }
+}
+
+template <typename T>
+Noise<T>::Noise(std::uint32_t seed):
+    m_seed(0), m_hashSeed(0), m_perm(), m_permMod12()
+{
+    this->seed(seed);
+}
+
+template <typename T>
+void Noise<T>::seed(std::uint32_t seed)
+{
+    m_seed = seed;
+    m_hashSeed = LatticeMix(seed);
+
+    // Fisher-Yates shuffle driven by a xorshift generator, the table only
+    // depends on the seed (not on the standard library implementation)
+    std::array<std::uint8_t, 256> p;
+    std::iota(p.begin(), p.end(), 0);
+
+    std::uint32_t state = seed * 2654435761u + 0x9E3779B9u;
+    if(state == 0) state = 0x9E3779B9u;
+
+    for(std::uint32_t i = 255; i > 0; --i)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        std::swap(p[i], p[state % (i + 1)]);
+    }
+
+    for(std::size_t i = 0; i < 512; ++i)
+    {
+        m_perm[i] = p[i & 255];
+        m_permMod12[i] = static_cast<std::uint8_t>(m_perm[i] % 12);
+    }
+}
+
+template <typename T>
+std::uint32_t Noise<T>::seed() const
+{
+    return m_seed;
+}
+
+template <typename T>
+T Noise<T>::perlin(T x, T y) const
+{
+    auto const xi = fast_floor(x);
+    auto const yi = fast_floor(y);
+
+    x -= static_cast<T>(xi);
+    y -= static_cast<T>(yi);
+
+    auto const X = xi & 255;
+    auto const Y = yi & 255;
+
+    auto const u = fade(x);
+    auto const v = fade(y);
+
+    auto const & p = m_perm;
+    auto const A = p[X] + Y;
+    auto const B = p[X + 1] + Y;
+
+    return lerp(
+        lerp(grad(p[A],     x, y),        grad(p[B],     x - T(1), y),        u),
+        lerp(grad(p[A + 1], x, y - T(1)), grad(p[B + 1], x - T(1), y - T(1)), u),
+        v);
+}
+
+template <typename T>
+T Noise<T>::perlin(T x, T y, T z) const
+{
+    auto const xi = fast_floor(x);
+    auto const yi = fast_floor(y);
+    auto const zi = fast_floor(z);
+
+    x -= static_cast<T>(xi);
+    y -= static_cast<T>(yi);
+    z -= static_cast<T>(zi);
+
+    auto const X = xi & 255;
+    auto const Y = yi & 255;
+    auto const Z = zi & 255;
+
+    auto const u = fade(x);
+    auto const v = fade(y);
+    auto const w = fade(z);
+
+    auto const & p = m_perm;
+    auto const A  = p[X] + Y;
+    auto const AA = p[A] + Z;
+    auto const AB = p[A + 1] + Z;
+    auto const B  = p[X + 1] + Y;
+    auto const BA = p[B] + Z;
+    auto const BB = p[B + 1] + Z;
+
+    auto const x1 = x - T(1);
+    auto const y1 = y - T(1);
+    auto const z1 = z - T(1);
+
+    return lerp(
+        lerp(lerp(grad(p[AA],     x, y,  z),  grad(p[BA],     x1, y,  z),  u),
+             lerp(grad(p[AB],     x, y1, z),  grad(p[BB],     x1, y1, z),  u), v),
+        lerp(lerp(grad(p[AA + 1], x, y,  z1), grad(p[BA + 1], x1, y,  z1), u),
+             lerp(grad(p[AB + 1], x, y1, z1), grad(p[BB + 1], x1, y1, z1), u), v),
+        w);
+}
+
+template <typename T>
+T Noise<T>::simplex(T x, T y) const
+{
+    // Skewing and unskewing factors
+    T const F2 = T(0.5) * (std::sqrt(T(3)) - T(1));
+    T const G2 = (T(3) - std::sqrt(T(3))) / T(6);
+
+    // Simplex cell containing (x, y)
+    auto const s = (x + y) * F2;
+    auto const i = fast_floor(x + s);
+    auto const j = fast_floor(y + s);
+
+    auto const t = static_cast<T>(i + j) * G2;
+    auto const x0 = x - (static_cast<T>(i) - t);
+    auto const y0 = y - (static_cast<T>(j) - t);
+
+    // Middle corner of the triangle
+    auto const i1 = x0 > y0 ? 1 : 0;
+    auto const j1 = x0 > y0 ? 0 : 1;
+
+    auto const x1 = x0 - static_cast<T>(i1) + G2;
+    auto const y1 = y0 - static_cast<T>(j1) + G2;
+    auto const x2 = x0 - T(1) + T(2) * G2;
+    auto const y2 = y0 - T(1) + T(2) * G2;
+
+    auto const ii = i & 255;
+    auto const jj = j & 255;
+
+    auto const & p = m_perm;
+    auto const gi0 = m_permMod12[ii + p[jj]];
+    auto const gi1 = m_permMod12[ii + i1 + p[jj + j1]];
+    auto const gi2 = m_permMod12[ii + 1 + p[jj + 1]];
+
+    // Contributions of the three corners
+    T n = T(0);
+
+    auto t0 = T(0.5) - x0 * x0 - y0 * y0;
+    if(t0 > T(0)) { t0 *= t0; n += t0 * t0 * dot(s_grad3[gi0], x0, y0); }
+
+    auto t1 = T(0.5) - x1 * x1 - y1 * y1;
+    if(t1 > T(0)) { t1 *= t1; n += t1 * t1 * dot(s_grad3[gi1], x1, y1); }
+
+    auto t2 = T(0.5) - x2 * x2 - y2 * y2;
+    if(t2 > T(0)) { t2 *= t2; n += t2 * t2 * dot(s_grad3[gi2], x2, y2); }
+
+    return T(70) * n;
+}
+
+template <typename T>
+T Noise<T>::simplex(T x, T y, T z) const
+{
+    T const F3 = T(1) / T(3);
+    T const G3 = T(1) / T(6);
+
+    // Simplex cell containing (x, y, z)
+    auto const s = (x + y + z) * F3;
+    auto const i = fast_floor(x + s);
+    auto const j = fast_floor(y + s);
+    auto const k = fast_floor(z + s);
+
+    auto const t = static_cast<T>(i + j + k) * G3;
+    auto const x0 = x - (static_cast<T>(i) - t);
+    auto const y0 = y - (static_cast<T>(j) - t);
+    auto const z0 = z - (static_cast<T>(k) - t);
+
+    // Second and third corners of the tetrahedron
+    int i1, j1, k1, i2, j2, k2;
+
+    if(x0 >= y0)
+    {
+        if(y0 >= z0)      { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+        else if(x0 >= z0) { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+        else              { i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+    }
+    else
+    {
+        if(y0 < z0)       { i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+        else if(x0 < z0)  { i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+        else              { i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+    }
+
+    auto const x1 = x0 - static_cast<T>(i1) + G3;
+    auto const y1 = y0 - static_cast<T>(j1) + G3;
+    auto const z1 = z0 - static_cast<T>(k1) + G3;
+    auto const x2 = x0 - static_cast<T>(i2) + T(2) * G3;
+    auto const y2 = y0 - static_cast<T>(j2) + T(2) * G3;
+    auto const z2 = z0 - static_cast<T>(k2) + T(2) * G3;
+    auto const x3 = x0 - T(1) + T(3) * G3;
+    auto const y3 = y0 - T(1) + T(3) * G3;
+    auto const z3 = z0 - T(1) + T(3) * G3;
+
+    auto const ii = i & 255;
+    auto const jj = j & 255;
+    auto const kk = k & 255;
+
+    auto const & p = m_perm;
+    auto const gi0 = m_permMod12[ii + p[jj + p[kk]]];
+    auto const gi1 = m_permMod12[ii + i1 + p[jj + j1 + p[kk + k1]]];
+    auto const gi2 = m_permMod12[ii + i2 + p[jj + j2 + p[kk + k2]]];
+    auto const gi3 = m_permMod12[ii + 1 + p[jj + 1 + p[kk + 1]]];
+
+    // Contributions of the four corners
+    T n = T(0);
+
+    auto t0 = T(0.6) - x0 * x0 - y0 * y0 - z0 * z0;
+    if(t0 > T(0)) { t0 *= t0; n += t0 * t0 * dot(s_grad3[gi0], x0, y0, z0); }
+
+    auto t1 = T(0.6) - x1 * x1 - y1 * y1 - z1 * z1;
+    if(t1 > T(0)) { t1 *= t1; n += t1 * t1 * dot(s_grad3[gi1], x1, y1, z1); }
+
+    auto t2 = T(0.6) - x2 * x2 - y2 * y2 - z2 * z2;
+    if(t2 > T(0)) { t2 *= t2; n += t2 * t2 * dot(s_grad3[gi2], x2, y2, z2); }
+
+    auto t3 = T(0.6) - x3 * x3 - y3 * y3 - z3 * z3;
+    if(t3 > T(0)) { t3 *= t3; n += t3 * t3 * dot(s_grad3[gi3], x3, y3, z3); }
+
+    return T(32) * n;
+}
+
+template <typename T>
+T Noise<T>::sample(NoiseBasis basis, T x, T y) const
+{
+    return basis == NoiseBasis::Simplex ? simplex(x, y) : perlin(x, y);
+}
+
+template <typename T>
+T Noise<T>::sample(NoiseBasis basis, T x, T y, T z) const
+{
+    return basis == NoiseBasis::Simplex ? simplex(x, y, z) : perlin(x, y, z);
+}
+
+// =============================================================================
+//   Fractal compositions
+// =============================================================================
+
+namespace {
+
+    struct Identity { template <typename T> T operator()(T n) const { return n; } };
+    struct Absolute { template <typename T> T operator()(T n) const { return std::abs(n); } };
+    struct Ridge
+    {
+        template <typename T> T operator()(T n) const
+        {
+            auto const r = T(1) - std::abs(n);
+            return r * r;
+        }
+    };
+
+    template <typename T, typename Shape, typename... Coords>
+    T sum_octaves(Noise<T> const & noise, NoiseBasis basis,
+        Fractal<T> const & f, Shape shape, Coords... coords)
+    {
+        T sum = T(0);
+        T frequency = f.frequency;
+        T amplitude = f.amplitude;
+
+        for(int o = 0; o < f.octaves; ++o)
+        {
+            sum += amplitude * shape(noise.sample(basis, (coords * frequency)...));
+            frequency *= f.lacunarity;
+            amplitude *= f.gain;
+        }
+
+        return sum;
+    }
+}
+
+template <typename T>
+T Noise<T>::fbm(NoiseBasis basis, Fractal<T> const & f, T x, T y) const
+{
+    return sum_octaves(*this, basis, f, Identity(), x, y);
+}
+
+template <typename T>
+T Noise<T>::fbm(NoiseBasis basis, Fractal<T> const & f, T x, T y, T z) const
+{
+    return sum_octaves(*this, basis, f, Identity(), x, y, z);
+}
+
+template <typename T>
+T Noise<T>::ridged(NoiseBasis basis, Fractal<T> const & f, T x, T y) const
+{
+    return sum_octaves(*this, basis, f, Ridge(), x, y);
+}
+
+template <typename T>
+T Noise<T>::ridged(NoiseBasis basis, Fractal<T> const & f, T x, T y, T z) const
+{
+    return sum_octaves(*this, basis, f, Ridge(), x, y, z);
+}
+
+template <typename T>
+T Noise<T>::turbulence(NoiseBasis basis, Fractal<T> const & f, T x, T y) const
+{
+    return sum_octaves(*this, basis, f, Absolute(), x, y);
+}
+
+template <typename T>
+T Noise<T>::turbulence(NoiseBasis basis, Fractal<T> const & f, T x, T y, T z) const
+{
+    return sum_octaves(*this, basis, f, Absolute(), x, y, z);
+}
+
+// =============================================================================
+//   Lattice noise
+// =============================================================================
+
+template <typename T>
+std::uint64_t Noise<T>::Hash(std::uint64_t seed, std::int64_t x, std::int64_t y)
+{
+    return hash(seed, x, y);
+}
+
+template <typename T>
+std::uint64_t Noise<T>::Hash(std::uint64_t seed, std::int64_t x, std::int64_t y,
+    std::int64_t z)
+{
+    return hash(seed, x, y, z);
+}
+
+template <typename T>
+T Noise<T>::perlin(Lattice const & origin, T x, T y, Lattice const & period) const
+{
+    T fx, fy;
+    auto const cx = split(origin.x, x, 1.0, fx);
+    auto const cy = split(origin.y, y, 1.0, fy);
+
+    return lattice_perlin(m_hashSeed, cx, cy, fx, fy, period);
+}
+
+template <typename T>
+T Noise<T>::perlin(Lattice const & origin, T x, T y, T z, Lattice const & period) const
+{
+    T fx, fy, fz;
+    auto const cx = split(origin.x, x, 1.0, fx);
+    auto const cy = split(origin.y, y, 1.0, fy);
+    auto const cz = split(origin.z, z, 1.0, fz);
+
+    return lattice_perlin(m_hashSeed, cx, cy, cz, fx, fy, fz, period);
+}
+
+template <typename T>
+T Noise<T>::fbm(Fractal<T> const & f, Lattice const & origin, T x, T y,
+    Lattice const & period) const
+{
+    return lattice_fbm(m_hashSeed, f, origin, x, y, T(0), T(0), period);
+}
+
+template <typename T>
+T Noise<T>::fbm(Fractal<T> const & f, Lattice const & origin, T x, T y, T z,
+    Lattice const & period) const
+{
+    return lattice_fbm(m_hashSeed, f, origin, x, y, z, T(0), T(0), T(0), period);
+}
+
+template <typename T>
+T Noise<T>::warp(Fractal<T> const & f, T strength, Lattice const & origin,
+    T x, T y, Lattice const & period) const
+{
+    // The displacement fields are the same noise shifted by whole cells :
+    // they stay periodic and chunk-consistent
+    auto const dx = fbm(f, offset(origin, WARP_X), x, y, period);
+    auto const dy = fbm(f, offset(origin, WARP_Y), x, y, period);
+
+    return lattice_fbm(m_hashSeed, f, origin, x, y,
+        strength * dx, strength * dy, period);
+}
+
+template <typename T>
+T Noise<T>::warp(Fractal<T> const & f, T strength, Lattice const & origin,
+    T x, T y, T z, Lattice const & period) const
+{
+    auto const dx = fbm(f, offset(origin, WARP_X), x, y, z, period);
+    auto const dy = fbm(f, offset(origin, WARP_Y), x, y, z, period);
+    auto const dz = fbm(f, offset(origin, WARP_Z), x, y, z, period);
+
+    return lattice_fbm(m_hashSeed, f, origin, x, y, z,
+        strength * dx, strength * dy, strength * dz, period);
+}
+
+template class Noise<float>;
+template class Noise<double>;
+
+}
@@ -0,0 +1,56 @@
+#include <cmath>
+
+#include <NoiseKernels.hpp>
+
+namespace RPi {
+
+namespace {
+
+    template <int Octaves, typename T, typename Kernel>
+    double total(std::uint64_t seed, double frequency, double x, double y)
+    {
+        using A = NoiseArithmetic<T>;
+
+        // Same axes as PerlinNoise::Total
+        return A::To(ValueNoise<Octaves, T, Kernel>::Total(seed,
+            A::From(y * frequency), A::From(x * frequency)));
+    }
+
+    #define RPI_VALUE_NOISE_OCTAVES(T, Kernel) \
+        { &total<1, T, Kernel>, &total<2, T, Kernel>, &total<3, T, Kernel>, \
+          &total<4, T, Kernel>, &total<5, T, Kernel>, &total<6, T, Kernel>, \
+          &total<7, T, Kernel>, &total<8, T, Kernel> }
+
+    #define RPI_VALUE_NOISE_KERNELS(T) \
+        { RPI_VALUE_NOISE_OCTAVES(T, LinearKernel), \
+          RPI_VALUE_NOISE_OCTAVES(T, CubicKernel), \
+          RPI_VALUE_NOISE_OCTAVES(T, QuinticKernel) }
+
+    // Indexed by precision, interpolation and octaves - 1
+    ValueNoiseFunc const s_kernels[3][3][MAX_KERNEL_OCTAVES] =
+    {
+        RPI_VALUE_NOISE_KERNELS(float),
+        RPI_VALUE_NOISE_KERNELS(double),
+        RPI_VALUE_NOISE_KERNELS(Fixed16)
+    };
+
+    #undef RPI_VALUE_NOISE_KERNELS
+    #undef RPI_VALUE_NOISE_OCTAVES
+
+    // Persistence of the specializations, the default std::ratio<1, 2>
+    double const KERNEL_PERSISTENCE = 0.5;
+}
+
+ValueNoiseFunc SelectValueNoise(int octaves, double persistence,
+    NoisePrecision precision, NoiseInterpolation interpolation)
+{
+    if(octaves < 1 || octaves > MAX_KERNEL_OCTAVES ||
+       std::fabs(persistence - KERNEL_PERSISTENCE) > PERSISTENCE_TOLERANCE)
+    {
+        return nullptr;
+    }
+
+    return s_kernels[static_cast<int>(precision)][static_cast<int>(interpolation)][octaves - 1];
+}
+
+}
@@ -8,18 +8,19 @@ Enums::AttribIndex const OpenGL::AttributeIndex[Enums::AttributeIndex_Count + 1]
     1,  //AttributeIndex_Normal
     2,  //AttributeIndex_Tangent
     3,  //AttributeIndex_TexCoord
-    4,  //AttributeIndex_UserData0
-    5,  //AttributeIndex_UserData1
-    6,  //AttributeIndex_UserData2
-    7,  //AttributeIndex_UserData3
-    8,  //AttributeIndex_UserData4
-    9,  //AttributeIndex_UserData5
-    10, //AttributeIndex_InstanceData0
-    11, //AttributeIndex_InstanceData1
-    12, //AttributeIndex_InstanceData2
-    13, //AttributeIndex_InstanceData3
-    14, //AttributeIndex_InstanceData4
-    15  //AttributeIndex_InstanceData5
+    4,  //AttributeIndex_Color
+    5,  //AttributeIndex_UserData0
+    6,  //AttributeIndex_UserData1
+    7,  //AttributeIndex_UserData2
+    8,  //AttributeIndex_UserData3
+    9,  //AttributeIndex_UserData4
+    10, //AttributeIndex_UserData5
+    11, //AttributeIndex_InstanceData0
+    12, //AttributeIndex_InstanceData1
+    13, //AttributeIndex_InstanceData2
+    14, //AttributeIndex_InstanceData3
+    15, //AttributeIndex_InstanceData4
+    16  //AttributeIndex_InstanceData5
 };
 
 
@@ -1,23 +1,22 @@
+#include <cmath>
+
+#include <Noise.hpp>
 #include <PerlinNoise.hpp>
 
 namespace RPi {
 
-PerlinNoise::PerlinNoise()
+PerlinNoise::PerlinNoise():
+  persistence(0), frequency(0), amplitude(0), octaves(0), randomseed(0),
+  kernel(nullptr)
 {
-  persistence = 0;
-  frequency = 0;
-  amplitude  = 0;
-  octaves = 0;
-  randomseed = 0;
+
 }
 
-PerlinNoise::PerlinNoise(double _persistence, double _frequency, double _amplitude, int _octaves, int _randomseed)
+PerlinNoise::PerlinNoise(double _persistence, double _frequency, double _amplitude, int _octaves, int _randomseed):
+  persistence(_persistence), frequency(_frequency), amplitude(_amplitude),
+  octaves(_octaves), randomseed(_randomseed), kernel(nullptr)
 {
-  persistence = _persistence;
-  frequency = _frequency;
-  amplitude  = _amplitude;
-  octaves = _octaves;
-  randomseed = 2 + _randomseed * _randomseed;
+  SelectKernel();
 }
 
 void PerlinNoise::Set(double _persistence, double _frequency, double _amplitude, int _octaves, int _randomseed)
@@ -26,14 +25,31 @@ void PerlinNoise::Set(double _persistence, double _frequency, double _amplitude,
   frequency = _frequency;
   amplitude  = _amplitude;
   octaves = _octaves;
-  randomseed = 2 + _randomseed * _randomseed;
+  randomseed = _randomseed;
+  SelectKernel();
 }
 
 double PerlinNoise::GetHeight(double x, double y) const
+{
+  if(kernel != nullptr)
+  {
+    return amplitude * kernel(static_cast<std::uint64_t>(randomseed), frequency, x, y);
+  }
+
+  return amplitude * Total(x, y);
+}
+
+double PerlinNoise::GetHeightGeneric(double x, double y) const
 {
   return amplitude * Total(x, y);
 }
 
+void PerlinNoise::SelectKernel()
+{
+  kernel = SelectValueNoise(octaves, persistence, NoisePrecision::Double,
+    NoiseInterpolation::Cubic);
+}
+
 double PerlinNoise::Total(double i, double j) const
 {
     //properties of one octave (changing each loop)
@@ -43,7 +59,7 @@ double PerlinNoise::Total(double i, double j) const
 
     for(int k = 0; k < octaves; k++) 
     {
-        t += GetValue(j * freq + randomseed, i * freq + randomseed) * _amplitude;
+        t += GetValue(j * freq, i * freq) * _amplitude;
         _amplitude *= persistence;
         freq *= 2;
     }
@@ -53,10 +69,11 @@ double PerlinNoise::Total(double i, double j) const
 
 double PerlinNoise::GetValue(double x, double y) const
 {
-    int Xint = (int)x;
-    int Yint = (int)y;
-    double Xfrac = x - Xint;
-    double Yfrac = y - Yint;
+    // 64-bit cells : no overflow for large coordinates
+    auto const Xint = static_cast<std::int64_t>(std::floor(x));
+    auto const Yint = static_cast<std::int64_t>(std::floor(y));
+    double Xfrac = x - static_cast<double>(Xint);
+    double Yfrac = y - static_cast<double>(Yint);
 
   //noise values
   double n01 = Noise(Xint-1, Yint-1);
@@ -104,12 +121,11 @@ double PerlinNoise::Interpolate(double x, double y, double a) const
     return x * fac1 + y * fac2; //add the weighted factors
 }
 
-double PerlinNoise::Noise(int x, int y) const
+double PerlinNoise::Noise(std::int64_t x, std::int64_t y) const
 {
-    int n = x + y * 57;
-    n = (n << 13) ^ n;
-  int t = (n * (n * n * 15731 + 789221) + 1376312589) & 0x7fffffff;
-    return 1.0 - double(t) * 0.931322574615478515625e-9;/// 1073741824.0);
+    // The seed goes through the hash rather than offsetting the coordinates
+    auto const h = RPi::Noise<double>::Hash(static_cast<std::uint64_t>(randomseed), x, y);
+    return 1.0 - double(h >> 33) * 0.931322574615478515625e-9;/// 1073741824.0);
 }
 
 }
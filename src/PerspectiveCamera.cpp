@@ -1,5 +1,4 @@
 #include <glm/gtx/transform.hpp>
-#include <iostream>
 
 #include <PerspectiveCamera.hpp>
 
@@ -21,7 +20,7 @@ PerspectiveCamera::PerspectiveCamera(float fov, float r,
 
 PerspectiveCamera::~PerspectiveCamera()
 {
-    std::cout << "PerspectiveCamera destroyed" << std::endl;
+
 }
 
 glm::mat4 const & PerspectiveCamera::projection()
@@ -0,0 +1,302 @@
+#include <cstdio>
+#include <iostream>
+
+#include <Qoi.hpp>
+
+// See https://qoiformat.org/qoi-specification.pdf
+
+namespace RPi {
+
+namespace Qoi {
+
+namespace {
+
+    struct Pixel
+    {
+        std::uint8_t r, g, b, a;
+
+        bool operator==(Pixel const & p) const
+        {
+            return r == p.r && g == p.g && b == p.b && a == p.a;
+        }
+    };
+
+    void put32(std::vector<std::uint8_t> & out, std::uint32_t value)
+    {
+        out.push_back(static_cast<std::uint8_t>(value >> 24));
+        out.push_back(static_cast<std::uint8_t>(value >> 16));
+        out.push_back(static_cast<std::uint8_t>(value >> 8));
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::uint32_t get32(std::uint8_t const * data)
+    {
+        return static_cast<std::uint32_t>(data[0]) << 24 |
+               static_cast<std::uint32_t>(data[1]) << 16 |
+               static_cast<std::uint32_t>(data[2]) << 8 |
+               static_cast<std::uint32_t>(data[3]);
+    }
+
+    std::size_t const HEADER = 14;
+    std::size_t const PADDING = 8;
+
+    std::size_t hash(Pixel const & p)
+    {
+        return (p.r * 3 + p.g * 5 + p.b * 7 + p.a * 11) % 64;
+    }
+
+    // Channel plus a difference, wrapping around as the specification says
+    std::uint8_t add(std::uint8_t channel, int difference)
+    {
+        return static_cast<std::uint8_t>(channel + difference);
+    }
+}
+
+void Encode(std::uint8_t const * pixels, int width, int height,
+    std::vector<std::uint8_t> & out)
+{
+    out.clear();
+    out.reserve(HEADER + static_cast<std::size_t>(width) * height * 5 + PADDING);
+
+    out.push_back('q'); out.push_back('o'); out.push_back('i'); out.push_back('f');
+    put32(out, static_cast<std::uint32_t>(width));
+    put32(out, static_cast<std::uint32_t>(height));
+    out.push_back(4); // RGBA
+    out.push_back(0); // sRGB
+
+    Pixel index[64] = {};
+    Pixel previous = { 0, 0, 0, 255 };
+    int run = 0;
+
+    // glReadPixels returns the bottom row first
+    for(int y = height - 1; y >= 0; --y)
+    {
+        auto const row = pixels + static_cast<std::size_t>(y) * width * 4;
+
+        for(int x = 0; x < width; ++x)
+        {
+            Pixel const p = { row[x * 4], row[x * 4 + 1], row[x * 4 + 2], row[x * 4 + 3] };
+
+            if(p == previous)
+            {
+                if(++run == 62)
+                {
+                    out.push_back(static_cast<std::uint8_t>(0xc0 | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+
+            if(run > 0)
+            {
+                out.push_back(static_cast<std::uint8_t>(0xc0 | (run - 1)));
+                run = 0;
+            }
+
+            auto const i = hash(p);
+
+            if(index[i] == p)
+            {
+                out.push_back(static_cast<std::uint8_t>(i));
+            }
+            else
+            {
+                index[i] = p;
+
+                if(p.a == previous.a)
+                {
+                    auto const dr = static_cast<std::int8_t>(p.r - previous.r);
+                    auto const dg = static_cast<std::int8_t>(p.g - previous.g);
+                    auto const db = static_cast<std::int8_t>(p.b - previous.b);
+                    auto const drg = dr - dg;
+                    auto const dbg = db - dg;
+
+                    if(dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+                    {
+                        out.push_back(static_cast<std::uint8_t>(
+                            0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    }
+                    else if(dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 &&
+                            dbg >= -8 && dbg <= 7)
+                    {
+                        out.push_back(static_cast<std::uint8_t>(0x80 | (dg + 32)));
+                        out.push_back(static_cast<std::uint8_t>((drg + 8) << 4 | (dbg + 8)));
+                    }
+                    else
+                    {
+                        out.push_back(0xfe);
+                        out.push_back(p.r);
+                        out.push_back(p.g);
+                        out.push_back(p.b);
+                    }
+                }
+                else
+                {
+                    out.push_back(0xff);
+                    out.push_back(p.r);
+                    out.push_back(p.g);
+                    out.push_back(p.b);
+                    out.push_back(p.a);
+                }
+            }
+
+            previous = p;
+        }
+    }
+
+    if(run > 0)
+    {
+        out.push_back(static_cast<std::uint8_t>(0xc0 | (run - 1)));
+    }
+
+    for(int i = 0; i < 7; ++i) out.push_back(0);
+    out.push_back(1);
+}
+
+bool Decode(std::vector<std::uint8_t> const & data, int & width, int & height,
+    std::vector<std::uint8_t> & pixels)
+{
+    if(data.size() < HEADER + PADDING || data[0] != 'q' || data[1] != 'o' ||
+       data[2] != 'i' || data[3] != 'f')
+    {
+        return false;
+    }
+
+    width = static_cast<int>(get32(&data[4]));
+    height = static_cast<int>(get32(&data[8]));
+
+    if(width <= 0 || height <= 0 || width > 16384 || height > 16384) return false;
+
+    pixels.resize(static_cast<std::size_t>(width) * height * 4);
+
+    Pixel index[64] = {};
+    Pixel p = { 0, 0, 0, 255 };
+    int run = 0;
+
+    auto in = data.data() + HEADER;
+    auto const end = data.data() + data.size() - PADDING;
+
+    for(int y = height - 1; y >= 0; --y)
+    {
+        auto row = &pixels[static_cast<std::size_t>(y) * width * 4];
+
+        for(int x = 0; x < width; ++x)
+        {
+            if(run > 0)
+            {
+                --run;
+            }
+            else
+            {
+                if(in >= end) return false;
+
+                auto const tag = *in++;
+
+                if(tag == 0xfe)
+                {
+                    if(end - in < 3) return false;
+                    p.r = in[0];
+                    p.g = in[1];
+                    p.b = in[2];
+                    in += 3;
+                }
+                else if(tag == 0xff)
+                {
+                    if(end - in < 4) return false;
+                    p.r = in[0];
+                    p.g = in[1];
+                    p.b = in[2];
+                    p.a = in[3];
+                    in += 4;
+                }
+                else if((tag & 0xc0) == 0x00)
+                {
+                    p = index[tag];
+                }
+                else if((tag & 0xc0) == 0x40)
+                {
+                    p.r = add(p.r, ((tag >> 4) & 3) - 2);
+                    p.g = add(p.g, ((tag >> 2) & 3) - 2);
+                    p.b = add(p.b, (tag & 3) - 2);
+                }
+                else if((tag & 0xc0) == 0x80)
+                {
+                    if(in >= end) return false;
+                    auto const dg = (tag & 0x3f) - 32;
+                    auto const next = *in++;
+                    p.r = add(p.r, dg - 8 + (next >> 4));
+                    p.g = add(p.g, dg);
+                    p.b = add(p.b, dg - 8 + (next & 0x0f));
+                }
+                else
+                {
+                    run = tag & 0x3f;
+                }
+
+                index[hash(p)] = p;
+            }
+
+            row[x * 4] = p.r;
+            row[x * 4 + 1] = p.g;
+            row[x * 4 + 2] = p.b;
+            row[x * 4 + 3] = p.a;
+        }
+    }
+
+    return true;
+}
+
+bool Save(std::string const & filename, std::uint8_t const * pixels, int width, int height)
+{
+    std::vector<std::uint8_t> data;
+    Encode(pixels, width, height, data);
+
+    auto const file = std::fopen(filename.c_str(), "wb");
+
+    auto const written = file != nullptr &&
+        std::fwrite(data.data(), 1, data.size(), file) == data.size();
+
+    if(file != nullptr) std::fclose(file);
+
+    if(!written)
+    {
+        std::cerr << "Qoi::Save : Failed to write " << filename << std::endl;
+    }
+
+    return written;
+}
+
+bool Load(std::string const & filename, int & width, int & height,
+    std::vector<std::uint8_t> & pixels)
+{
+    auto const file = std::fopen(filename.c_str(), "rb");
+
+    if(file == nullptr)
+    {
+        std::cerr << "Qoi::Load : Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> data;
+    std::uint8_t chunk[4096];
+    std::size_t read;
+
+    while((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+
+    std::fclose(file);
+
+    if(!Decode(data, width, height, pixels))
+    {
+        std::cerr << "Qoi::Load : " << filename << " is not a QOI image" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+}
@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <Memory.hpp>
+#include <Recording.hpp>
+
+namespace RPi {
+
+namespace {
+
+    char const MAGIC[4] = { 'R', 'P', 'I', 'R' };
+    std::uint16_t const VERSION = 1;
+
+    enum Flags : std::uint8_t
+    {
+        Flags_Keys    = 1 << 0,
+        Flags_Buttons = 1 << 1,
+        Flags_Motion  = 1 << 2,
+        Flags_Wheel   = 1 << 3
+    };
+
+    template <typename T>
+    void write(std::ostream & out, T const & value)
+    {
+        out.write(reinterpret_cast<char const *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool read(std::istream & in, T & value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    // Bitwise : the replay must see exactly the recorded value
+    bool changed(float a, float b)
+    {
+        return std::memcmp(&a, &b, sizeof(float)) != 0;
+    }
+
+    std::int16_t clamp16(int v)
+    {
+        return static_cast<std::int16_t>(std::min(std::max(v, -32768), 32767));
+    }
+
+    void write(std::ostream & out, glm::vec3 const & v)
+    {
+        write(out, v.x);
+        write(out, v.y);
+        write(out, v.z);
+    }
+
+    bool read(std::istream & in, glm::vec3 & v)
+    {
+        return read(in, v.x) && read(in, v.y) && read(in, v.z);
+    }
+}
+
+// =============================================================================
+//   InputRecorder
+// =============================================================================
+
+InputRecorder::InputRecorder():
+    m_file(), m_previous(), m_frames(0)
+{
+
+}
+
+InputRecorder::~InputRecorder()
+{
+    close();
+}
+
+bool InputRecorder::open(std::string const & filename, float timestep,
+    std::uint32_t seed)
+{
+    Memory::TagScope tag(Memory::Tag::Recording);
+
+    close();
+
+    m_file.open(filename, std::ios::binary | std::ios::trunc);
+
+    if(!m_file)
+    {
+        std::cerr << "InputRecorder::open : Failed to create " << filename << std::endl;
+        return false;
+    }
+
+    m_file.write(MAGIC, sizeof(MAGIC));
+    write(m_file, VERSION);
+    write(m_file, std::uint16_t(0));
+    write(m_file, timestep);
+    write(m_file, seed);
+
+    m_previous = Input::State();
+    m_frames = 0;
+
+    return true;
+}
+
+void InputRecorder::record(Input::State const & input, CameraPose const & pose)
+{
+    if(!m_file.is_open()) return;
+
+    Memory::TagScope tag(Memory::Tag::Recording);
+
+    std::uint8_t flags = 0;
+
+    if(input.keys != m_previous.keys) flags |= Flags_Keys;
+    if(input.mouseBtns != m_previous.mouseBtns) flags |= Flags_Buttons;
+
+    if(input.x != m_previous.x || input.y != m_previous.y ||
+       input.xRel != m_previous.xRel || input.yRel != m_previous.yRel)
+    {
+        flags |= Flags_Motion;
+    }
+
+    if(changed(input.wheel, m_previous.wheel)) flags |= Flags_Wheel;
+
+    write(m_file, flags);
+
+    if(flags & Flags_Keys)
+    {
+        std::vector<std::uint16_t> pressed;
+
+        for(std::size_t k = 0; k < input.keys.size(); ++k)
+        {
+            if(input.keys[k]) pressed.push_back(static_cast<std::uint16_t>(k));
+        }
+
+        // More than 255 keys at once is not a real input
+        pressed.resize(std::min<std::size_t>(pressed.size(), 255));
+
+        write(m_file, static_cast<std::uint8_t>(pressed.size()));
+        for(auto k : pressed) write(m_file, k);
+    }
+
+    if(flags & Flags_Buttons)
+    {
+        std::uint8_t mask = 0;
+
+        for(std::size_t b = 0; b < input.mouseBtns.size(); ++b)
+        {
+            if(input.mouseBtns[b]) mask |= static_cast<std::uint8_t>(1 << b);
+        }
+
+        write(m_file, mask);
+    }
+
+    if(flags & Flags_Motion)
+    {
+        write(m_file, clamp16(input.x));
+        write(m_file, clamp16(input.y));
+        write(m_file, clamp16(input.xRel));
+        write(m_file, clamp16(input.yRel));
+    }
+
+    if(flags & Flags_Wheel)
+    {
+        write(m_file, input.wheel);
+    }
+
+    write(m_file, pose.position);
+    write(m_file, pose.target);
+
+    // Same state as the one the player starts the next frame from
+    m_previous = input;
+    m_previous.xRel = 0;
+    m_previous.yRel = 0;
+
+    ++m_frames;
+}
+
+void InputRecorder::close()
+{
+    if(m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+bool InputRecorder::isOpen() const
+{
+    return m_file.is_open();
+}
+
+std::size_t InputRecorder::frames() const
+{
+    return m_frames;
+}
+
+// =============================================================================
+//   InputPlayer
+// =============================================================================
+
+InputPlayer::InputPlayer():
+    m_file(), m_state(), m_timestep(0.f), m_seed(0), m_frames(0)
+{
+
+}
+
+bool InputPlayer::open(std::string const & filename)
+{
+    Memory::TagScope tag(Memory::Tag::Recording);
+
+    m_file.open(filename, std::ios::binary);
+
+    if(!m_file)
+    {
+        std::cerr << "InputPlayer::open : Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    std::uint16_t version = 0;
+    std::uint16_t reserved = 0;
+
+    if(!m_file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, MAGIC) ||
+       !read(m_file, version) || !read(m_file, reserved) ||
+       !read(m_file, m_timestep) || !read(m_file, m_seed))
+    {
+        std::cerr << "InputPlayer::open : " << filename << " is not a recording" << std::endl;
+        m_file.close();
+        return false;
+    }
+
+    if(version != VERSION)
+    {
+        std::cerr << "InputPlayer::open : Unsupported version " << version << std::endl;
+        m_file.close();
+        return false;
+    }
+
+    m_state = Input::State();
+    m_frames = 0;
+
+    return true;
+}
+
+bool InputPlayer::next(Input::State & input, CameraPose & pose)
+{
+    std::uint8_t flags = 0;
+
+    if(!m_file.is_open() || !read(m_file, flags)) return false;
+
+    // Relative motions only last one frame
+    m_state.xRel = 0;
+    m_state.yRel = 0;
+
+    bool ok = true;
+
+    if(flags & Flags_Keys)
+    {
+        std::uint8_t count = 0;
+        ok = read(m_file, count);
+
+        m_state.keys.fill(false);
+
+        for(std::uint8_t i = 0; ok && i < count; ++i)
+        {
+            std::uint16_t k = 0;
+            ok = read(m_file, k);
+            if(ok && k < m_state.keys.size()) m_state.keys[k] = true;
+        }
+    }
+
+    if(ok && (flags & Flags_Buttons))
+    {
+        std::uint8_t mask = 0;
+        ok = read(m_file, mask);
+
+        for(std::size_t b = 0; b < m_state.mouseBtns.size(); ++b)
+        {
+            m_state.mouseBtns[b] = (mask >> b) & 1;
+        }
+    }
+
+    if(ok && (flags & Flags_Motion))
+    {
+        std::int16_t v[4];
+        ok = read(m_file, v[0]) && read(m_file, v[1]) && read(m_file, v[2]) && read(m_file, v[3]);
+
+        m_state.x = v[0];
+        m_state.y = v[1];
+        m_state.xRel = v[2];
+        m_state.yRel = v[3];
+    }
+
+    if(ok && (flags & Flags_Wheel))
+    {
+        ok = read(m_file, m_state.wheel);
+    }
+
+    ok = ok && read(m_file, pose.position) && read(m_file, pose.target);
+
+    if(!ok)
+    {
+        std::cerr << "InputPlayer::next : Truncated frame " << m_frames << std::endl;
+        m_file.close();
+        return false;
+    }
+
+    input = m_state;
+    ++m_frames;
+
+    return true;
+}
+
+bool InputPlayer::isOpen() const
+{
+    return m_file.is_open();
+}
+
+float InputPlayer::timestep() const
+{
+    return m_timestep;
+}
+
+std::uint32_t InputPlayer::seed() const
+{
+    return m_seed;
+}
+
+std::size_t InputPlayer::frames() const
+{
+    return m_frames;
+}
+
+}
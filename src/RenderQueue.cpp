@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <array>
+
+#include <GLSLProgram.hpp>
+#include <Memory.hpp>
+#include <RenderQueue.hpp>
+#include <VertexFormat.hpp>
+
+namespace RPi {
+
+namespace {
+
+    int const PASS_SHIFT    = 60;
+    int const PROGRAM_SHIFT = 50;
+    int const BUFFER_SHIFT  = 36;
+    int const DEPTH_SHIFT   = 12;
+
+    std::uint64_t const MAX_PROGRAM = (1u << 10) - 1;
+    std::uint64_t const MAX_BUFFER  = (1u << 14) - 1;
+    std::uint64_t const MAX_DEPTH   = (1u << 24) - 1;
+
+    std::size_t index_size(GLenum type)
+    {
+        return type == GL_UNSIGNED_BYTE ? 1 : type == GL_UNSIGNED_SHORT ? 2 : 4;
+    }
+
+    float front_to_back(std::size_t ordered, std::size_t draws)
+    {
+        return draws > 1 ? static_cast<float>(ordered) / static_cast<float>(draws - 1) : 1.f;
+    }
+}
+
+DrawItem::DrawItem():
+    pass(RenderPass::Opaque), program(nullptr), vertexBuffer(0), indexBuffer(0),
+    format(nullptr), vertexOffset(0), setup(), object(nullptr), modelView(1.f), center(0.f),
+    mode(GL_TRIANGLES), first(0), count(0), indexType(GL_UNSIGNED_SHORT), draw()
+{
+
+}
+
+RenderStats::RenderStats():
+    draws(0), programChanges(0), programBinds(0), bufferChanges(0), formatChanges(0), setups(0),
+    matrixUploads(0), unsortedProgramChanges(0), unsortedBufferChanges(0),
+    frontToBack(1.f), unsortedFrontToBack(1.f)
+{
+
+}
+
+RenderQueue::RenderQueue(float farDepth):
+    m_farDepth(farDepth), m_items(), m_entries(), m_scratch(), m_depths(),
+    m_programs(), m_buffers(), m_sorted(true), m_stats()
+{
+
+}
+
+void RenderQueue::clear()
+{
+    m_items.clear();
+    m_entries.clear();
+    m_depths.clear();
+    m_sorted = true;
+}
+
+void RenderQueue::add(DrawItem const & item)
+{
+    Memory::TagScope tag(Memory::Tag::Scene);
+
+    // Distance in front of the camera
+    auto const depth = -(item.modelView * glm::vec4(item.center, 1.f)).z;
+
+    m_entries.push_back({ key(item, depth), static_cast<std::uint32_t>(m_items.size()) });
+    m_items.push_back(item);
+    m_depths.push_back(depth);
+
+    m_sorted = false;
+}
+
+std::size_t RenderQueue::size() const
+{
+    return m_items.size();
+}
+
+std::uint64_t RenderQueue::key(DrawItem const & item, float depth)
+{
+    auto const pass = static_cast<std::uint64_t>(item.pass);
+
+    // Overlay draws keep their order of submission
+    if(item.pass == RenderPass::Overlay || item.draw)
+    {
+        return pass << PASS_SHIFT;
+    }
+
+    auto const d = std::min(std::max(depth / m_farDepth, 0.f), 1.f);
+    auto q = static_cast<std::uint64_t>(d * MAX_DEPTH);
+
+    if(item.pass == RenderPass::Transparent)
+    {
+        q = MAX_DEPTH - q;
+    }
+
+    return pass << PASS_SHIFT
+         | programId(item.program) << PROGRAM_SHIFT
+         | bufferId(item.vertexBuffer) << BUFFER_SHIFT
+         | q << DEPTH_SHIFT;
+}
+
+std::uint64_t RenderQueue::programId(GLSLProgram const * program)
+{
+    auto const it = std::find(m_programs.begin(), m_programs.end(), program);
+
+    if(it != m_programs.end())
+    {
+        return std::min<std::uint64_t>(it - m_programs.begin(), MAX_PROGRAM);
+    }
+
+    m_programs.push_back(program);
+
+    return std::min<std::uint64_t>(m_programs.size() - 1, MAX_PROGRAM);
+}
+
+std::uint64_t RenderQueue::bufferId(GLuint buffer)
+{
+    auto const it = std::find(m_buffers.begin(), m_buffers.end(), buffer);
+
+    if(it != m_buffers.end())
+    {
+        return std::min<std::uint64_t>(it - m_buffers.begin(), MAX_BUFFER);
+    }
+
+    m_buffers.push_back(buffer);
+
+    return std::min<std::uint64_t>(m_buffers.size() - 1, MAX_BUFFER);
+}
+
+void RenderQueue::sort()
+{
+    if(m_sorted) return;
+
+    auto const n = m_entries.size();
+
+    // Histograms of the 8 bytes of the keys in one pass
+    std::array<std::array<std::uint32_t, 256>, 8> counts{};
+
+    for(auto const & e : m_entries)
+    {
+        for(int b = 0; b < 8; ++b)
+        {
+            ++counts[b][(e.key >> (8 * b)) & 0xFF];
+        }
+    }
+
+    m_scratch.resize(n);
+
+    // Least significant byte first, skipping the bytes equal in every key
+    for(int b = 0; b < 8; ++b)
+    {
+        auto & count = counts[b];
+
+        if(std::find(count.begin(), count.end(), n) != count.end()) continue;
+
+        std::uint32_t offset = 0;
+
+        for(auto & c : count)
+        {
+            auto const c0 = c;
+            c = offset;
+            offset += c0;
+        }
+
+        for(auto const & e : m_entries)
+        {
+            m_scratch[count[(e.key >> (8 * b)) & 0xFF]++] = e;
+        }
+
+        m_entries.swap(m_scratch);
+    }
+
+    m_sorted = true;
+}
+
+void RenderQueue::submit(glm::mat4 const & projection)
+{
+    sort();
+
+    m_stats = RenderStats();
+    countUnsorted();
+
+    auto const binds = GLSLProgram::BindCount();
+
+    GLSLProgram const * program = nullptr;
+    VertexFormat const * format = nullptr;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+    std::size_t vertexOffset = 0;
+    void const * object = nullptr;
+    glm::mat4 modelView;
+
+    // Whether the GL state is the one described by the variables above
+    auto bound = false;
+
+    auto release = [&]()
+    {
+        if(format != nullptr) format->disable();
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        if(program != nullptr) program->unbind();
+
+        program = nullptr;
+        format = nullptr;
+        bound = false;
+    };
+
+    std::size_t ordered = 0;
+    std::size_t opaque = 0;
+    float lastDepth = 0.f;
+
+    for(auto const & e : m_entries)
+    {
+        auto const & item = m_items[e.item];
+
+        if(item.draw)
+        {
+            if(bound) release();
+            item.draw();
+            continue;
+        }
+
+        auto changed = false;
+        auto setup = false;
+
+        if(!bound || item.program != program)
+        {
+            program = item.program;
+            program->bind();
+            program->sendMatrix("MatProjection", projection);
+
+            ++m_stats.programChanges;
+            changed = true;
+            setup = true;
+        }
+
+        if(!bound || item.vertexBuffer != vertexBuffer)
+        {
+            vertexBuffer = item.vertexBuffer;
+            glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+            ++m_stats.bufferChanges;
+            changed = true;
+        }
+
+        if(!bound || item.indexBuffer != indexBuffer)
+        {
+            indexBuffer = item.indexBuffer;
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        }
+
+        // The attribute pointers are relative to the bound vertex buffer
+        if(changed || item.format != format || item.vertexOffset != vertexOffset)
+        {
+            if(format != nullptr && format != item.format) format->disable();
+
+            format = item.format;
+            vertexOffset = item.vertexOffset;
+            format->enable(vertexOffset);
+
+            ++m_stats.formatChanges;
+
+            if(item.object == nullptr) setup = true;
+        }
+
+        if(item.object != object)
+        {
+            object = item.object;
+            setup = true;
+        }
+
+        if(setup && item.setup)
+        {
+            item.setup(*program);
+
+            ++m_stats.setups;
+        }
+
+        if(changed || item.modelView != modelView)
+        {
+            modelView = item.modelView;
+            program->sendMatrix("MatModelView", modelView);
+
+            ++m_stats.matrixUploads;
+        }
+
+        bound = true;
+
+        if(indexBuffer != 0)
+        {
+            glDrawElements(item.mode, item.count, item.indexType,
+                reinterpret_cast<void const *>(item.first * index_size(item.indexType)));
+        }
+        else
+        {
+            glDrawArrays(item.mode, item.first, item.count);
+        }
+
+        ++m_stats.draws;
+
+        if(item.pass == RenderPass::Opaque)
+        {
+            auto const depth = m_depths[e.item];
+
+            if(opaque++ > 0 && depth >= lastDepth) ++ordered;
+            lastDepth = depth;
+        }
+    }
+
+    if(bound) release();
+
+    m_stats.programBinds = GLSLProgram::BindCount() - binds;
+    m_stats.frontToBack = front_to_back(ordered, opaque);
+}
+
+void RenderQueue::countUnsorted()
+{
+    GLSLProgram const * program = nullptr;
+    GLuint vertexBuffer = 0;
+    auto first = true;
+
+    std::size_t ordered = 0;
+    std::size_t opaque = 0;
+    float lastDepth = 0.f;
+
+    for(std::size_t i = 0; i < m_items.size(); ++i)
+    {
+        auto const & item = m_items[i];
+
+        if(item.draw)
+        {
+            first = true;
+            continue;
+        }
+
+        if(first || item.program != program) ++m_stats.unsortedProgramChanges;
+        if(first || item.vertexBuffer != vertexBuffer) ++m_stats.unsortedBufferChanges;
+
+        program = item.program;
+        vertexBuffer = item.vertexBuffer;
+        first = false;
+
+        if(item.pass == RenderPass::Opaque)
+        {
+            if(opaque++ > 0 && m_depths[i] >= lastDepth) ++ordered;
+            lastDepth = m_depths[i];
+        }
+    }
+
+    m_stats.unsortedFrontToBack = front_to_back(ordered, opaque);
+}
+
+RenderStats const & RenderQueue::stats() const
+{
+    return m_stats;
+}
+
+DrawItem const & RenderQueue::sorted(std::size_t i) const
+{
+    return m_items[m_entries[i].item];
+}
+
+}
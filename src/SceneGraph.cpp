@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+#include <glm/gtx/transform.hpp>
+
+#include <Memory.hpp>
+#include <SceneGraph.hpp>
+
+namespace RPi {
+
+SceneGraph::Node const SceneGraph::None = std::numeric_limits<SceneGraph::Node>::max();
+
+SceneGraph::SceneGraph():
+    m_slots(), m_parentNodes(), m_nodes(), m_parents(), m_subtrees(),
+    m_locals(), m_worlds(), m_dirty(), m_dirtySlots(), m_sorted(true)
+{
+
+}
+
+SceneGraph::Node SceneGraph::add(Node parent, glm::mat4 const & local)
+{
+    Memory::TagScope tag(Memory::Tag::Scene);
+
+    auto const node = m_nodes.size();
+    auto const parentSlot = parent == None ? None : m_slots[parent];
+
+    // Appending keeps the depth-first order if the node is a new root or if
+    // the subtree of its parent ends the arrays
+    if(m_sorted && parentSlot != None)
+    {
+        if(parentSlot + m_subtrees[parentSlot] == node)
+        {
+            for(auto s = parentSlot; s != None; s = m_parents[s])
+            {
+                ++m_subtrees[s];
+            }
+        }
+        else
+        {
+            m_sorted = false;
+        }
+    }
+
+    m_slots.push_back(node);
+    m_parentNodes.push_back(parent);
+
+    m_nodes.push_back(node);
+    m_parents.push_back(parentSlot);
+    m_subtrees.push_back(1);
+    m_locals.push_back(local);
+    m_worlds.push_back(local);
+    m_dirty.push_back(0);
+
+    markDirty(node);
+
+    return node;
+}
+
+std::size_t SceneGraph::size() const
+{
+    return m_nodes.size();
+}
+
+SceneGraph::Node SceneGraph::parent(Node node) const
+{
+    return m_parentNodes[node];
+}
+
+bool SceneGraph::parent(Node node, Node parent)
+{
+    for(auto p = parent; p != None; p = m_parentNodes[p])
+    {
+        if(p == node)
+        {
+            std::cerr << "SceneGraph : node " << parent << " is in the subtree of node "
+                      << node << std::endl;
+            return false;
+        }
+    }
+
+    m_parentNodes[node] = parent;
+    m_sorted = false;
+
+    return true;
+}
+
+void SceneGraph::local(Node node, glm::mat4 const & local)
+{
+    auto const slot = m_slots[node];
+
+    m_locals[slot] = local;
+    markDirty(slot);
+}
+
+glm::mat4 const & SceneGraph::local(Node node) const
+{
+    return m_locals[m_slots[node]];
+}
+
+void SceneGraph::translate(Node node, glm::vec3 const & offset)
+{
+    local(node, glm::translate(local(node), offset));
+}
+
+void SceneGraph::rotate(Node node, float angle, glm::vec3 const & axis)
+{
+    local(node, glm::rotate(local(node), angle, axis));
+}
+
+glm::mat4 const & SceneGraph::world(Node node) const
+{
+    return m_worlds[m_slots[node]];
+}
+
+bool SceneGraph::dirty() const
+{
+    return !m_sorted || !m_dirtySlots.empty();
+}
+
+std::size_t SceneGraph::update()
+{
+    if(!m_sorted)
+    {
+        sort();
+    }
+
+    if(m_dirtySlots.empty())
+    {
+        return 0;
+    }
+
+    std::sort(m_dirtySlots.begin(), m_dirtySlots.end());
+
+    std::size_t updated = 0;
+    std::size_t end = 0;
+
+    for(auto s : m_dirtySlots)
+    {
+        // Already recomputed with the subtree of an ancestor
+        if(s < end) continue;
+
+        // The parents of the subtree come first : their world matrices are
+        // up to date when their children are reached
+        end = s + m_subtrees[s];
+
+        for(auto i = s; i < end; ++i)
+        {
+            auto const p = m_parents[i];
+
+            m_worlds[i] = p == None ? m_locals[i] : m_worlds[p] * m_locals[i];
+            m_dirty[i] = 0;
+        }
+
+        updated += end - s;
+    }
+
+    m_dirtySlots.clear();
+
+    return updated;
+}
+
+void SceneGraph::sort()
+{
+    auto const n = m_nodes.size();
+
+    // Children of every node, in order of creation
+    std::vector<std::size_t> first(n + 1, 0);
+    std::vector<Node> children(n);
+    std::vector<Node> roots;
+
+    for(Node node = 0; node < n; ++node)
+    {
+        auto const p = m_parentNodes[node];
+
+        if(p == None) roots.push_back(node);
+        else          ++first[p + 1];
+    }
+
+    std::partial_sum(first.begin(), first.end(), first.begin());
+
+    std::vector<std::size_t> next(first.begin(), first.end() - 1);
+
+    for(Node node = 0; node < n; ++node)
+    {
+        auto const p = m_parentNodes[node];
+        if(p != None) children[next[p]++] = node;
+    }
+
+    // Depth-first order
+    std::vector<Node> order;
+    std::vector<Node> stack;
+
+    order.reserve(n);
+
+    for(auto root : roots)
+    {
+        stack.push_back(root);
+
+        while(!stack.empty())
+        {
+            auto const node = stack.back();
+            stack.pop_back();
+
+            order.push_back(node);
+
+            for(auto c = first[node + 1]; c > first[node]; --c)
+            {
+                stack.push_back(children[c - 1]);
+            }
+        }
+    }
+
+    std::vector<glm::mat4> locals(n);
+
+    for(std::size_t s = 0; s < n; ++s)
+    {
+        locals[s] = m_locals[m_slots[order[s]]];
+    }
+
+    for(std::size_t s = 0; s < n; ++s)
+    {
+        m_slots[order[s]] = s;
+    }
+
+    for(std::size_t s = 0; s < n; ++s)
+    {
+        auto const p = m_parentNodes[order[s]];
+        m_parents[s] = p == None ? None : m_slots[p];
+    }
+
+    std::fill(m_subtrees.begin(), m_subtrees.end(), 1);
+
+    for(auto s = n; s-- > 0;)
+    {
+        if(m_parents[s] != None) m_subtrees[m_parents[s]] += m_subtrees[s];
+    }
+
+    m_nodes.swap(order);
+    m_locals.swap(locals);
+
+    // The world matrices moved with their nodes : recompute them all
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+    m_dirtySlots.clear();
+
+    for(auto s : roots)
+    {
+        markDirty(m_slots[s]);
+    }
+
+    m_sorted = true;
+}
+
+void SceneGraph::markDirty(std::size_t slot)
+{
+    if(!m_dirty[slot])
+    {
+        m_dirty[slot] = 1;
+        m_dirtySlots.push_back(slot);
+    }
+}
+
+}
@@ -1,7 +1,13 @@
 #include <Terrain.hpp>
-#include <PerlinNoise.hpp>
+#include <BufferManager.hpp>
+#include <Heightfield.hpp>
+#include <Memory.hpp>
+#include <Noise.hpp>
 #include <OpenGL.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -9,93 +15,121 @@ namespace RPi {
 
 namespace {
 
-inline double findnoise2(double x,double y)
-{
-    int n=(int)x+(int)y*57;
-    n=(n<<13)^n;
-    int nn=(n*(n*n*60493+19990303)+1376312589)&0x7fffffff;
-    return 1.0-((double)nn/1073741824.0);
-}
+    // Distance between two samples of the grid
+    float const GRID_STEP = 0.2f;
 
-inline double interpolate(double a,double b,double x)
-{
-    double ft = x * 3.1415927;
-    double f = (1.0 - std::cos(ft))* 0.5;
-    return a*(1.0-f)+b*f;
-}
+    // Relief : fBm of gradient noise, about one hill every two units
+    std::uint32_t const NOISE_SEED = 42;
+    Fractal<float> const RELIEF(4, 0.5f, 1.5f);
 
-inline double noise(double x, double y)
-{
-    double floorx = (double) ((int) x);
-    double floory = (double) ((int) y);
-
-    double s,t,u,v;//Integer declaration
-    s=findnoise2(floorx,floory);
-    t=findnoise2(floorx+1,floory);
-    u=findnoise2(floorx,floory+1);//Get the surrounding pixels to calculate the transition.
-    v=findnoise2(floorx+1,floory+1);
-    double int1=interpolate(s,t,x-floorx);//Interpolate between the values.
-    double int2=interpolate(u,v,x-floorx);//Here we use x-floorx, to get 1st dimension. Don't mind the x-floorx thingie, it's part of the cosine formula.
-    return interpolate(int1,int2,y-floory);//Here we use y-floory, to get the 2nd dimension.
-}
+    std::size_t grid_size(std::size_t extent)
+    {
+        return static_cast<std::size_t>(std::round(extent / GRID_STEP)) + 1;
+    }
+
+    // Vertices addressable by a GL_UNSIGNED_SHORT index
+    std::size_t const MAX_CHUNK_VERTICES = 65536;
 
+    // Number of indices of a triangle strip covering <rows> rows of <columns>
+    // vertices, rows being joined by two degenerate triangles
+    std::size_t strip_indices(std::size_t columns, std::size_t rows)
+    {
+        return rows < 2 ? 0 : (rows - 1) * 2 * columns + (rows - 2) * 2;
+    }
 }
 
 Terrain::Terrain(Size w, Size h):
-    m_vbo(0), m_w(w), m_h(h), m_nbVertices(w * h),
-    m_minHeight(0), m_maxHeight(0)
+    m_vertices(), m_indices(), m_format(VertexFormat::P16N8(PositionEncoding::Snorm16)),
+    m_quantizer(), m_w(w), m_h(h), m_columns(grid_size(w)), m_rows(grid_size(h)),
+    m_rowsPerChunk(0), m_nbVertices(m_columns * m_rows), m_minHeight(0), m_maxHeight(0),
+    m_heightfield(m_columns, m_rows, GRID_STEP)
 {
-    PerlinNoise pn(2.5, 30, 5, 8, 42);
-
-    std::vector<float> vertices;
+    Memory::TagScope tag(Memory::Tag::Terrain);
 
-    bool p = false;
+    auto const step = GRID_STEP;
+    Noise<float> const noise(NOISE_SEED);
 
-    float step = 0.2f;
-
-    for(float i = 0.f; i < w; i += step)
+    // Sample the noise once per grid point
+    for(Size z = 0; z < m_rows; ++z)
     {
-        p = !p;
+        auto row = m_heightfield.row(z);
 
-        for(float j = 0.f; j < h; j += step)
+        for(Size x = 0; x < m_columns; ++x)
         {
-            auto idxJ = p ? j : h - j;
-            auto nextJ = idxJ + (p ? step : -step);
+            row[x] = noise.fbm(NoiseBasis::Perlin, RELIEF, x * step, z * step);
+        }
+    }
 
-            float h = 0;
+    m_heightfield.updatePyramid();
 
-            h = noise(i, idxJ);
-            if(h > m_maxHeight) m_maxHeight = h;
-            vertices.push_back(i)     ; vertices.push_back(h); vertices.push_back(idxJ) ;
+    m_minHeight = m_heightfield.minHeight();
+    m_maxHeight = m_heightfield.maxHeight();
 
-            h = noise(i, nextJ);
-            if(h > m_maxHeight) m_maxHeight = h;
-            vertices.push_back(i)     ; vertices.push_back(h); vertices.push_back(nextJ);
+    // Quantize the positions on 16 bits over the terrain bounding box
+    m_quantizer = PositionQuantizer(
+        glm::vec3(0.f, m_minHeight, 0.f),
+        glm::vec3((m_columns - 1) * step, m_maxHeight, (m_rows - 1) * step),
+        PositionEncoding::Snorm16);
 
-            h = noise(i + step, idxJ);
-            if(h > m_maxHeight) m_maxHeight = h;
-            vertices.push_back(i+step); vertices.push_back(h); vertices.push_back(idxJ) ;
+    // Compute the normals row by row and pack them with the positions
+    std::vector<Vertex::P16N8> vertices(m_nbVertices);
+    std::vector<float> normals(3 * m_columns);
+
+    auto nx = &normals[0];
+    auto ny = nx + m_columns;
+    auto nz = ny + m_columns;
+
+    for(Size z = 0; z < m_rows; ++z)
+    {
+        m_heightfield.normalRow(z, nx, ny, nz);
 
-            h = noise(i + step, nextJ);
-            if(h > m_maxHeight) m_maxHeight = h;
-            vertices.push_back(i+step); vertices.push_back(h); vertices.push_back(nextJ);
+        auto const row = m_heightfield.row(z);
+        auto vertex = &vertices[z * m_columns];
+
+        for(Size x = 0; x < m_columns; ++x, ++vertex)
+        {
+            m_quantizer.encode(glm::vec3(x * step, row[x], z * step), vertex->position);
+            Packing::Normal(glm::vec3(nx[x], ny[x], nz[x]), vertex->normal);
         }
     }
 
-    m_nbVertices = vertices.size() / 3;
+    m_vertices = BufferManager::Default().allocate(GL_ARRAY_BUFFER, &vertices[0],
+        m_nbVertices * sizeof(Vertex::P16N8));
+
+    // The grid is drawn in chunks of rows small enough for 16-bit indices.
+    // Chunks share their border row and the same index buffer, only the
+    // vertex pointers are moved from one chunk to the next.
+    m_rowsPerChunk = std::min(m_rows, MAX_CHUNK_VERTICES / m_columns);
+    assert(m_rowsPerChunk >= 2);
 
-    glGenBuffers(1, &m_vbo);
+    std::vector<GLushort> indices;
+    indices.reserve(strip_indices(m_columns, m_rowsPerChunk));
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, m_nbVertices * 3 * sizeof(float),
-        &vertices[0], GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    for(Size z = 0; z + 1 < m_rowsPerChunk; ++z)
+    {
+        if(z > 0)
+        {
+            // Degenerate triangles to jump to the next row
+            indices.push_back(indices.back());
+            indices.push_back(static_cast<GLushort>(z * m_columns));
+        }
+
+        for(Size x = 0; x < m_columns; ++x)
+        {
+            indices.push_back(static_cast<GLushort>(z * m_columns + x));
+            indices.push_back(static_cast<GLushort>((z + 1) * m_columns + x));
+        }
+    }
+
+    m_indices = BufferManager::Default().allocate(GL_ELEMENT_ARRAY_BUFFER, &indices[0],
+        indices.size() * sizeof(GLushort));
 }
 
 
 Terrain::~Terrain()
 {
-
+    BufferManager::Default().release(m_vertices);
+    BufferManager::Default().release(m_indices);
 }
 
 float Terrain::getMaxHeight() const
@@ -103,43 +137,81 @@ float Terrain::getMaxHeight() const
     return m_maxHeight;
 }
 
+Heightfield const & Terrain::heightfield() const
+{
+    return m_heightfield;
+}
+
 void Terrain::render(GLSLProgram const & program, glm::mat4 & projection, glm::mat4 & modelView)
 {
     program.bind();
 
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        //glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vboIndices);
-
-        glVertexAttribPointer(OpenGL::AttributeIndex[Enums::AttributeIndex_Position],
-            3, GL_FLOAT, GL_FALSE, 0, 0);
-        //glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, m_vertices);
-        glEnableVertexAttribArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertices.buffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indices.buffer);
 
         program.sendMatrix("MatProjection", projection);
         program.sendMatrix("MatModelView", modelView);
+        m_quantizer.send(program);
         program.sendFloat("maxHeight", m_maxHeight);
         program.sendFloat("terrainWidth", m_w);
         program.sendFloat("terrainHeight", m_h);
 
+        for(Size first = 0; first + 1 < m_rows; first += m_rowsPerChunk - 1)
+        {
+            auto const rows = std::min(m_rowsPerChunk, m_rows - first);
 
-        //glDrawElements(GL_TRIANGLES, 12, GL_UNSIGNED_INT, static_cast<void *>(nullptr));
-
+            m_format.enable(m_vertices.offset + first * m_columns * m_format.stride());
 
-        //glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, m_colors);
-        //glEnableVertexAttribArray(1);
-        //glDrawArrays(GL_TRIANGLES, 0, 36);
-        glDrawArrays(GL_LINE_STRIP, 0, m_nbVertices - 1);
+            glDrawElements(GL_TRIANGLE_STRIP,
+                static_cast<GLsizei>(strip_indices(m_columns, rows)),
+                GL_UNSIGNED_SHORT, reinterpret_cast<void const *>(m_indices.offset));
+        }
 
-        //glDrawArrays(GL_LINES, 0, 36);
-        //glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+        m_format.disable();
 
+    program.unbind();
+}
 
-        //glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
+void Terrain::queue(RenderQueue & queue, GLSLProgram const & program,
+    glm::mat4 const & modelView) const
+{
+    DrawItem item;
+
+    item.program = &program;
+    item.vertexBuffer = m_vertices.buffer;
+    item.indexBuffer = m_indices.buffer;
+    item.format = &m_format;
+    item.modelView = modelView;
+    item.mode = GL_TRIANGLE_STRIP;
+    item.indexType = GL_UNSIGNED_SHORT;
+    item.first = static_cast<GLsizei>(m_indices.offset / sizeof(GLushort));
+
+    item.setup = [this](GLSLProgram const & p)
+    {
+        m_quantizer.send(p);
+        p.sendFloat("maxHeight", m_maxHeight);
+        p.sendFloat("terrainWidth", m_w);
+        p.sendFloat("terrainHeight", m_h);
+    };
+    item.object = this;
+
+    auto const step = m_heightfield.spacing();
+    auto const middleX = (m_columns - 1) * step * 0.5f;
+    auto const middleY = (m_minHeight + m_maxHeight) * 0.5f;
+
+    for(Size first = 0; first + 1 < m_rows; first += m_rowsPerChunk - 1)
+    {
+        auto const rows = std::min(m_rowsPerChunk, m_rows - first);
 
-    program.unbind();
+        item.vertexOffset = m_vertices.offset + first * m_columns * m_format.stride();
+        item.count = static_cast<GLsizei>(strip_indices(m_columns, rows));
+        item.center = glm::vec3(middleX, middleY, (first + (rows - 1) * 0.5f) * step);
+
+        queue.add(item);
+    }
 }
 
 }
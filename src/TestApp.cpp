@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <thread>
 #include <vector>
-#include <sstream>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -13,10 +15,23 @@
 
 
 #include <TestApp.hpp>
+#include <Animation.hpp>
+#include <BufferManager.hpp>
+#include <ChangeTracker.hpp>
 #include <Cube.hpp>
+#include <Flythrough.hpp>
+#include <FrameCapture.hpp>
+#include <GoldenHarness.hpp>
 #include <PerspectiveCamera.hpp>
 #include <Input.hpp>
+#include <LatencyProbe.hpp>
+#include <Memory.hpp>
+#include <MultiView.hpp>
+#include <Recording.hpp>
+#include <RenderQueue.hpp>
+#include <SceneGraph.hpp>
 #include <Terrain.hpp>
+#include <TransformStore.hpp>
 #include <Scheduler.hpp> 
 
 #include <cstdlib>
@@ -27,6 +42,59 @@ namespace {
         return (std::rand() / static_cast<float>(RAND_MAX)) * (b - a) + a;
     }
 
+    // Parameters of the animation block of shader.vs
+    std::size_t const ANIMATION_WAVE   = 0;
+    std::size_t const ANIMATION_RANDOM = 1;
+
+    // The phase of the wave steps by PI / 16 every 100 ms from -2 PI to 2 PI
+    float const WAVE_TICK = 100.f;
+    float const WAVE_PERIOD = 64 * WAVE_TICK;
+
+    float wave(float t)
+    {
+        return std::cos(static_cast<float>(-2 * M_PI + 4 * M_PI * t / WAVE_PERIOD));
+    }
+
+    // Size of the golden images, whatever the size of the window
+    int const GOLDEN_WIDTH = 320;
+    int const GOLDEN_HEIGHT = 240;
+
+    // Heap allocations of the frames since the last reset
+    struct AllocationCounts
+    {
+        std::size_t total;
+        std::size_t max;    // of one frame
+        std::size_t frames;
+    };
+
+    // Adds the allocations made during its lifetime to the counts : a frame
+    // is counted however its iteration of the loop ends, skipped or not
+    class FrameAllocationScope
+    {
+        public:
+            explicit FrameAllocationScope(AllocationCounts & counts):
+                m_counts(counts), m_start(RPi::Memory::Allocations())
+            {
+
+            }
+
+            ~FrameAllocationScope()
+            {
+                auto const allocations = RPi::Memory::Allocations() - m_start;
+
+                m_counts.total += allocations;
+                m_counts.max = std::max(m_counts.max, allocations);
+                ++m_counts.frames;
+            }
+
+            FrameAllocationScope(FrameAllocationScope const &) = delete;
+            FrameAllocationScope & operator=(FrameAllocationScope const &) = delete;
+
+        private:
+            AllocationCounts & m_counts;
+            std::size_t m_start;
+    };
+
     int s_lag = 6;
     void doLag()
     {
@@ -36,7 +104,12 @@ namespace {
 
 namespace RPi {
 
-TestApp::TestApp(Window & window, int argc, char ** argv, int lag): App(window, argc, argv)
+TestApp::TestApp(Window & window, int argc, char ** argv, int lag): App(window, argc, argv),
+    m_recordFile(), m_replayFile(), m_timestep(0.f), m_pathFile(),
+    m_flightDuration(0.f), m_latencyFile(), m_injectPeriod(0.f),
+    m_windowViews(1), m_offscreenViews(0), m_captureDirectory(),
+    m_captureInterval(0), m_goldenDirectory(), m_goldenUpdate(false), m_goldenLabel(),
+    m_skipIdle(false), m_idleSleep(0.f)
 {
     s_lag = lag;
 }
@@ -46,29 +119,174 @@ TestApp::~TestApp()
 
 }
 
+void TestApp::record(std::string const & filename, float timestep)
+{
+    m_recordFile = filename;
+    m_timestep = timestep;
+}
+
+void TestApp::replay(std::string const & filename)
+{
+    m_replayFile = filename;
+}
+
+void TestApp::flythrough(std::string const & filename, float duration)
+{
+    m_pathFile = filename;
+    m_flightDuration = duration;
+}
+
+void TestApp::probeLatency(std::string const & filename, float period)
+{
+    m_latencyFile = filename;
+    m_injectPeriod = period;
+}
+
+void TestApp::views(std::size_t windowViews, std::size_t offscreenViews)
+{
+    m_windowViews = windowViews;
+    m_offscreenViews = offscreenViews;
+}
+
+void TestApp::capture(std::string const & directory, std::size_t interval)
+{
+    m_captureDirectory = directory;
+    m_captureInterval = interval;
+}
+
+void TestApp::golden(std::string const & directory, bool update, std::string const & label)
+{
+    m_goldenDirectory = directory;
+    m_goldenUpdate = update;
+    m_goldenLabel = label;
+}
+
+void TestApp::skipIdleFrames(float sleep)
+{
+    m_skipIdle = true;
+    m_idleSleep = sleep;
+}
+
 void TestApp::run()
 {
-    std::srand(time(0));
+    InputRecorder recorder;
+    InputPlayer player;
+
+    auto seed = static_cast<std::uint32_t>(time(0));
+
+    CameraPath path;
+
+    if(!m_pathFile.empty())
+    {
+        if(!path.load(m_pathFile)) return;
+
+        // Same random numbers on every flight
+        seed = 0;
+    }
+
+    auto const flying = !m_pathFile.empty();
+
+    // Frames of the flight, at 60 Hz of flight time
+    auto const flightDuration = m_flightDuration > 0.f ? m_flightDuration : path.duration();
+    auto const flightFrames = static_cast<std::size_t>(flightDuration * 60.f);
+    auto const pathStep = flightFrames > 0 ? path.duration() / static_cast<float>(flightFrames) : 0.f;
+
+    std::size_t flightFrame = 0;
+    std::size_t segment = 0;
+    FrameTimeStats flightStats(path.segments());
+    flightStats.reserve(flightFrames);
+
+    if(!m_replayFile.empty())
+    {
+        if(!player.open(m_replayFile)) return;
+
+        // Same simulated time steps and random numbers as the recorded run
+        m_timestep = player.timestep();
+        seed = player.seed();
+    }
+    else if(!m_recordFile.empty())
+    {
+        if(!recorder.open(m_recordFile, m_timestep, seed)) return;
+    }
+
+    std::srand(seed);
+
+    auto const probing = !m_latencyFile.empty();
+    LatencyProbe latency;
+
+    if(probing && m_injectPeriod > 0.f)
+    {
+        latency.inject(m_injectPeriod);
+    }
+
+    FrameCapture capture;
+
+    if(!m_captureDirectory.empty())
+    {
+        capture.start(m_captureDirectory, m_captureInterval);
+    }
+
+    // Inputs of the render, to skip the frames that would not change
+    ChangeTracker changes;
+    std::size_t idleFrames = 0;
+
+    // Wave of the terrain, sampled from a table every 100 ms of simulated
+    // time with a new amplitude on every cycle
+    Animator animator(WAVE_TICK);
+    auto const waveTrack = animator.add(AnimationCurve(wave, WAVE_PERIOD), ANIMATION_WAVE);
+    std::size_t waveLoops = 0;
+
+    animator.block().set(ANIMATION_RANDOM, 1.f);
 
-    float timeFromStart = 0.f;
-    float timeFromStartTmp = 0.f;
     float totalTime = 0.f;
     std::size_t nbFrames = 0;
     auto quitting = false;
 
     Cube cube(5);
 
-    std::vector<Cube> cubes;
+    // Cube field : cube i has a size of i and lies at (i, 0, i)
+    TransformStore cubes;
+    cubes.reserve(150);
 
     for(int i = 0; i < 150; ++i)
     {
-        cubes.emplace_back(i);                        
-        auto & c = cubes[i];
-        c.translate(glm::vec3(i, 0, i));
+        cubes.add(glm::vec3(i, 0, i), glm::vec3(i));
     }
 
     Terrain terrain(50, 50);
 
+    // Static scenery : the world matrices are only recomputed when a node
+    // moves
+    SceneGraph scene;
+
+    auto const sceneRoot = scene.add();
+    auto const terrainNode = scene.add(sceneRoot);
+    auto const cubesNode = scene.add(sceneRoot);
+
+    // View of the cube field its model-views were computed with
+    glm::mat4 cubesView(0.f);
+
+    // Draws of a frame per view, sorted by pass, program, buffer and depth.
+    // The first view is the one of the camera, its queue is filled below.
+    MultiViewRenderer renderer(100.f);
+    renderer.add(View());
+
+    auto & queue = renderer.queue(0);
+
+    // Transient data of a frame
+    Memory::FrameArena frameArena(4096);
+
+    // Heap allocations of the frames of the last second
+    AllocationCounts allocations = { 0, 0, 0 };
+
+    // Input events of the last second and the longest time one waited in
+    // the queue before a frame read it
+    std::size_t inputEvents = 0;
+    std::uint64_t maxInputWait = 0;
+
+    // M prints the heap usage per subsystem
+    auto reportKeyDown = false;
+
     //Terrain terrain2(500, 500);
 
     auto t1 = std::chrono::high_resolution_clock::now();
@@ -83,8 +301,132 @@ void TestApp::run()
 
     camera.enableMouse(false);
 
+    camera.followTerrain(&terrain.heightfield(), 1.f);
+
+    // Golden-image regression : the terrain and the cube field from the
+    // poses of the golden directory, with the animation of the shaders
+    // stopped
+    if(!m_goldenDirectory.empty())
+    {
+        GoldenHarness harness(m_goldenDirectory, GOLDEN_WIDTH, GOLDEN_HEIGHT);
+
+        auto const program = m_window.getContext().program;
+        auto const litProgram = m_window.getContext().litProgram;
+
+        AnimationBlock animation;
+        animation.set(ANIMATION_WAVE, 1.f);
+        animation.set(ANIMATION_RANDOM, 1.f);
+        animation.upload(*program);
+        animation.upload(*litProgram);
+
+        scene.update();
+        cubes.updateModels();
+
+        auto & view = renderer.view(0);
+
+        view.name = "golden";
+        view.target = &harness.target();
+        view.viewport = { 0, 0, GOLDEN_WIDTH, GOLDEN_HEIGHT };
+        view.projection = glm::perspective(70.f,
+            static_cast<float>(GOLDEN_WIDTH) / static_cast<float>(GOLDEN_HEIGHT), 1.f, 100.f);
+
+        auto const passed = harness.run([&](CameraPose const & pose)
+        {
+            auto const lookAt = glm::lookAt(pose.position, pose.target, glm::vec3(0, 1, 0));
+
+            terrain.queue(queue, *litProgram, lookAt * scene.world(terrainNode));
+            Cube::Queue(queue, *program, cubes, lookAt * scene.world(cubesNode));
+
+            renderer.render();
+        }, m_goldenUpdate, m_goldenLabel);
+
+        harness.report(std::cout);
+
+        if(m_goldenUpdate)
+        {
+            std::cout << "Golden images written to " << m_goldenDirectory << std::endl;
+        }
+        else
+        {
+            auto const skipped = std::count_if(harness.results().begin(),
+                harness.results().end(), [](GoldenResult const & r) { return r.skipped; });
+
+            std::cout << "Golden images " << (passed ? "match" : "DIFFER");
+            if(skipped > 0) std::cout << ", " << skipped << " pose(s) without one skipped";
+            std::cout << std::endl;
+        }
+
+        return;
+    }
+
+    // The window is split between the camera and the first other views, the
+    // next ones are rendered offscreen. The other views look at the terrain
+    // from around it, each from a worker thread of its own.
+    auto const windowViews = static_cast<int>(std::max<std::size_t>(m_windowViews, 1));
+    auto const viewWidth = m_window.getWidth() / windowViews;
+    auto const viewHeight = m_window.getHeight();
+    auto const otherViews = windowViews - 1 + static_cast<int>(m_offscreenViews);
+
+    camera.ratio(static_cast<float>(viewWidth) / static_cast<float>(viewHeight));
+
+    renderer.view(0).name = "camera";
+    renderer.view(0).viewport = { 0, 0, viewWidth, viewHeight };
+
+    std::vector<std::unique_ptr<RenderTarget>> targets;
+
+    // The views read the model matrices of the cubes, computed once
+    if(otherViews > 0) cubes.updateModels();
+
+    for(int k = 1; k <= otherViews; ++k)
+    {
+        // Middle of the terrain
+        glm::vec3 const center(25.f, 0.f, 25.f);
+
+        auto const angle = 2.f * static_cast<float>(M_PI) * k / (otherViews + 1);
+        auto const eye = center + glm::vec3(40.f * std::cos(angle), 25.f, 40.f * std::sin(angle));
+        auto const lookAt = glm::lookAt(eye, center, glm::vec3(0, 1, 0));
+
+        View view;
+
+        view.name = "view " + std::to_string(k);
+        view.viewport = { 0, 0, viewWidth, viewHeight };
+        view.projection = glm::perspective(70.f,
+            static_cast<float>(viewWidth) / static_cast<float>(viewHeight), 1.f, 100.f);
+        view.thread = static_cast<std::size_t>(k);
+
+        if(k < windowViews)
+        {
+            view.viewport.x = k * viewWidth;
+        }
+        else
+        {
+            targets.emplace_back(new RenderTarget());
+
+            if(!targets.back()->create(viewWidth, viewHeight)) continue;
+
+            view.name += " (offscreen)";
+            view.target = targets.back().get();
+        }
+
+        auto const program = m_window.getContext().program;
+        auto const litProgram = m_window.getContext().litProgram;
+
+        view.job = [&, lookAt, program, litProgram](RenderQueue & q)
+        {
+            terrain.queue(q, *litProgram, lookAt * scene.world(terrainNode));
+            Cube::Queue(q, *program, cubes, lookAt * scene.world(cubesNode));
+        };
+
+        renderer.add(view);
+    }
+
     Input input;
 
+    // Keyboard and mouse while replaying (to stop with escape)
+    Input liveInput;
+    std::size_t divergences = 0;
+    float replayTime = 0.f;
+
     m_window.showMousePointer(false);
     m_window.grabMousePointer(true);
 
@@ -97,13 +439,11 @@ void TestApp::run()
     projection = glm::perspective(70.0, (double) m_window.getWidth() / m_window.getHeight(), 1.0, 100.0);
     modelview  = glm::mat4(1.0);
 
-    static float const PI2 = 2 * M_PI;
-    static float const timeWaveStep = M_PI / 16;
-    float timeWave = -PI2;
-    float random = 1.f;
-
     while(!m_window.userInterrupt() && !quitting)
     {
+        FrameAllocationScope frameAllocations(allocations);
+        frameArena.reset();
+
         // Reset timer
         auto t2 = std::chrono::high_resolution_clock::now();
         auto deltaTime = static_cast<float>(std::chrono::duration_cast<
@@ -111,11 +451,102 @@ void TestApp::run()
 
         t1 = t2;
 
+        // Simulated time of the frame
+        auto const stepTime = m_timestep > 0.f ? m_timestep : deltaTime;
+
         // Get the events
-        input.updateEvents();
+        if(flying)
+        {
+            input.updateEvents();
+
+            // deltaTime is the time of the previous frame, the first one
+            // includes the loading
+            if(flightFrame > 1)
+            {
+                flightStats.add(segment, deltaTime);
+            }
+
+            if(flightFrame > flightFrames)
+            {
+                std::cout << "Flythrough " << m_pathFile << " : " << flightFrames
+                          << " frames" << std::endl;
+                flightStats.report(std::cout);
+                break;
+            }
+
+            auto const t = static_cast<float>(flightFrame) * pathStep;
+            auto const pose = path.pose(t);
+
+            segment = path.segment(t);
+
+            camera.position(pose.position);
+            camera.target(pose.target);
+
+            ++flightFrame;
+        }
+        else if(player.isOpen())
+        {
+            liveInput.updateEvents();
+
+            if(liveInput.isKeyPressed(SDLK_ESCAPE))
+            {
+                std::cout << "Replay interrupted" << std::endl;
+                break;
+            }
+
+            Input::State state;
+            CameraPose pose;
+
+            if(!player.next(state, pose))
+            {
+                std::cout << "Replayed " << player.frames() << " frames in "
+                          << replayTime << " ms -> FPS = "
+                          << player.frames() / (replayTime / 1000.f) << std::endl;
+                break;
+            }
+
+            input.state(state);
+
+            // Move camera
+            camera.move(input);
+
+            // The pose only depends on the input : a difference means that
+            // the code changed since the recording
+            if(glm::length(camera.position() - pose.position) > 1e-4f ||
+               glm::length(camera.target() - pose.target) > 1e-4f)
+            {
+                if(divergences++ == 0)
+                {
+                    std::cerr << "Replay diverged at frame " << player.frames()
+                              << ", resynchronizing the camera" << std::endl;
+                }
+
+                camera.position(pose.position);
+                camera.target(pose.target);
+            }
+
+            replayTime += deltaTime;
+        }
+        else
+        {
+            input.updateEvents();
+
+            if(input.events() > 0)
+            {
+                inputEvents += input.events();
+                maxInputWait = std::max(maxInputWait, Input::Now() - input.oldestEventTime());
+            }
+
+            // Move camera
+            camera.move(input);
+
+            if(probing && input.events() > 0)
+            {
+                latency.consumed(input.oldestEventTime());
+            }
 
-        // Move camera
-        camera.move(input);
+            recorder.record(input.state(), { camera.position(), camera.target() });
+        }
 
         // Quit the app with escape
         if(input.isKeyPressed(SDLK_ESCAPE))
@@ -124,84 +555,244 @@ void TestApp::run()
             break;
         }
 
-        doLag();
+        if(input.isKeyPressed(SDLK_m) && !reportKeyDown)
+        {
+            Memory::Report(std::cout);
+        }
+
+        reportKeyDown = input.isKeyPressed(SDLK_m);
 
-        // Clear the screen
-        m_window.clear();
+        doLag();
 
         modelview = camera.lookAt();
 
         projection = camera.projection();
 
-        if(timeFromStart - timeFromStartTmp > 100.f)
+        if(animator.advance(stepTime) && animator.loops(waveTrack) != waveLoops)
         {
-            if(timeWave > PI2)
+            waveLoops = animator.loops(waveTrack);
+
+            auto const random = frandom(1.f, 2.f);
+            std::cout << random << std::endl;
+
+            animator.scale(waveTrack, random);
+            animator.block().set(ANIMATION_RANDOM, random);
+        }
+
+        // No call when the parameters did not change since the last tick
+        animator.block().upload(*m_window.getContext().program);
+        animator.block().upload(*m_window.getContext().litProgram);
+
+        // Camera, uniforms and moving nodes of the frame
+        changes.begin();
+        changes.track(modelview);
+        changes.track(projection);
+        changes.track(animator.block().data(), AnimationBlock::SIZE * 4 * sizeof(float));
+
+        if(scene.update() > 0)
+        {
+            changes.invalidate();
+        }
+
+        // The probe pairs the consumed input with the next presented frame
+        if(probing && input.events() > 0)
+        {
+            changes.invalidate();
+        }
+
+        // Get FPS
+        totalTime += deltaTime;
+        ++nbFrames;
+
+        char const * fpsText = nullptr;
+
+        if(totalTime > 1000.0f)
+        {
+            auto fps = (static_cast<float>(nbFrames) / (totalTime / 1000.f));
+
+            std::cout << nbFrames << " frames rendered in " << totalTime 
+                      << " ms -> FPS = " 
+                      << fps << std::endl;
+
+            //std::cout << "Pos : (" << camera.position().x << ", " << camera.position().y << ", " << camera.position().z << ")" << std::endl;
+            //std::cout << "Target : (" << camera.target().x << ", " << camera.target().y << ", " << camera.target().z << ")" << std::endl;
+
+            fpsText = frameArena.format("Sched : %s; Priority : %d => %g FPS",
+                Scheduler::GetSchedulerName(getpid()).c_str(),
+                Scheduler::GetPriority(getpid()), fps);
+
+            auto const & stats = queue.stats();
+
+            std::cout << "Render queue : " << stats.draws << " draws, "
+                      << stats.programChanges << " program changes ("
+                      << stats.unsortedProgramChanges << " unsorted, "
+                      << stats.programBinds << " glUseProgram), "
+                      << stats.bufferChanges << " buffer changes ("
+                      << stats.unsortedBufferChanges << " unsorted), "
+                      << stats.frontToBack * 100.f << "% front to back ("
+                      << stats.unsortedFrontToBack * 100.f << "% unsorted)"
+                      << std::endl;
+
+            std::cout << "Heap : " << allocations.total << " allocations in "
+                      << allocations.frames << " frames (" << allocations.max
+                      << " max per frame), frame arena peak : "
+                      << frameArena.peak() << " bytes" << std::endl;
+
+            auto const & gpu = BufferManager::Default().stats();
+
+            std::cout << "GPU buffers : " << gpu.buffers << " buffers, "
+                      << gpu.allocatedBytes / 1024 << " KB allocated (peak "
+                      << gpu.peakBytes / 1024 << " KB), " << gpu.usedBytes / 1024
+                      << " KB used by " << gpu.ranges << " ranges, "
+                      << gpu.streamedBytes / 1024 << " KB streamed, "
+                      << gpu.orphans << " orphans" << std::endl;
+
+            std::cout << "Input : " << inputEvents << " events, waited up to "
+                      << maxInputWait << " us in the queue, "
+                      << Input::DroppedEvents() << " dropped" << std::endl;
+
+            for(std::size_t v = 1; v < renderer.size(); ++v)
             {
-                timeWave = -PI2;
-                random = frandom(1.f, 2.f);
-                std::cout << random << std::endl;
+                auto const & viewStats = renderer.stats(v);
+
+                std::cout << renderer.view(v).name << " : " << viewStats.draws
+                          << " draws, job " << viewStats.jobMs << " ms, submit "
+                          << viewStats.submitMs << " ms" << std::endl;
             }
 
-            timeWave += timeWaveStep;
+            if(m_skipIdle)
+            {
+                std::cout << "Idle : " << idleFrames << " of " << nbFrames
+                          << " frames skipped" << std::endl;
+            }
 
-            if(std::fabs(timeWave) < std::numeric_limits<float>::epsilon())
+            if(capture.capturing())
             {
-                timeWave = 0.f;
+                auto const captureStats = capture.stats();
+
+                std::cout << "Capture : " << captureStats.captured << " frames, "
+                          << captureStats.maxReadbackMs << " ms max readback, "
+                          << captureStats.dropped << " dropped" << std::endl;
             }
 
-            //std::cout << timeWave << std::endl;
+            totalTime -= 1000.0f;
+            nbFrames = 0;
+            allocations = { 0, 0, 0 };
+            inputEvents = 0;
+            maxInputWait = 0;
+            idleFrames = 0;
+        }
 
-            timeFromStartTmp = timeFromStart;
+        // A new HUD text redraws the whole frame : the back buffer is not
+        // preserved across swaps
+        if(fpsText != nullptr)
+        {
+            changes.invalidate();
+        }
+
+        if(m_skipIdle && !changes.changed())
+        {
+            changes.skipped();
+            ++idleFrames;
+
+            if(m_idleSleep > 0.f)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(
+                    static_cast<std::int64_t>(m_idleSleep * 1000.f)));
+            }
 
-            m_window.getContext().program->sendFloat("time", timeWave);
-            m_window.getContext().program->sendFloat("random", random);
+            continue;
+        }
+
+        // The cube field is part of the flythrough scene
+        if(flying)
+        {
+            auto const view = modelview * scene.world(cubesNode);
+
+            if(view != cubesView)
+            {
+                cubes.updateModelViews(view);
+                cubesView = view;
+            }
+
+            Cube::Queue(queue, *m_window.getContext().program, cubes);
         }
 
         // Render the cube
         //cube.render(*m_window.getContext().program, projection, modelview);
 
-        //for(auto & c : cubes)
+        //for(std::size_t i = 0; i < cubes.size(); ++i)
         //{
-            //c.rotate(frandom(0.f, 180.f), glm::vec3(1.0, 1.0, 0));
-            //c.render(*m_window.getContext().program, projection, modelview);
+            //cubes.rotate(i, frandom(0.f, 180.f), glm::vec3(1.0, 1.0, 0));
         //}
+        //cubes.updateModelViews(modelview * scene.world(cubesNode));
+        //Cube::Queue(queue, *m_window.getContext().program, cubes);
 
         //glViewport(0, 0, m_window.getWidth() / 2, m_window.getHeight());
-        terrain.render(*m_window.getContext().program, projection, modelview);
+        terrain.queue(queue, *m_window.getContext().litProgram,
+            modelview * scene.world(terrainNode));
         //glViewport(m_window.getWidth() / 2, 0, m_window.getWidth() / 2, m_window.getHeight());
         //terrain2.render(*m_window.getContext().program, projection, modelview);
 
+        if(fpsText != nullptr)
+        {
+            DrawItem text;
+
+            text.pass = RenderPass::Overlay;
+            text.draw = [this, fpsText]()
+            {
+                m_window.displayText(fpsText);
+            };
+
+            queue.add(text);
+        }
+
+        // Clears and draws every view
+        renderer.view(0).projection = projection;
+        renderer.render();
+
+        // Read back before the swap, which leaves the back buffer undefined
+        capture.frame(m_window.getWidth(), m_window.getHeight());
+
         // Refresh the window
         m_window.display();
 
-        // Get FPS
-        totalTime += deltaTime;
-        timeFromStart += deltaTime;
-        ++nbFrames;
+        changes.presented();
 
-        if(totalTime > 1000.0f)
+        if(probing)
         {
-            auto fps = (static_cast<float>(nbFrames) / (totalTime / 1000.f));
+            latency.presented();
+        }
+    }
 
-            std::cout << nbFrames << " frames rendered in " << totalTime 
-                      << " ms -> FPS = " 
-                      << fps << std::endl;
+    if(recorder.isOpen())
+    {
+        std::cout << "Recorded " << recorder.frames() << " frames in "
+                  << m_recordFile << std::endl;
+    }
 
-            //std::cout << "Pos : (" << camera.position().x << ", " << camera.position().y << ", " << camera.position().z << ")" << std::endl;
-            //std::cout << "Target : (" << camera.target().x << ", " << camera.target().y << ", " << camera.target().z << ")" << std::endl;
-            
-            std::ostringstream fpsText;
-            fpsText << "Sched : " << Scheduler::GetSchedulerName(getpid())
-                    << "; Priority : " << Scheduler::GetPriority(getpid())
-                    << " => " << fps << " FPS";
+    if(divergences > 0)
+    {
+        std::cerr << divergences << " frame(s) diverged from the recording" << std::endl;
+    }
 
-            m_window.displayText(fpsText.str());
+    if(probing)
+    {
+        auto const label = Scheduler::GetSchedulerName(getpid()) + " priority "
+            + std::to_string(Scheduler::GetPriority(getpid()));
 
-            totalTime -= 1000.0f;
-            nbFrames = 0;
-        }
+        latency.report(std::cout, label);
+        latency.append(m_latencyFile, label);
     }
 
+    if(capture.capturing())
+    {
+        capture.stop();
+        capture.report(std::cout);
+    }
+
+    Memory::Report(std::cout);
+
     std::cout << "END OF LOOP" << std::endl;
 }
 
@@ -0,0 +1,388 @@
+#include <cmath>
+#include <initializer_list>
+
+#if defined(__SSE__)
+    #include <xmmintrin.h>
+    #define RPI_TRANSFORM_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define RPI_TRANSFORM_NEON
+#endif
+
+#include <Memory.hpp>
+#include <TransformStore.hpp>
+
+namespace RPi {
+
+namespace {
+
+    // -------------------------------------------------------------------------
+    //  Four floats, one lane per object
+    // -------------------------------------------------------------------------
+#if defined(RPI_TRANSFORM_SSE)
+
+    using Float4 = __m128;
+
+    inline Float4 load4(float const * p) { return _mm_loadu_ps(p); }
+    inline void store4(float * p, Float4 a) { _mm_storeu_ps(p, a); }
+    inline Float4 splat4(float v) { return _mm_set1_ps(v); }
+    inline Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+    inline Float4 sub4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+    inline Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+
+    inline void transpose(Float4 & a, Float4 & b, Float4 & c, Float4 & d)
+    {
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+    }
+
+#elif defined(RPI_TRANSFORM_NEON)
+
+    using Float4 = float32x4_t;
+
+    inline Float4 load4(float const * p) { return vld1q_f32(p); }
+    inline void store4(float * p, Float4 a) { vst1q_f32(p, a); }
+    inline Float4 splat4(float v) { return vdupq_n_f32(v); }
+    inline Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+    inline Float4 sub4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+    inline Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+    inline void transpose(Float4 & a, Float4 & b, Float4 & c, Float4 & d)
+    {
+        auto const ab = vtrnq_f32(a, b); // a0 b0 a2 b2 | a1 b1 a3 b3
+        auto const cd = vtrnq_f32(c, d); // c0 d0 c2 d2 | c1 d1 c3 d3
+
+        a = vcombine_f32(vget_low_f32(ab.val[0]),  vget_low_f32(cd.val[0]));
+        b = vcombine_f32(vget_low_f32(ab.val[1]),  vget_low_f32(cd.val[1]));
+        c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+        d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+    }
+
+#else
+
+    struct Float4
+    {
+        float v[4];
+    };
+
+    inline Float4 load4(float const * p) { return {{ p[0], p[1], p[2], p[3] }}; }
+    inline void store4(float * p, Float4 a) { for(int k = 0; k < 4; ++k) p[k] = a.v[k]; }
+    inline Float4 splat4(float v) { return {{ v, v, v, v }}; }
+
+    inline Float4 add4(Float4 a, Float4 b)
+    {
+        return {{ a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] }};
+    }
+
+    inline Float4 sub4(Float4 a, Float4 b)
+    {
+        return {{ a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] }};
+    }
+
+    inline Float4 mul4(Float4 a, Float4 b)
+    {
+        return {{ a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] }};
+    }
+
+    inline void transpose(Float4 & a, Float4 & b, Float4 & c, Float4 & d)
+    {
+        Float4 const r[4] = { a, b, c, d };
+        Float4 * const out[4] = { &a, &b, &c, &d };
+
+        for(int i = 0; i < 4; ++i)
+        {
+            for(int j = 0; j < 4; ++j) out[i]->v[j] = r[j].v[i];
+        }
+    }
+
+#endif
+
+    // m[c][r] : row r of column c of the matrices of four objects
+    struct Matrix4
+    {
+        Float4 m[4][4];
+    };
+
+    // -------------------------------------------------------------------------
+    //  Model matrices of the objects [i, i + 4)
+    // -------------------------------------------------------------------------
+    inline void compose(Matrix4 & out, std::size_t i,
+        float const * px, float const * py, float const * pz,
+        float const * qx, float const * qy, float const * qz, float const * qw,
+        float const * sx, float const * sy, float const * sz)
+    {
+        auto const x = load4(qx + i);
+        auto const y = load4(qy + i);
+        auto const z = load4(qz + i);
+        auto const w = load4(qw + i);
+
+        auto const x2 = add4(x, x);
+        auto const y2 = add4(y, y);
+        auto const z2 = add4(z, z);
+
+        auto const xx = mul4(x, x2), yy = mul4(y, y2), zz = mul4(z, z2);
+        auto const xy = mul4(x, y2), xz = mul4(x, z2), yz = mul4(y, z2);
+        auto const wx = mul4(w, x2), wy = mul4(w, y2), wz = mul4(w, z2);
+
+        auto const one = splat4(1.f);
+        auto const zero = splat4(0.f);
+
+        auto const scaleX = load4(sx + i);
+        auto const scaleY = load4(sy + i);
+        auto const scaleZ = load4(sz + i);
+
+        out.m[0][0] = mul4(sub4(one, add4(yy, zz)), scaleX);
+        out.m[0][1] = mul4(add4(xy, wz), scaleX);
+        out.m[0][2] = mul4(sub4(xz, wy), scaleX);
+        out.m[0][3] = zero;
+
+        out.m[1][0] = mul4(sub4(xy, wz), scaleY);
+        out.m[1][1] = mul4(sub4(one, add4(xx, zz)), scaleY);
+        out.m[1][2] = mul4(add4(yz, wx), scaleY);
+        out.m[1][3] = zero;
+
+        out.m[2][0] = mul4(add4(xz, wy), scaleZ);
+        out.m[2][1] = mul4(sub4(yz, wx), scaleZ);
+        out.m[2][2] = mul4(sub4(one, add4(xx, yy)), scaleZ);
+        out.m[2][3] = zero;
+
+        out.m[3][0] = load4(px + i);
+        out.m[3][1] = load4(py + i);
+        out.m[3][2] = load4(pz + i);
+        out.m[3][3] = one;
+    }
+
+    // Write the matrices of four objects to out[0..3]
+    inline void scatter(Matrix4 & in, glm::mat4 * out)
+    {
+        for(int c = 0; c < 4; ++c)
+        {
+            auto & col = in.m[c];
+            transpose(col[0], col[1], col[2], col[3]);
+
+            for(int k = 0; k < 4; ++k)
+            {
+                store4(&out[k][c].x, col[k]);
+            }
+        }
+    }
+
+    glm::vec4 normalize(glm::vec4 const & q)
+    {
+        auto const n = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if(n <= 0.f) return glm::vec4(0.f, 0.f, 0.f, 1.f);
+
+        return glm::vec4(q.x / n, q.y / n, q.z / n, q.w / n);
+    }
+
+    // Hamilton product a * b of quaternions stored as (x, y, z, w)
+    glm::vec4 multiply(glm::vec4 const & a, glm::vec4 const & b)
+    {
+        return glm::vec4(
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+    }
+
+    // Rotation of v by the unit quaternion q
+    glm::vec3 apply(glm::vec4 const & q, glm::vec3 const & v)
+    {
+        auto const u = glm::vec3(q.x, q.y, q.z);
+        auto const t = 2.f * glm::cross(u, v);
+        return v + q.w * t + glm::cross(u, t);
+    }
+}
+
+TransformStore::TransformStore():
+    m_size(0),
+    m_px(), m_py(), m_pz(),
+    m_qx(), m_qy(), m_qz(), m_qw(),
+    m_sx(), m_sy(), m_sz(),
+    m_models(), m_modelViews()
+{
+
+}
+
+TransformStore::Index TransformStore::add(glm::vec3 const & position,
+    glm::vec3 const & scale)
+{
+    auto const i = m_size++;
+
+    if(m_size > m_px.size())
+    {
+        resize((m_size + 3) & ~std::size_t(3));
+    }
+
+    this->position(i, position);
+    this->scale(i, scale);
+
+    return i;
+}
+
+void TransformStore::reserve(std::size_t count)
+{
+    Memory::TagScope tag(Memory::Tag::Scene);
+
+    auto const padded = (count + 3) & ~std::size_t(3);
+
+    for(auto a : { &m_px, &m_py, &m_pz, &m_qx, &m_qy, &m_qz, &m_qw,
+        &m_sx, &m_sy, &m_sz })
+    {
+        a->reserve(padded);
+    }
+
+    m_models.reserve(padded);
+    m_modelViews.reserve(padded);
+}
+
+void TransformStore::clear()
+{
+    m_size = 0;
+    resize(0);
+}
+
+std::size_t TransformStore::size() const
+{
+    return m_size;
+}
+
+void TransformStore::resize(std::size_t padded)
+{
+    Memory::TagScope tag(Memory::Tag::Scene);
+
+    for(auto a : { &m_px, &m_py, &m_pz, &m_qx, &m_qy, &m_qz })
+    {
+        a->resize(padded, 0.f);
+    }
+
+    for(auto a : { &m_qw, &m_sx, &m_sy, &m_sz })
+    {
+        a->resize(padded, 1.f);
+    }
+
+    m_models.resize(padded, glm::mat4(1.f));
+    m_modelViews.resize(padded, glm::mat4(1.f));
+}
+
+void TransformStore::position(Index i, glm::vec3 const & position)
+{
+    m_px[i] = position.x;
+    m_py[i] = position.y;
+    m_pz[i] = position.z;
+}
+
+glm::vec3 TransformStore::position(Index i) const
+{
+    return glm::vec3(m_px[i], m_py[i], m_pz[i]);
+}
+
+void TransformStore::scale(Index i, glm::vec3 const & scale)
+{
+    m_sx[i] = scale.x;
+    m_sy[i] = scale.y;
+    m_sz[i] = scale.z;
+}
+
+glm::vec3 TransformStore::scale(Index i) const
+{
+    return glm::vec3(m_sx[i], m_sy[i], m_sz[i]);
+}
+
+void TransformStore::rotation(Index i, glm::vec4 const & quaternion)
+{
+    auto const q = normalize(quaternion);
+
+    m_qx[i] = q.x;
+    m_qy[i] = q.y;
+    m_qz[i] = q.z;
+    m_qw[i] = q.w;
+}
+
+glm::vec4 TransformStore::rotation(Index i) const
+{
+    return glm::vec4(m_qx[i], m_qy[i], m_qz[i], m_qw[i]);
+}
+
+void TransformStore::rotate(Index i, float angle, glm::vec3 const & axis)
+{
+    auto const half = glm::radians(angle) * 0.5f;
+    auto const a = glm::normalize(axis) * std::sin(half);
+
+    rotation(i, multiply(rotation(i), glm::vec4(a, std::cos(half))));
+}
+
+void TransformStore::translate(Index i, glm::vec3 const & offset)
+{
+    position(i, position(i) + apply(rotation(i), offset * scale(i)));
+}
+
+void TransformStore::updateModels()
+{
+    Matrix4 m;
+
+    for(std::size_t i = 0; i < m_size; i += 4)
+    {
+        compose(m, i, m_px.data(), m_py.data(), m_pz.data(),
+            m_qx.data(), m_qy.data(), m_qz.data(), m_qw.data(),
+            m_sx.data(), m_sy.data(), m_sz.data());
+
+        scatter(m, &m_models[i]);
+    }
+}
+
+void TransformStore::updateModelViews(glm::mat4 const & view)
+{
+    // Coefficients of the view matrix in every lane
+    Float4 v[4][4];
+
+    for(int c = 0; c < 4; ++c)
+    {
+        for(int r = 0; r < 4; ++r) v[c][r] = splat4(view[c][r]);
+    }
+
+    Matrix4 m;
+    Matrix4 mv;
+
+    for(std::size_t i = 0; i < m_size; i += 4)
+    {
+        compose(m, i, m_px.data(), m_py.data(), m_pz.data(),
+            m_qx.data(), m_qy.data(), m_qz.data(), m_qw.data(),
+            m_sx.data(), m_sy.data(), m_sz.data());
+
+        // view * model, knowing that the last row of the model is (0, 0, 0, 1)
+        for(int c = 0; c < 4; ++c)
+        {
+            for(int r = 0; r < 4; ++r)
+            {
+                auto s = add4(add4(mul4(v[0][r], m.m[c][0]), mul4(v[1][r], m.m[c][1])),
+                    mul4(v[2][r], m.m[c][2]));
+
+                mv.m[c][r] = c == 3 ? add4(s, v[3][r]) : s;
+            }
+        }
+
+        scatter(mv, &m_modelViews[i]);
+    }
+}
+
+glm::mat4 const & TransformStore::model(Index i) const
+{
+    return m_models[i];
+}
+
+glm::mat4 const & TransformStore::modelView(Index i) const
+{
+    return m_modelViews[i];
+}
+
+glm::mat4 const * TransformStore::models() const
+{
+    return m_models.data();
+}
+
+glm::mat4 const * TransformStore::modelViews() const
+{
+    return m_modelViews.data();
+}
+
+}
@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <cmath>
+
+#include <GLSLProgram.hpp>
+#include <OpenGL.hpp>
+#include <VertexFormat.hpp>
+
+namespace RPi {
+
+namespace {
+
+    static_assert(sizeof(Vertex::P32)     == 12, "Unexpected padding");
+    static_assert(sizeof(Vertex::P16)     ==  8, "Unexpected padding");
+    static_assert(sizeof(Vertex::P16C8)   == 12, "Unexpected padding");
+    static_assert(sizeof(Vertex::P16N8)   == 12, "Unexpected padding");
+    static_assert(sizeof(Vertex::P16N8C8) == 16, "Unexpected padding");
+
+    template <typename T>
+    T quantize(float v, float lo, float hi)
+    {
+        v = std::round(v);
+        return static_cast<T>(std::min(std::max(v, lo), hi));
+    }
+
+    float halfExtent(float min, float max)
+    {
+        auto const half = (max - min) * 0.5f;
+        return half > 0.f ? half : 1.f;
+    }
+}
+
+// =============================================================================
+//   Packing
+// =============================================================================
+
+std::int16_t Packing::Snorm16(float v)
+{
+    return quantize<std::int16_t>((v * 65535.f - 1.f) * 0.5f, -32768.f, 32767.f);
+}
+
+std::int8_t Packing::Snorm8(float v)
+{
+    return quantize<std::int8_t>((v * 255.f - 1.f) * 0.5f, -128.f, 127.f);
+}
+
+std::uint8_t Packing::Unorm8(float v)
+{
+    return quantize<std::uint8_t>(v * 255.f, 0.f, 255.f);
+}
+
+std::int16_t Packing::Fixed16(float v, unsigned int fracBits)
+{
+    return quantize<std::int16_t>(std::ldexp(v, static_cast<int>(fracBits)),
+        -32768.f, 32767.f);
+}
+
+void Packing::Normal(glm::vec3 const & n, std::int8_t out[4])
+{
+    out[0] = Snorm8(n.x);
+    out[1] = Snorm8(n.y);
+    out[2] = Snorm8(n.z);
+    out[3] = 0;
+}
+
+void Packing::Color(glm::vec4 const & c, std::uint8_t out[4])
+{
+    out[0] = Unorm8(c.x);
+    out[1] = Unorm8(c.y);
+    out[2] = Unorm8(c.z);
+    out[3] = Unorm8(c.w);
+}
+
+// =============================================================================
+//   PositionQuantizer
+// =============================================================================
+
+PositionQuantizer::PositionQuantizer():
+    m_encoding(PositionEncoding::Snorm16), m_fracBits(0),
+    m_scale(1.f), m_bias(0.f), m_invScale(1.f)
+{
+
+}
+
+PositionQuantizer::PositionQuantizer(glm::vec3 const & min,
+    glm::vec3 const & max, PositionEncoding encoding):
+    m_encoding(encoding), m_fracBits(0),
+    m_scale(halfExtent(min.x, max.x), halfExtent(min.y, max.y),
+        halfExtent(min.z, max.z)),
+    m_bias((min + max) * 0.5f), m_invScale(1.f)
+{
+    if(m_encoding == PositionEncoding::Fixed16)
+    {
+        // Use the same power of two on every axis so that a regular grid
+        // stays regular once quantized
+        auto const extent = std::max(m_scale.x, std::max(m_scale.y, m_scale.z));
+        auto const bits = static_cast<int>(std::floor(std::log2(32767.f / extent)));
+
+        m_fracBits = static_cast<unsigned int>(std::min(std::max(bits, 0), 15));
+        m_scale = glm::vec3(std::ldexp(1.f, -static_cast<int>(m_fracBits)));
+    }
+
+    m_invScale = glm::vec3(1.f / m_scale.x, 1.f / m_scale.y, 1.f / m_scale.z);
+}
+
+void PositionQuantizer::encode(glm::vec3 const & position, std::int16_t out[4]) const
+{
+    auto const p = (position - m_bias) * m_invScale;
+
+    if(m_encoding == PositionEncoding::Fixed16)
+    {
+        out[0] = Packing::Fixed16(p.x, 0);
+        out[1] = Packing::Fixed16(p.y, 0);
+        out[2] = Packing::Fixed16(p.z, 0);
+    }
+    else
+    {
+        out[0] = Packing::Snorm16(p.x);
+        out[1] = Packing::Snorm16(p.y);
+        out[2] = Packing::Snorm16(p.z);
+    }
+
+    out[3] = 0;
+}
+
+glm::vec3 PositionQuantizer::decode(std::int16_t const in[4]) const
+{
+    glm::vec3 p(in[0], in[1], in[2]);
+
+    if(m_encoding == PositionEncoding::Snorm16)
+    {
+        p = (p * 2.f + glm::vec3(1.f)) / 65535.f;
+    }
+
+    return p * m_scale + m_bias;
+}
+
+PositionEncoding PositionQuantizer::encoding() const
+{
+    return m_encoding;
+}
+
+bool PositionQuantizer::normalized() const
+{
+    return m_encoding == PositionEncoding::Snorm16;
+}
+
+glm::vec3 const & PositionQuantizer::scale() const
+{
+    return m_scale;
+}
+
+glm::vec3 const & PositionQuantizer::bias() const
+{
+    return m_bias;
+}
+
+void PositionQuantizer::send(GLSLProgram const & program) const
+{
+    program.sendVec3("PositionScale", m_scale);
+    program.sendVec3("PositionBias", m_bias);
+}
+
+void PositionQuantizer::SendIdentity(GLSLProgram const & program)
+{
+    program.sendVec3("PositionScale", glm::vec3(1.f));
+    program.sendVec3("PositionBias", glm::vec3(0.f));
+}
+
+// =============================================================================
+//   VertexFormat
+// =============================================================================
+
+VertexFormat::VertexFormat(std::size_t stride):
+    m_attributes(), m_stride(stride)
+{
+
+}
+
+VertexFormat & VertexFormat::add(Enums::AttributeIndex index, GLint size,
+    GLenum type, GLboolean normalized, std::size_t offset)
+{
+    m_attributes.push_back({ index, size, type, normalized, offset });
+    return *this;
+}
+
+std::size_t VertexFormat::stride() const
+{
+    return m_stride;
+}
+
+std::vector<VertexAttribute> const & VertexFormat::attributes() const
+{
+    return m_attributes;
+}
+
+void VertexFormat::enable(std::size_t baseOffset) const
+{
+    for(auto const & a : m_attributes)
+    {
+        auto const index = OpenGL::AttributeIndex[a.index];
+
+        glVertexAttribPointer(index, a.size, a.type, a.normalized,
+            static_cast<GLsizei>(m_stride),
+            reinterpret_cast<void const *>(baseOffset + a.offset));
+        glEnableVertexAttribArray(index);
+    }
+}
+
+void VertexFormat::disable() const
+{
+    for(auto const & a : m_attributes)
+    {
+        glDisableVertexAttribArray(OpenGL::AttributeIndex[a.index]);
+    }
+}
+
+VertexFormat VertexFormat::P32()
+{
+    return VertexFormat(sizeof(Vertex::P32))
+        .add(Enums::AttributeIndex_Position, 3, GL_FLOAT, GL_FALSE,
+            offsetof(Vertex::P32, position));
+}
+
+VertexFormat VertexFormat::P16(PositionEncoding encoding)
+{
+    auto const normalized = encoding == PositionEncoding::Snorm16;
+
+    return VertexFormat(sizeof(Vertex::P16))
+        .add(Enums::AttributeIndex_Position, 3, GL_SHORT, normalized,
+            offsetof(Vertex::P16, position));
+}
+
+VertexFormat VertexFormat::P16C8(PositionEncoding encoding)
+{
+    auto const normalized = encoding == PositionEncoding::Snorm16;
+
+    return VertexFormat(sizeof(Vertex::P16C8))
+        .add(Enums::AttributeIndex_Position, 3, GL_SHORT, normalized,
+            offsetof(Vertex::P16C8, position))
+        .add(Enums::AttributeIndex_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+            offsetof(Vertex::P16C8, color));
+}
+
+VertexFormat VertexFormat::P16N8(PositionEncoding encoding)
+{
+    auto const normalized = encoding == PositionEncoding::Snorm16;
+
+    return VertexFormat(sizeof(Vertex::P16N8))
+        .add(Enums::AttributeIndex_Position, 3, GL_SHORT, normalized,
+            offsetof(Vertex::P16N8, position))
+        .add(Enums::AttributeIndex_Normal, 3, GL_BYTE, GL_TRUE,
+            offsetof(Vertex::P16N8, normal));
+}
+
+VertexFormat VertexFormat::P16N8C8(PositionEncoding encoding)
+{
+    auto const normalized = encoding == PositionEncoding::Snorm16;
+
+    return VertexFormat(sizeof(Vertex::P16N8C8))
+        .add(Enums::AttributeIndex_Position, 3, GL_SHORT, normalized,
+            offsetof(Vertex::P16N8C8, position))
+        .add(Enums::AttributeIndex_Normal, 3, GL_BYTE, GL_TRUE,
+            offsetof(Vertex::P16N8C8, normal))
+        .add(Enums::AttributeIndex_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+            offsetof(Vertex::P16N8C8, color));
+}
+
+}
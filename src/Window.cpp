@@ -5,7 +5,9 @@
 #include <memory>
 
 #include <Window.hpp>
+#include <EGLConfigSelector.hpp>
 #include <EGLHeaders.hpp>
+#include <Memory.hpp>
 
 #include <SDL/SDL.h>
 #include <SDL/SDL_ttf.h>
@@ -124,7 +126,7 @@ EGLBoolean create_window(RPi::Context & context, const char *title)
 
     // Set the event mask of the window
     XSetWindowAttributes swa;
-    swa.event_mask = ExposureMask | PointerMotionMask | KeyPressMask;
+    swa.event_mask = ExposureMask | KeyPressMask;
 
     // Create the new window
     Window window = XCreateWindow(
@@ -198,8 +200,6 @@ GLboolean user_interrupt(RPi::Context & context)
         {
             if(XLookupString(&xev.xkey, &text, 1, &key, 0) == 1)
             {
-                std::cout << "Key pressed : " << static_cast<unsigned int>(text) << std::endl;
-
                 static auto const key_equal = [](char text, unsigned int key)
                 {
                     return static_cast<unsigned int>(text) == key;
@@ -212,11 +212,6 @@ GLboolean user_interrupt(RPi::Context & context)
                     userinterrupt = EGL_TRUE;
             }
         }
-        if(xev.type == MotionNotify)
-        {
-            auto const & mev = xev.xmotion;
-            std::cout << "Mouse moved : " << mev.x << " | " << mev.y << " || " << mev.x_root << " | " << mev.y_root << std::endl;
-        }
         if(xev.type == DestroyNotify)
             userinterrupt = EGL_TRUE;
     }
@@ -235,6 +230,8 @@ TTF_Font * s_font = nullptr;
 
 void load_font(std::string const & fontPath)
 {
+    RPi::Memory::TagScope tag(RPi::Memory::Tag::Fonts);
+
     s_font = TTF_OpenFont(fontPath.c_str(), 24);
     if (s_font == nullptr)
     {
@@ -252,7 +249,7 @@ SDL_Color const s_bg_color = {0, 0, 0, 255};
 SDL_Surface * s_screen = nullptr;
 SDL_Surface * s_clear_surface = nullptr;
 
-void display_text(std::string const & text)
+void display_text(char const * text)
 {
     if(s_clear_surface == nullptr)
     {
@@ -261,11 +258,11 @@ void display_text(std::string const & text)
 
     if(s_text != nullptr)
     {
-        delete s_text;
+        SDL_FreeSurface(s_text);
     }
 
-    //s_text = TTF_RenderText_Solid(s_font, text.c_str(), s_text_color);
-    s_text = TTF_RenderText_Shaded(s_font, text.c_str(), s_text_color, s_bg_color);
+    //s_text = TTF_RenderText_Solid(s_font, text, s_text_color);
+    s_text = TTF_RenderText_Shaded(s_font, text, s_text_color, s_bg_color);
 
     if(s_text == nullptr)
     {
@@ -300,7 +297,7 @@ void load_font(std::string const &)
 
 }
 
-void display_text(std::string const &)
+void display_text(char const *)
 {
 
 }
@@ -309,7 +306,7 @@ void display_text(std::string const &)
 
 
 
-EGLBoolean create_egl_context(RPi::Context & rpiContext, EGLint const attribList[])
+EGLBoolean create_egl_context(RPi::Context & rpiContext, RPi::EGLConfigRequest const & request)
 {
     // Obtains the EGL display connection for the given native display 
     EGLDisplay display;
@@ -337,24 +334,16 @@ EGLBoolean create_egl_context(RPi::Context & rpiContext, EGLint const attribList
 
     std::cout << "Initialize display OK" << std::endl;
 
-    // Get configs
-    EGLint nbConfigs;
-    if(eglGetConfigs(display, nullptr, 0, &nbConfigs) == EGL_FALSE)
-    {
-        std::cerr << "Failed to get configs" << std::endl;
-        return EGL_FALSE;
-    }
-
-    std::cout << "Get config OK" << std::endl;
-
     // Choose config
-     EGLConfig config;
-    if(eglChooseConfig(display, attribList, &config, 1, &nbConfigs) == EGL_FALSE)
+    RPi::EGLConfigInfo chosen;
+    if(!RPi::EGLConfigSelector::Choose(display, request, chosen))
     {
         std::cerr << "Failed to choose configs" << std::endl;
         return EGL_FALSE;
     }
 
+    EGLConfig config = chosen.config;
+
     std::cout << "Choose config OK" << std::endl;
 
     // Defines the current rendering API
@@ -372,8 +361,10 @@ EGLBoolean create_egl_context(RPi::Context & rpiContext, EGLint const attribList
     EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE, EGL_NONE };
     #endif
 
+    EGLint const surfaceAttribs[] = { EGL_RENDER_BUFFER, EGL_BACK_BUFFER, EGL_NONE };
+
     EGLSurface surface = eglCreateWindowSurface(display, config,
-        (EGLNativeWindowType) rpiContext.eglWindow, nullptr);
+        (EGLNativeWindowType) rpiContext.eglWindow, surfaceAttribs);
 
     if(surface == EGL_NO_SURFACE)
     {
@@ -383,6 +374,17 @@ EGLBoolean create_egl_context(RPi::Context & rpiContext, EGLint const attribList
 
     std::cout << "Create surface OK" << std::endl;
 
+    // Every frame clears the whole buffer : a preserved back buffer would
+    // only cost a copy (or a tile reload) per swap
+    EGLint swapBehavior = EGL_BUFFER_DESTROYED;
+    eglQuerySurface(display, surface, EGL_SWAP_BEHAVIOR, &swapBehavior);
+
+    if(swapBehavior == EGL_BUFFER_PRESERVED &&
+       eglSurfaceAttrib(display, surface, EGL_SWAP_BEHAVIOR, EGL_BUFFER_DESTROYED) == EGL_FALSE)
+    {
+        std::cout << "Swap behavior : preserved" << std::endl;
+    }
+
 
     // Create an EGL context
      EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
@@ -423,10 +425,23 @@ Window::Window(Context & context, char const * title,
     context.width  = m_width;
     context.height = m_height;
 
+    #ifndef __arm__
+    // The SDL event thread and the render thread share the X display
+    XInitThreads();
+    #endif
+
     #if defined __arm__ || defined LINUX_SDL_TEST
-    if(SDL_Init(SDL_INIT_VIDEO) != 0)
+    // Collect the input events on the SDL event thread (see Input), or on
+    // the render thread where SDL has no event thread
+    if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTTHREAD) != 0)
     {
-        std::cerr << "SDL_Init failed" << std::endl;
+        std::cerr << "SDL_Init with an event thread failed : " << SDL_GetError()
+                  << std::endl;
+
+        if(SDL_Init(SDL_INIT_VIDEO) != 0)
+        {
+            std::cerr << "SDL_Init failed" << std::endl;
+        }
     }
 
     auto info = SDL_GetVideoInfo();
@@ -477,22 +492,18 @@ Window::Window(Context & context, char const * title,
         std::cerr << "Failed to create window" << std::endl;
     }
 
-    // EGL context attributes
-    EGLint const attribList[] =
+    // Frame buffer of the window
+    RPi::EGLConfigRequest const request =
     {
-        EGL_RED_SIZE,       5,
-        EGL_GREEN_SIZE,     6,
-        EGL_BLUE_SIZE,      5,
-        EGL_ALPHA_SIZE,     (flags & WINDOW_ALPHA)   ? 8 : EGL_DONT_CARE,
-        EGL_DEPTH_SIZE,     (flags & WINDOW_DEPTH)   ? 8 : EGL_DONT_CARE,
-        EGL_STENCIL_SIZE,   (flags & WINDOW_STENCIL) ? 8 : EGL_DONT_CARE,
-        EGL_SAMPLE_BUFFERS, (flags & WINDOW_ALPHA)   ? 1 : 0,
-        //EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
-        EGL_NONE
+        (flags & WINDOW_TRUE_COLOR)  ? 24 : 16,
+        (flags & WINDOW_ALPHA)       ?  8 :  0,
+        (flags & WINDOW_DEPTH)       ? ((flags & WINDOW_TRUE_COLOR) ? 24 : 16) : 0,
+        (flags & WINDOW_STENCIL)     ?  8 :  0,
+        (flags & WINDOW_MULTISAMPLE) ?  4 :  0
     };
 
     // Creates EGL context
-    if(create_egl_context(context, attribList) == EGL_FALSE)
+    if(create_egl_context(context, request) == EGL_FALSE)
     {
         std::cerr << "Failed to create egl context" << std::endl;
     }
@@ -529,6 +540,11 @@ void Window::display() const
 }
 
 void Window::displayText(std::string const & text) const
+{
+    displayText(text.c_str());
+}
+
+void Window::displayText(char const * text) const
 {
     glDisable(GL_DEPTH_TEST);
     display_text(text);
@@ -6,13 +6,17 @@
 #include <glm/gtx/transform.hpp>
 
 #include <App.hpp>
+#include <BufferManager.hpp>
 #include <TestApp.hpp>
 #include <Context.hpp>
+#include <EGLConfigSelector.hpp>
 #include <EGLIntrospection.hpp>
+#include <GLTrace.hpp>
 #include <GLSLProgram.hpp>
 #include <OpenGL.hpp>
 #include <Window.hpp>
 #include <Utils.hpp>
+#include <VertexFormat.hpp>
 
 #include <PerlinNoise.hpp>
 #include <Scheduler.hpp>
@@ -35,14 +39,46 @@ static struct Param
     int h = 480;
     int lag = 6;
     bool mouse = false;
+    std::string record = "";        // Recording to write
+    std::string replay = "";        // Recording to replay
+    float timestep = 1000.f / 60.f; // Simulated ms per frame when recording
+    std::string path = "";          // Camera path of the flythrough benchmark
+    float duration = 0.f;           // Duration of the flythrough in s
+    std::string latency = "";       // CSV file of the input latency probe
+    float inject = 0.f;             // Period in ms of the injected key events
+    std::size_t views = 1;          // Views side by side in the window
+    std::size_t offscreen = 0;      // Views rendered offscreen
+    std::string capture = "";       // Directory of the captured frames
+    std::size_t interval = 60;      // Frames between two captures
+    std::string golden = "";        // Golden directory of the regression harness
+    bool update = false;            // Write the golden images
+    std::string label = "unlabeled";// Build named in the golden results
+    std::string trace = "";         // GL call trace to write
+    std::string profile = "default";// Frame buffer : fast, default or quality
+    std::string configCache = "";   // Cache file of the chosen EGL config
+    float idle = -1.f;              // Sleep in ms after a skipped frame, < 0 : no skipping
 } s_param;
 
 void parse_args(int argc, char ** argv);
 
+WindowFlags profile_flags(std::string const & profile);
+
 int main(int argc, char ** argv)
 {
     parse_args(argc, argv);
 
+    // Before the context : the trace holds every object the replay creates
+    if(!s_param.trace.empty())
+    {
+        GLTrace::Start(s_param.trace);
+    }
+
+    // Before the window : it chooses the EGL config
+    if(!s_param.configCache.empty())
+    {
+        EGLConfigSelector::SetCacheFile(s_param.configCache);
+    }
+
     try {
         Scheduler::SetScheduler(getpid(), s_param.sched, s_param.priority);
     } catch(std::exception const & e) {
@@ -72,7 +108,8 @@ int main(int argc, char ** argv)
     windowTitle += "Sched : " + Scheduler::GetSchedulerName(getpid());
     windowTitle += " - Priority : " + Utils::String(Scheduler::GetPriority(getpid()));
 
-    RPi::Window window(context, windowTitle.c_str(), s_param.x, s_param.y, s_param.w, s_param.h);
+    RPi::Window window(context, windowTitle.c_str(), s_param.x, s_param.y, s_param.w, s_param.h,
+        profile_flags(s_param.profile));
 
     std::cout << "Window created" << std::endl;
 
@@ -85,14 +122,67 @@ int main(int argc, char ** argv)
     program.link();
     std::cout << program.getLog() << std::endl;
 
+    // Lighting permutation of the same shaders
+    GLSLProgram litProgram;
+    context.litProgram = &litProgram;
+    litProgram.loadShaderFromFile(Enums::ShaderType_VertexShader, "./shaders/shader.vs", { "LIGHTING" });
+    std::cout << litProgram.getLog() << std::endl;
+    litProgram.loadShaderFromFile(Enums::ShaderType_FragmentShader, "./shaders/shader.fs", { "LIGHTING" });
+    std::cout << litProgram.getLog() << std::endl;
+    litProgram.link();
+    std::cout << litProgram.getLog() << std::endl;
+
     window.init();
 
     TestApp app(window, argc, argv, s_param.lag);
 
+    if(!s_param.path.empty())
+    {
+        app.flythrough(s_param.path, s_param.duration);
+    }
+    else if(!s_param.replay.empty())
+    {
+        app.replay(s_param.replay);
+    }
+    else if(!s_param.record.empty())
+    {
+        app.record(s_param.record, s_param.timestep);
+    }
+
+    app.views(s_param.views, s_param.offscreen);
+
+    if(!s_param.golden.empty())
+    {
+        app.golden(s_param.golden, s_param.update, s_param.label);
+    }
+
+    if(!s_param.capture.empty())
+    {
+        app.capture(s_param.capture, s_param.interval);
+    }
+
+    if(!s_param.latency.empty())
+    {
+        app.probeLatency(s_param.latency, s_param.inject);
+    }
+
+    if(s_param.idle >= 0.f)
+    {
+        app.skipIdleFrames(s_param.idle);
+    }
+
     app.registerDrawFunc(Draw);
 
     app.run();
 
+    if(GLTrace::Recording())
+    {
+        GLTrace::Stop();
+
+        std::cout << "GL trace " << s_param.trace << " : " << GLTrace::Calls()
+                  << " calls, " << GLTrace::Bytes() / 1024 << " KB" << std::endl;
+    }
+
     //std::cout << "Creating thread" << std::endl;
     //std::thread t(app);
     //std::cout << "Thread created" << std::endl;
@@ -107,7 +197,7 @@ void parse_args(int argc, char ** argv)
 {
     int c;
 
-    while((c = getopt(argc, argv, "s:p:x:y:w:h:l:m")) != -1)
+    while((c = getopt(argc, argv, "s:p:x:y:w:h:l:mr:R:t:f:d:L:i:V:O:c:C:g:ub:T:e:E:I:")) != -1)
     {
         switch(c)
         {
@@ -135,11 +225,95 @@ void parse_args(int argc, char ** argv)
             case 'm':
                 s_param.mouse = true;
                 break;
+            case 'r':
+                s_param.record = optarg;
+                break;
+            case 'R':
+                s_param.replay = optarg;
+                break;
+            case 't':
+                s_param.timestep = Utils::Number<decltype(s_param.timestep)>(optarg);
+                break;
+            case 'f':
+                s_param.path = optarg;
+                break;
+            case 'd':
+                s_param.duration = Utils::Number<decltype(s_param.duration)>(optarg);
+                break;
+            case 'L':
+                s_param.latency = optarg;
+                break;
+            case 'i':
+                s_param.inject = Utils::Number<decltype(s_param.inject)>(optarg);
+                break;
+            case 'V':
+                s_param.views = Utils::Number<decltype(s_param.views)>(optarg);
+                break;
+            case 'O':
+                s_param.offscreen = Utils::Number<decltype(s_param.offscreen)>(optarg);
+                break;
+            case 'c':
+                s_param.capture = optarg;
+                break;
+            case 'C':
+                s_param.interval = Utils::Number<decltype(s_param.interval)>(optarg);
+                break;
+            case 'g':
+                s_param.golden = optarg;
+                break;
+            case 'u':
+                s_param.update = true;
+                break;
+            case 'b':
+                s_param.label = optarg;
+                break;
+            case 'T':
+                s_param.trace = optarg;
+                break;
+            case 'e':
+                s_param.profile = optarg;
+                break;
+            case 'E':
+                s_param.configCache = optarg;
+                break;
+            case 'I':
+                s_param.idle = Utils::Number<decltype(s_param.idle)>(optarg);
+                break;
             case '?':
                 if(optopt == 's')
                     fprintf (stderr, "Option -%c requires a scheduler name.\n", optopt);
                 else if(optopt == 'p')
                     fprintf (stderr, "Option -%c requires a priority.\n", optopt);
+                else if(optopt == 'r' || optopt == 'R')
+                    fprintf (stderr, "Option -%c requires a recording file.\n", optopt);
+                else if(optopt == 't')
+                    fprintf (stderr, "Option -%c requires a timestep in ms.\n", optopt);
+                else if(optopt == 'f')
+                    fprintf (stderr, "Option -%c requires a camera path file.\n", optopt);
+                else if(optopt == 'd')
+                    fprintf (stderr, "Option -%c requires a duration in s.\n", optopt);
+                else if(optopt == 'L')
+                    fprintf (stderr, "Option -%c requires a latency file.\n", optopt);
+                else if(optopt == 'i')
+                    fprintf (stderr, "Option -%c requires a period in ms.\n", optopt);
+                else if(optopt == 'V' || optopt == 'O')
+                    fprintf (stderr, "Option -%c requires a number of views.\n", optopt);
+                else if(optopt == 'c')
+                    fprintf (stderr, "Option -%c requires a capture directory.\n", optopt);
+                else if(optopt == 'C')
+                    fprintf (stderr, "Option -%c requires a number of frames.\n", optopt);
+                else if(optopt == 'g')
+                    fprintf (stderr, "Option -%c requires a golden directory.\n", optopt);
+                else if(optopt == 'b')
+                    fprintf (stderr, "Option -%c requires a build label.\n", optopt);
+                else if(optopt == 'T')
+                    fprintf (stderr, "Option -%c requires a trace file.\n", optopt);
+                else if(optopt == 'e')
+                    fprintf (stderr, "Option -%c requires a frame buffer profile.\n", optopt);
+                else if(optopt == 'E')
+                    fprintf (stderr, "Option -%c requires a config cache file.\n", optopt);
+                else if(optopt == 'I')
+                    fprintf (stderr, "Option -%c requires a sleep in ms.\n", optopt);
                 else if(isprint(optopt))
                     fprintf (stderr, "Unknown option `-%c'.\n", optopt);
                 else
@@ -152,6 +326,24 @@ void parse_args(int argc, char ** argv)
 }
 
 
+// fast    : RGB 565, nothing else (maximum fill rate, no depth test)
+// default : RGB 565 and a 16-bit depth buffer
+// quality : RGB 888, a 24-bit depth buffer and 4x multisampling
+WindowFlags profile_flags(std::string const & profile)
+{
+    if(profile == "fast")
+        return WINDOW_NONE;
+
+    if(profile == "quality")
+        return WINDOW_TRUE_COLOR | WINDOW_DEPTH | WINDOW_MULTISAMPLE;
+
+    if(profile != "default")
+        std::cerr << "Unknown frame buffer profile " << profile << ", using default" << std::endl;
+
+    return WINDOW_DEPTH;
+}
+
+
 void Draw(Context & context)
 {
    //UserData *userData = esContext->userData;
@@ -169,13 +361,10 @@ void Draw(Context & context)
     modelview  = glm::mat4(1.0);
 
 
-   GLuint m_vbo;
-
-    glGenBuffers(1, &m_vbo);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, 9 * sizeof(float), vVertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // Streamed every frame through the ring of the buffer manager instead
+    // of a new VBO per frame
+    auto const vertices = BufferManager::Default().stream(GL_ARRAY_BUFFER,
+        vVertices, sizeof(vVertices));
      
    // Set the viewport
    glViewport(0, 0, context.width, context.height);
@@ -187,11 +376,12 @@ void Draw(Context & context)
    context.program->bind();
         context.program->sendMatrix("MatProjection", projection);
         context.program->sendMatrix("MatModelView", modelview);
+        PositionQuantizer::SendIdentity(*context.program);
 
-   glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+   glBindBuffer(GL_ARRAY_BUFFER, vertices.buffer);
    // Load the vertex data
    glVertexAttribPointer(OpenGL::AttributeIndex[Enums::AttributeIndex_Position],
-        3, GL_FLOAT, GL_FALSE, 0, 0);
+        3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<void const *>(vertices.offset));
    glEnableVertexAttribArray(0);
 
    glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -0,0 +1,742 @@
+// -----------------------------------------------------------------------------
+//  GL trace replayer
+//
+//   glreplay [-n | -s] [-w width] [-h height] trace.bin
+//
+//   Reissues the calls of a trace recorded by a TRACE_GL=1 build (see
+//   GLTrace.hpp) and prints, for every entry point, its number of calls,
+//   the calls that did not change the GL state, and its cumulative time
+//   when recorded and when replayed.
+//
+//   -n : print the recorded costs only, without issuing any call
+//   -s : issue the calls without creating a context (glreplay-stub, linked
+//        with the no-op entry points of the benchmarks)
+// -----------------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+#include <Context.hpp>
+#include <EGLHeaders.hpp>
+#include <GLTrace.hpp>
+#include <Utils.hpp>
+#include <Window.hpp>
+
+using namespace RPi;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Call
+    {
+        GLEntry entry;
+        std::uint32_t duration;
+        std::uint32_t const * args;
+        std::size_t argc;
+        char const * payload;
+        std::size_t payloadSize;
+    };
+
+    struct EntryStats
+    {
+        std::size_t calls = 0;
+        std::size_t redundant = 0;
+        std::uint64_t recordedNs = 0;
+        std::uint64_t replayedNs = 0;
+    };
+
+    std::uint32_t read32(char const * data)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    // -------------------------------------------------------------------------
+    //  Parse a trace : the entries of the file are matched by name, calls of
+    //  unknown entries are skipped
+    // -------------------------------------------------------------------------
+    bool parse(std::vector<char> const & data, std::vector<Call> & calls, std::size_t & skipped)
+    {
+        if(data.size() < 12 || std::memcmp(data.data(), "RPGL", 4) != 0)
+        {
+            std::cerr << "Not a GL trace" << std::endl;
+            return false;
+        }
+
+        if(read32(&data[4]) != GLTrace::VERSION)
+        {
+            std::cerr << "Trace version " << read32(&data[4]) << ", expected "
+                      << GLTrace::VERSION << std::endl;
+            return false;
+        }
+
+        auto const count = read32(&data[8]);
+        std::size_t offset = 12;
+
+        std::map<std::string, GLEntry> entries;
+
+        for(std::uint16_t e = 0; e < static_cast<std::uint16_t>(GLEntry::Count); ++e)
+        {
+            entries[GLTrace::EntryName(static_cast<GLEntry>(e))] = static_cast<GLEntry>(e);
+        }
+
+        // Entry of the file -> entry of this build
+        std::vector<GLEntry> mapping;
+
+        for(std::uint32_t i = 0; i < count; ++i)
+        {
+            if(offset >= data.size()) return false;
+
+            auto const length = static_cast<std::uint8_t>(data[offset]);
+            std::string const name(&data[offset + 1], length);
+            auto const it = entries.find(name);
+
+            mapping.push_back(it != entries.end() ? it->second : GLEntry::Count);
+            offset += 1 + length;
+        }
+
+        offset = (offset + 3) / 4 * 4;
+
+        skipped = 0;
+
+        while(offset + 12 <= data.size())
+        {
+            std::uint16_t id;
+            std::memcpy(&id, &data[offset], sizeof(id));
+
+            Call call;
+            call.argc = static_cast<std::uint8_t>(data[offset + 2]);
+            call.payloadSize = read32(&data[offset + 4]);
+            call.duration = read32(&data[offset + 8]);
+            offset += 12;
+
+            if(offset + call.argc * 4 + call.payloadSize > data.size())
+            {
+                std::cerr << "Truncated trace" << std::endl;
+                break;
+            }
+
+            call.args = reinterpret_cast<std::uint32_t const *>(&data[offset]);
+            offset += call.argc * 4;
+            call.payload = &data[offset];
+            offset += (call.payloadSize + 3) / 4 * 4;
+
+            call.entry = id < mapping.size() ? mapping[id] : GLEntry::Count;
+
+            if(call.entry == GLEntry::Count)
+            {
+                ++skipped;
+                continue;
+            }
+
+            calls.push_back(call);
+        }
+
+        return true;
+    }
+
+    // -------------------------------------------------------------------------
+    //  Calls which leave the GL state as it was : the candidates of a state
+    //  cache or of a better draw order
+    // -------------------------------------------------------------------------
+    class RedundancyTracker
+    {
+        public:
+            RedundancyTracker():
+                m_rules(static_cast<std::size_t>(GLEntry::Count)), m_state()
+            {
+                // Binding of a target, set by the second argument
+                for(auto entry : { GLEntry::glBindBuffer, GLEntry::glBindFramebuffer,
+                    GLEntry::glBindRenderbuffer, GLEntry::glBindTexture, GLEntry::glPixelStorei })
+                {
+                    rule(entry, entry, KEY_FIRST_ARG, 1, 2);
+                }
+
+                rule(GLEntry::glUseProgram, GLEntry::glUseProgram, NO_KEY, 0, 1);
+
+                // Capabilities and attribute arrays, enabled (1) or not (0)
+                rule(GLEntry::glEnable, GLEntry::glEnable, KEY_FIRST_ARG, 1, 1, 1);
+                rule(GLEntry::glDisable, GLEntry::glEnable, KEY_FIRST_ARG, 1, 1, 0);
+                rule(GLEntry::glEnableVertexAttribArray, GLEntry::glEnableVertexAttribArray,
+                    KEY_FIRST_ARG, 1, 1, 1);
+                rule(GLEntry::glDisableVertexAttribArray, GLEntry::glEnableVertexAttribArray,
+                    KEY_FIRST_ARG, 1, 1, 0);
+
+                for(auto entry : { GLEntry::glViewport, GLEntry::glScissor, GLEntry::glClearColor })
+                {
+                    rule(entry, entry, NO_KEY, 0, 4);
+                }
+            }
+
+            bool redundant(Call const & call)
+            {
+                auto const & r = m_rules[static_cast<std::size_t>(call.entry)];
+
+                if(!r.tracked) return false;
+
+                auto const key = r.keyed ? call.args[0] : 0;
+
+                std::vector<std::uint32_t> state;
+
+                if(r.value >= 0)
+                {
+                    state.push_back(static_cast<std::uint32_t>(r.value));
+                }
+                else
+                {
+                    state.assign(call.args + r.first, call.args + r.count);
+                }
+
+                auto & current = m_state[(static_cast<std::uint64_t>(r.state) << 32) | key];
+                auto const same = current == state;
+
+                current = state;
+
+                return same;
+            }
+
+        private:
+            // State of an entry point : the calls of <entry> set the state
+            // <key> of <state> (the first argument or none) to args[first,
+            // count), or to <value> if given
+            struct Rule
+            {
+                bool tracked;
+                GLEntry state;
+                bool keyed;
+                std::size_t first;
+                std::size_t count;
+                std::int64_t value;
+            };
+
+            static bool const KEY_FIRST_ARG = true;
+            static bool const NO_KEY = false;
+
+            void rule(GLEntry entry, GLEntry state, bool keyed, std::size_t first,
+                std::size_t count, std::int64_t value = -1)
+            {
+                m_rules[static_cast<std::size_t>(entry)] = { true, state, keyed, first, count, value };
+            }
+
+            std::vector<Rule> m_rules;
+            std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> m_state;
+    };
+
+    // -------------------------------------------------------------------------
+    //  Issues the calls of a trace, with the names of the objects it creates
+    // -------------------------------------------------------------------------
+    class Replayer
+    {
+        public:
+            explicit Replayer(Window * window):
+                m_window(window), m_buffers(), m_framebuffers(), m_renderbuffers(),
+                m_textures(), m_programs(), m_shaders(), m_locations(), m_program(0),
+                m_pixels()
+            {
+
+            }
+
+            // The window is not owned
+            Replayer(Replayer const &) = delete;
+            Replayer & operator=(Replayer const &) = delete;
+
+            void issue(Call const & call)
+            {
+                auto const a = call.args;
+
+                switch(call.entry)
+                {
+                    case GLEntry::glAttachShader:
+                        glAttachShader(name(m_programs, a[0]), name(m_shaders, a[1]));
+                        break;
+                    case GLEntry::glBindAttribLocation:
+                    {
+                        std::string const attribute(call.payload, call.payloadSize);
+                        glBindAttribLocation(name(m_programs, a[0]), a[1], attribute.c_str());
+                        break;
+                    }
+                    case GLEntry::glBindBuffer:
+                        glBindBuffer(a[0], name(m_buffers, a[1]));
+                        break;
+                    case GLEntry::glBindFramebuffer:
+                        glBindFramebuffer(a[0], name(m_framebuffers, a[1]));
+                        break;
+                    case GLEntry::glBindRenderbuffer:
+                        glBindRenderbuffer(a[0], name(m_renderbuffers, a[1]));
+                        break;
+                    case GLEntry::glBindTexture:
+                        glBindTexture(a[0], name(m_textures, a[1]));
+                        break;
+                    case GLEntry::glBufferData:
+                        glBufferData(a[0], a[1], data(call), a[2]);
+                        break;
+                    case GLEntry::glBufferSubData:
+                        glBufferSubData(a[0], a[1], a[2], data(call));
+                        break;
+                    case GLEntry::glCheckFramebufferStatus:
+                        glCheckFramebufferStatus(a[0]);
+                        break;
+                    case GLEntry::glClear:
+                        glClear(a[0]);
+                        break;
+                    case GLEntry::glClearColor:
+                        glClearColor(real(a[0]), real(a[1]), real(a[2]), real(a[3]));
+                        break;
+                    case GLEntry::glCompileShader:
+                        glCompileShader(name(m_shaders, a[0]));
+                        break;
+                    case GLEntry::glCreateProgram:
+                        m_programs[a[0]] = glCreateProgram();
+                        break;
+                    case GLEntry::glCreateShader:
+                        m_shaders[a[1]] = glCreateShader(a[0]);
+                        break;
+                    case GLEntry::glDeleteBuffers:
+                        remove(m_buffers, call, glDeleteBuffers);
+                        break;
+                    case GLEntry::glDeleteFramebuffers:
+                        remove(m_framebuffers, call, glDeleteFramebuffers);
+                        break;
+                    case GLEntry::glDeleteProgram:
+                        glDeleteProgram(name(m_programs, a[0]));
+                        break;
+                    case GLEntry::glDeleteRenderbuffers:
+                        remove(m_renderbuffers, call, glDeleteRenderbuffers);
+                        break;
+                    case GLEntry::glDeleteShader:
+                        glDeleteShader(name(m_shaders, a[0]));
+                        break;
+                    case GLEntry::glDeleteTextures:
+                        remove(m_textures, call, glDeleteTextures);
+                        break;
+                    case GLEntry::glDisable:
+                        glDisable(a[0]);
+                        break;
+                    case GLEntry::glDisableVertexAttribArray:
+                        glDisableVertexAttribArray(a[0]);
+                        break;
+                    case GLEntry::glDrawArrays:
+                        glDrawArrays(a[0], static_cast<GLint>(a[1]), static_cast<GLsizei>(a[2]));
+                        break;
+                    case GLEntry::glDrawElements:
+                        glDrawElements(a[0], static_cast<GLsizei>(a[1]), a[2], pointer(a[3]));
+                        break;
+                    case GLEntry::glEnable:
+                        glEnable(a[0]);
+                        break;
+                    case GLEntry::glEnableVertexAttribArray:
+                        glEnableVertexAttribArray(a[0]);
+                        break;
+                    case GLEntry::glFinish:
+                        glFinish();
+                        break;
+                    case GLEntry::glFramebufferRenderbuffer:
+                        glFramebufferRenderbuffer(a[0], a[1], a[2], name(m_renderbuffers, a[3]));
+                        break;
+                    case GLEntry::glFramebufferTexture2D:
+                        glFramebufferTexture2D(a[0], a[1], a[2], name(m_textures, a[3]),
+                            static_cast<GLint>(a[4]));
+                        break;
+                    case GLEntry::glGenBuffers:
+                        generate(m_buffers, call, glGenBuffers);
+                        break;
+                    case GLEntry::glGenFramebuffers:
+                        generate(m_framebuffers, call, glGenFramebuffers);
+                        break;
+                    case GLEntry::glGenRenderbuffers:
+                        generate(m_renderbuffers, call, glGenRenderbuffers);
+                        break;
+                    case GLEntry::glGenTextures:
+                        generate(m_textures, call, glGenTextures);
+                        break;
+                    case GLEntry::glGetShaderInfoLog:
+                    {
+                        std::vector<GLchar> log(std::max<std::uint32_t>(a[1], 1));
+                        glGetShaderInfoLog(name(m_shaders, a[0]), static_cast<GLsizei>(log.size()),
+                            nullptr, log.data());
+                        break;
+                    }
+                    case GLEntry::glGetShaderiv:
+                    {
+                        GLint value = 0;
+                        glGetShaderiv(name(m_shaders, a[0]), a[1], &value);
+                        break;
+                    }
+                    case GLEntry::glGetUniformLocation:
+                    {
+                        std::string const uniform(call.payload, call.payloadSize);
+                        m_locations[location_key(a[0], a[1])] =
+                            glGetUniformLocation(name(m_programs, a[0]), uniform.c_str());
+                        break;
+                    }
+                    case GLEntry::glLinkProgram:
+                        glLinkProgram(name(m_programs, a[0]));
+                        break;
+                    case GLEntry::glPixelStorei:
+                        glPixelStorei(a[0], static_cast<GLint>(a[1]));
+                        break;
+                    case GLEntry::glReadPixels:
+                        // 4 bytes per pixel at most in OpenGL ES 2
+                        m_pixels.resize(static_cast<std::size_t>(a[2]) * a[3] * 4);
+                        glReadPixels(static_cast<GLint>(a[0]), static_cast<GLint>(a[1]),
+                            static_cast<GLsizei>(a[2]), static_cast<GLsizei>(a[3]), a[4], a[5],
+                            m_pixels.data());
+                        break;
+                    case GLEntry::glRenderbufferStorage:
+                        glRenderbufferStorage(a[0], a[1], static_cast<GLsizei>(a[2]),
+                            static_cast<GLsizei>(a[3]));
+                        break;
+                    case GLEntry::glScissor:
+                        glScissor(static_cast<GLint>(a[0]), static_cast<GLint>(a[1]),
+                            static_cast<GLsizei>(a[2]), static_cast<GLsizei>(a[3]));
+                        break;
+                    case GLEntry::glShaderSource:
+                        source(call);
+                        break;
+                    case GLEntry::glTexImage2D:
+                        glTexImage2D(a[0], static_cast<GLint>(a[1]), static_cast<GLint>(a[2]),
+                            static_cast<GLsizei>(a[3]), static_cast<GLsizei>(a[4]),
+                            static_cast<GLint>(a[5]), a[6], a[7], data(call));
+                        break;
+                    case GLEntry::glTexParameteri:
+                        glTexParameteri(a[0], a[1], static_cast<GLint>(a[2]));
+                        break;
+                    case GLEntry::glUniform1f:
+                        glUniform1f(location(a[0]), real(a[1]));
+                        break;
+                    case GLEntry::glUniform3fv:
+                        glUniform3fv(location(a[0]), static_cast<GLsizei>(a[1]),
+                            reinterpret_cast<GLfloat const *>(data(call)));
+                        break;
+                    case GLEntry::glUniform4fv:
+                        glUniform4fv(location(a[0]), static_cast<GLsizei>(a[1]),
+                            reinterpret_cast<GLfloat const *>(data(call)));
+                        break;
+                    case GLEntry::glUniformMatrix4fv:
+                        glUniformMatrix4fv(location(a[0]), static_cast<GLsizei>(a[1]),
+                            static_cast<GLboolean>(a[2]),
+                            reinterpret_cast<GLfloat const *>(data(call)));
+                        break;
+                    case GLEntry::glUseProgram:
+                        m_program = a[0];
+                        glUseProgram(name(m_programs, a[0]));
+                        break;
+                    case GLEntry::glVertexAttribPointer:
+                        glVertexAttribPointer(a[0], static_cast<GLint>(a[1]), a[2],
+                            static_cast<GLboolean>(a[3]), static_cast<GLsizei>(a[4]),
+                            pointer(a[5]));
+                        break;
+                    case GLEntry::glViewport:
+                        glViewport(static_cast<GLint>(a[0]), static_cast<GLint>(a[1]),
+                            static_cast<GLsizei>(a[2]), static_cast<GLsizei>(a[3]));
+                        break;
+                    case GLEntry::eglSwapBuffers:
+                        if(m_window != nullptr) m_window->display();
+                        break;
+                    case GLEntry::Count:
+                    default:
+                        break;
+                }
+            }
+
+        private:
+            using Names = std::unordered_map<GLuint, GLuint>;
+
+            static GLuint name(Names const & names, GLuint recorded)
+            {
+                auto const it = names.find(recorded);
+                return it != names.end() ? it->second : recorded;
+            }
+
+            static float real(std::uint32_t bits)
+            {
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+
+            static void const * pointer(std::uint32_t offset)
+            {
+                return reinterpret_cast<void const *>(static_cast<std::uintptr_t>(offset));
+            }
+
+            // The payload of a call, null if the call read no data. The calls
+            // of the trace are aligned on 4 bytes, like the uniform values.
+            static void const * data(Call const & call)
+            {
+                return call.payloadSize > 0 ? call.payload : nullptr;
+            }
+
+            static std::uint64_t location_key(GLuint program, std::uint32_t location)
+            {
+                return (static_cast<std::uint64_t>(program) << 32) | location;
+            }
+
+            GLint location(std::uint32_t recorded)
+            {
+                auto const it = m_locations.find(location_key(m_program, recorded));
+                return it != m_locations.end() ? it->second : static_cast<GLint>(recorded);
+            }
+
+            void generate(Names & names, Call const & call, void (*gen)(GLsizei, GLuint *))
+            {
+                auto const n = static_cast<GLsizei>(call.args[0]);
+
+                std::vector<GLuint> recorded(n);
+                std::vector<GLuint> generated(n);
+
+                std::memcpy(recorded.data(), call.payload, n * sizeof(GLuint));
+                gen(n, generated.data());
+
+                for(GLsizei i = 0; i < n; ++i) names[recorded[i]] = generated[i];
+            }
+
+            void remove(Names & names, Call const & call, void (*del)(GLsizei, GLuint const *))
+            {
+                auto const n = static_cast<GLsizei>(call.args[0]);
+
+                std::vector<GLuint> recorded(n);
+                std::vector<GLuint> current(n);
+
+                std::memcpy(recorded.data(), call.payload, n * sizeof(GLuint));
+
+                for(GLsizei i = 0; i < n; ++i)
+                {
+                    current[i] = name(names, recorded[i]);
+                    names.erase(recorded[i]);
+                }
+
+                del(n, current.data());
+            }
+
+            void source(Call const & call)
+            {
+                auto const count = static_cast<GLsizei>(call.args[1]);
+
+                std::vector<GLchar const *> strings;
+                std::vector<GLint> lengths;
+                std::size_t offset = 0;
+
+                for(GLsizei i = 0; i < count && offset + 4 <= call.payloadSize; ++i)
+                {
+                    auto const length = read32(call.payload + offset);
+
+                    strings.push_back(call.payload + offset + 4);
+                    lengths.push_back(static_cast<GLint>(length));
+                    offset += 4 + length;
+                }
+
+                glShaderSource(name(m_shaders, call.args[0]), static_cast<GLsizei>(strings.size()),
+                    strings.data(), lengths.data());
+            }
+
+            Window * m_window;
+
+            Names m_buffers;
+            Names m_framebuffers;
+            Names m_renderbuffers;
+            Names m_textures;
+            Names m_programs;
+            Names m_shaders;
+
+            // (program, recorded location) -> location
+            std::unordered_map<std::uint64_t, GLint> m_locations;
+            GLuint m_program;
+
+            std::vector<std::uint8_t> m_pixels;
+    };
+
+    double to_ms(std::uint64_t ns)
+    {
+        return static_cast<double>(ns) / 1e6;
+    }
+
+    // Milliseconds, "-" if the calls were not replayed
+    std::string milliseconds(std::uint64_t ns, bool replayed)
+    {
+        char text[32] = "-";
+
+        if(replayed) std::snprintf(text, sizeof(text), "%.3f", to_ms(ns));
+
+        return text;
+    }
+
+    void report(std::vector<EntryStats> const & stats, std::size_t frames, bool replayed)
+    {
+        std::vector<std::size_t> order;
+
+        for(std::size_t e = 0; e < stats.size(); ++e)
+        {
+            if(stats[e].calls > 0) order.push_back(e);
+        }
+
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+        {
+            return stats[a].recordedNs > stats[b].recordedNs;
+        });
+
+        EntryStats total;
+        char line[256];
+
+        std::snprintf(line, sizeof(line), "%-28s %9s %9s %12s %12s %10s\n", "entry point",
+            "calls", "redundant", "recorded ms", "replayed ms", "us/call");
+        std::cout << line;
+
+        for(auto e : order)
+        {
+            auto const & s = stats[e];
+            auto const ns = replayed ? s.replayedNs : s.recordedNs;
+
+            std::snprintf(line, sizeof(line), "%-28s %9zu %9zu %12.3f %12s %10.3f\n",
+                GLTrace::EntryName(static_cast<GLEntry>(e)), s.calls, s.redundant,
+                to_ms(s.recordedNs), milliseconds(s.replayedNs, replayed).c_str(),
+                static_cast<double>(ns) / 1e3 / static_cast<double>(s.calls));
+            std::cout << line;
+
+            total.calls += s.calls;
+            total.redundant += s.redundant;
+            total.recordedNs += s.recordedNs;
+            total.replayedNs += s.replayedNs;
+        }
+
+        std::snprintf(line, sizeof(line), "%-28s %9zu %9zu %12.3f %12s\n", "total",
+            total.calls, total.redundant, to_ms(total.recordedNs),
+            milliseconds(total.replayedNs, replayed).c_str());
+        std::cout << line;
+
+        if(frames > 0)
+        {
+            std::cout << frames << " frames : " << total.calls / frames << " calls, "
+                      << total.redundant / frames << " redundant, "
+                      << to_ms(total.recordedNs) / static_cast<double>(frames) << " ms recorded";
+
+            if(replayed)
+            {
+                std::cout << ", " << to_ms(total.replayedNs) / static_cast<double>(frames)
+                          << " ms replayed";
+            }
+
+            std::cout << " per frame" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    auto issue = true;
+    auto context = true;
+    int width = 640;
+    int height = 480;
+    int c;
+
+    while((c = getopt(argc, argv, "nsw:h:")) != -1)
+    {
+        switch(c)
+        {
+            case 'n':
+                issue = false;
+                break;
+            case 's':
+                context = false;
+                break;
+            case 'w':
+                width = Utils::Number<int>(optarg);
+                break;
+            case 'h':
+                height = Utils::Number<int>(optarg);
+                break;
+            default:
+                std::cerr << "Usage : " << argv[0]
+                          << " [-n | -s] [-w width] [-h height] trace.bin" << std::endl;
+                return 1;
+        }
+    }
+
+    if(optind >= argc)
+    {
+        std::cerr << "Usage : " << argv[0]
+                  << " [-n | -s] [-w width] [-h height] trace.bin" << std::endl;
+        return 1;
+    }
+
+    std::ifstream file(argv[optind], std::ios::binary);
+
+    if(!file)
+    {
+        std::cerr << "Failed to open " << argv[optind] << std::endl;
+        return 1;
+    }
+
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::vector<Call> calls;
+    std::size_t skipped = 0;
+
+    if(!parse(data, calls, skipped)) return 1;
+
+    if(skipped > 0)
+    {
+        std::cerr << skipped << " calls of entry points unknown to this build skipped"
+                  << std::endl;
+    }
+
+    std::vector<EntryStats> stats(static_cast<std::size_t>(GLEntry::Count));
+    std::size_t frames = 0;
+
+    RedundancyTracker redundancy;
+
+    for(auto const & call : calls)
+    {
+        auto & s = stats[static_cast<std::size_t>(call.entry)];
+
+        ++s.calls;
+        s.recordedNs += call.duration;
+
+        if(redundancy.redundant(call)) ++s.redundant;
+        if(call.entry == GLEntry::eglSwapBuffers) ++frames;
+    }
+
+    if(issue)
+    {
+        Context glContext;
+        std::unique_ptr<Window> window;
+
+        if(context)
+        {
+            window.reset(new Window(glContext, "GL replay", 0, 0, width, height));
+        }
+
+        Replayer replayer(window.get());
+
+        for(auto const & call : calls)
+        {
+            auto const start = Clock::now();
+
+            replayer.issue(call);
+
+            stats[static_cast<std::size_t>(call.entry)].replayedNs += static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+
+        // The last calls are queued : wait for them
+        glFinish();
+    }
+
+    std::cout << argv[optind] << " : " << calls.size() << " calls" << std::endl;
+    report(stats, frames, issue);
+
+    return 0;
+}